@@ -0,0 +1,543 @@
+/** ==================================================================================================================*\
+  @file BM_CanNm.c
+
+  @brief Microbenchmarks for Can Network Management Module
+
+  Measures the hot paths of the CanNm for the channel count the module is compiled with (CANNM_CHANNEL_COUNT).
+  Lower and upper layers are replaced by empty functions, so only CanNm itself is measured. Every benchmark prints
+  one JSON object per line with the time and TSC cycles per operation.
+
+  With --bus-load the first channels are instead connected as nodes of one simulated CAN bus, every NM PDU sent by a
+  node is received by all others, and the NM frame rate on the bus is reported for several node counts with and
+  without bus load reduction.
+
+  With --wake-up-storm all channels are requested in the same main function period with the same MsgCycleOffset and
+  active wakeup immediate transmissions, and the peak and mean CanIf_Transmit calls per main function period are
+  reported without staggering and with the channel index and hash staggering of WakeUpStaggerTime.
+
+  With --init CanNm_Init is measured with all channels set up at once and with lazy initialization, the latter also
+  followed by the first use of every channel. Needs CANNM_LAZY_INIT_ENABLED=STD_ON for the lazy variants.
+
+  Build: make bench (builds and runs 1, 16, 256 and 4096 channels)
+         make variants (post-build and pre-compile configuration variant, same features as BM_Config)
+         make busload (NM frame rate per node count, results in busload.json)
+         make wakeupstorm (CanIf_Transmit calls per main function period at 256 channels, results in wakeupstorm.json)
+         make inittime (CanNm_Init at 10000 channels, eager and lazy, results in inittime.json)
+  Usage: BM_CanNm.exe [minimum time per benchmark in ms]
+         BM_CanNm.exe --bus-load [simulated seconds per measurement]
+         BM_CanNm.exe --wake-up-storm [stagger window in main function periods]
+         BM_CanNm.exe --init [minimum time per benchmark in ms]
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+#include "CanNm.h"
+#include "SchM_CanNm.h"
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#define BM_SDU_LENGTH			8
+#define BM_REPETITIONS			5
+#define BM_MAIN_FUNCTION_PERIOD	10.0f
+#define BM_WAKE_SLEEP_TICKS		8		/* Enough main function calls to reach the next state with the timings below */
+#define BM_BUS_CYCLE_TICKS		50		/* MsgCycleTime of the bus load measurement */
+#define BM_BUS_WARM_UP_CYCLES	10		/* Message cycles until all nodes are in Normal Operation State */
+#define BM_BUS_SECONDS			60
+#define BM_STORM_WINDOW_TICKS	10		/* Default WakeUpStaggerTime of the wake-up storm measurement */
+#define BM_STORM_IMMEDIATE_TX	5		/* ImmediateNmTransmissions, one per main function period */
+#define BM_STORM_TICKS			100		/* Observed main function periods, one MsgCycleTime after the last slot */
+
+#if (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define BM_VARIANT "pre_compile"
+#else
+#define BM_VARIANT "post_build"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BM_CYCLES() __builtin_ia32_rdtsc()
+#define BM_CYCLES_SUPPORTED TRUE
+#else
+#define BM_CYCLES() 0ULL
+#define BM_CYCLES_SUPPORTED FALSE
+#endif
+
+/*====================================================================================================================*\
+    Local types
+\*====================================================================================================================*/
+typedef void (*BM_SetupType)(void);
+typedef void (*BM_OperationType)(uint32 iteration);
+
+typedef struct {
+	const char*			Name;
+	BM_SetupType		Setup;
+	BM_OperationType	Operation;
+} BM_BenchmarkType;
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+static PduInfoType BM_TxPduInfo[CANNM_CHANNEL_COUNT];
+static PduInfoType BM_RxPduInfo[CANNM_CHANNEL_COUNT];
+static CanNm_TxPdu BM_TxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_RxPdu BM_RxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_UserDataTxPdu BM_UserDataTxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_ChannelType BM_Channels[CANNM_CHANNEL_COUNT];
+
+static CanNm_ConfigType BM_Config = {
+	.MainFunctionPeriod = BM_MAIN_FUNCTION_PERIOD,
+	.PassiveModeEnabled = FALSE,
+	.StateChangeIndEnabled = TRUE,
+	.RemoteSleepIndEnabled = TRUE,
+	.UserDataEnabled = TRUE,
+	.ComUserDataSupport = FALSE
+};
+
+static uint8 BM_RxFrame[BM_SDU_LENGTH] = {0x20, 0x00, 0, 0, 0, 0, 0, 0};
+static PduInfoType BM_RxFrameInfo = {
+	.SduDataPtr = BM_RxFrame,
+	.SduLength = BM_SDU_LENGTH
+};
+
+static uint8 BM_UserData[BM_SDU_LENGTH] = {1, 2, 3, 4, 5, 6, 7, 8};
+static uint8 BM_TriggerSdu[BM_SDU_LENGTH];
+static PduInfoType BM_TriggerInfo = {
+	.SduDataPtr = BM_TriggerSdu,
+	.SduLength = BM_SDU_LENGTH
+};
+
+static volatile uint32 BM_CanIfTransmitCalls;
+
+static const uint32 BM_BusNodeCounts[] = { 2, 5, 10, 20, 40, 64 };
+static uint32 BM_BusNodes;
+static uint32 BM_BusFrames;
+static uint32 BM_BusPendingCount;
+static NetworkHandleType BM_BusPendingSender[2 * CANNM_CHANNEL_COUNT];
+static uint8 BM_BusPendingSdu[2 * CANNM_CHANNEL_COUNT][BM_SDU_LENGTH];
+
+/*====================================================================================================================*\
+    Global functions code (CanNm lower and upper layer)
+\*====================================================================================================================*/
+Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
+{
+	(void)TxPduId;
+	(void)PduInfoPtr;
+	BM_CanIfTransmitCalls++;
+	return E_OK;
+}
+
+void Nm_StateChangeNotification(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState, Nm_StateType nmCurrentState)
+{
+	(void)nmNetworkHandle;
+	(void)nmPreviousState;
+	(void)nmCurrentState;
+}
+
+void Nm_NetworkStartIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_NetworkMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_BusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PrepareBusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepInd(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepCancellation(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PduRxIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_TxTimeoutException(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void CanSM_TxTimeoutException(NetworkHandleType Channel) { (void)Channel; }
+void Nm_RepeatMessageIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void PduR_CanNmRxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr) { (void)RxPduId; (void)PduInfoPtr; }
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+static Std_ReturnType BM_BusTransmit( PduIdType TxPduId, const PduInfoType* PduInfoPtr );
+
+static const CanNm_CallbacksType BM_BusCallbacks = {
+	.CanIfTransmit = BM_BusTransmit
+};
+
+static uint64 BM_GetTimeNs( void )
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+
+static void BM_ConfigInit( void )
+{
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_ChannelType* ChannelConf = &BM_Channels[channel];
+
+		BM_TxPduInfo[channel].SduLength = BM_SDU_LENGTH;
+		BM_RxPduInfo[channel].SduLength = BM_SDU_LENGTH;
+		BM_TxPdu[channel].TxConfirmationPduId = (PduIdType)channel;
+		BM_TxPdu[channel].TxPduRef = &BM_TxPduInfo[channel];
+		BM_RxPdu[channel].RxPduId = (PduIdType)channel;
+		BM_RxPdu[channel].RxPduRef = &BM_RxPduInfo[channel];
+		BM_UserDataTxPdu[channel].TxUserDataPduId = (PduIdType)channel;
+		BM_UserDataTxPdu[channel].TxUserDataPduRef = &BM_TxPduInfo[channel];
+
+		memset(ChannelConf, 0, sizeof(*ChannelConf));
+		ChannelConf->TimeoutTime = 2 * BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->MsgCycleOffset = (float32)(channel % 10) * BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->MsgCycleTime = 10 * BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->RepeatMessageTime = BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->WaitBusSleepTime = 2 * BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->RemoteSleepIndTime = 50 * BM_MAIN_FUNCTION_PERIOD;
+		ChannelConf->PduCbvPosition = CANNM_PDU_BYTE_1;
+		ChannelConf->PduNidPosition = CANNM_PDU_BYTE_0;
+		ChannelConf->NodeId = (uint8)channel;
+		ChannelConf->NodeIdEnabled = TRUE;
+		ChannelConf->NodeDetectionEnabled = TRUE;
+		for (uint32 slot = 0; slot < CANNM_RXPDU_MAX_COUNT; slot++) {
+			ChannelConf->RxPdu[slot] = &BM_RxPdu[channel];
+		}
+		ChannelConf->TxPdu = &BM_TxPdu[channel];
+		ChannelConf->UserDataTxPdu = &BM_UserDataTxPdu[channel];
+		BM_Config.ChannelConfig[channel] = ChannelConf;
+	}
+}
+
+static void BM_RunMainFunctions( uint32 count )
+{
+	for (uint32 tick = 0; tick < count; tick++) {
+		CanNm_MainFunction();
+	}
+}
+
+/**************/
+/* Benchmarks */
+/**************/
+static void BM_SetupBusSleep( void )
+{
+	CanNm_Init(&BM_Config);
+}
+
+static void BM_SetupNetwork( void )
+{
+	CanNm_Init(&BM_Config);
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_NetworkRequest((NetworkHandleType)channel);
+	}
+}
+
+static void BM_MainFunction( uint32 iteration )
+{
+	(void)iteration;
+	CanNm_MainFunction();
+}
+
+static void BM_RxIndication( uint32 iteration )
+{
+	CanNm_RxIndication((PduIdType)(iteration % CANNM_CHANNEL_COUNT), &BM_RxFrameInfo);
+}
+
+static void BM_SetUserData( uint32 iteration )
+{
+	CanNm_SetUserData((NetworkHandleType)(iteration % CANNM_CHANNEL_COUNT), BM_UserData);
+}
+
+static void BM_TriggerTransmit( uint32 iteration )
+{
+	BM_TriggerInfo.SduLength = BM_SDU_LENGTH;
+	CanNm_TriggerTransmit((PduIdType)(iteration % CANNM_CHANNEL_COUNT), &BM_TriggerInfo);
+}
+
+static void BM_WakeSleepCycle( uint32 iteration )
+{
+	(void)iteration;
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_NetworkRequest((NetworkHandleType)channel);
+	}
+	BM_RunMainFunctions(BM_WAKE_SLEEP_TICKS);
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_NetworkRelease((NetworkHandleType)channel);
+	}
+	BM_RunMainFunctions(BM_WAKE_SLEEP_TICKS);
+}
+
+/************************/
+/* Start-up measurement */
+/************************/
+static void BM_SetupInit( void )
+{
+	BM_Config.LazyInitEnabled = FALSE;
+}
+
+static void BM_SetupLazyInit( void )
+{
+	BM_Config.LazyInitEnabled = TRUE;
+}
+
+static void BM_Init( uint32 iteration )
+{
+	(void)iteration;
+	CanNm_Init(&BM_Config);
+}
+
+/* Lazy initialization cost in total, when every channel is used after start-up */
+static void BM_InitAllUsed( uint32 iteration )
+{
+	Nm_StateType state;
+	Nm_ModeType mode;
+
+	(void)iteration;
+	CanNm_Init(&BM_Config);
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_GetState((NetworkHandleType)channel, &state, &mode);
+	}
+}
+
+/************************/
+/* Bus load measurement */
+/************************/
+static Std_ReturnType BM_BusTransmit( PduIdType TxPduId, const PduInfoType* PduInfoPtr )
+{
+	BM_BusFrames++;
+	if (BM_BusPendingCount < (sizeof(BM_BusPendingSender) / sizeof(BM_BusPendingSender[0]))) {
+		BM_BusPendingSender[BM_BusPendingCount] = (NetworkHandleType)TxPduId;
+		memcpy(BM_BusPendingSdu[BM_BusPendingCount], PduInfoPtr->SduDataPtr, BM_SDU_LENGTH);
+		BM_BusPendingCount++;
+	}
+	return E_OK;
+}
+
+/* Frames sent during a main function period reach all other nodes before the next one */
+static void BM_BusTick( void )
+{
+	CanNm_MainFunction();
+	for (uint32 frame = 0; frame < BM_BusPendingCount; frame++) {
+		PduInfoType frameInfo = { .SduDataPtr = BM_BusPendingSdu[frame], .SduLength = BM_SDU_LENGTH };
+
+		for (uint32 node = 0; node < BM_BusNodes; node++) {
+			if (node != BM_BusPendingSender[frame]) {
+				CanNm_RxIndication((PduIdType)node, &frameInfo);
+			}
+		}
+	}
+	BM_BusPendingCount = 0;
+}
+
+static void BM_BusLoad( uint32 nodes, boolean busLoadReduction, uint32 seconds )
+{
+	uint32 ticks = (uint32)((float32)seconds * 1000.0f / BM_MAIN_FUNCTION_PERIOD);
+
+	BM_ConfigInit();
+	for (uint32 node = 0; node < nodes; node++) {
+		BM_Channels[node].MsgCycleTime = BM_BUS_CYCLE_TICKS * BM_MAIN_FUNCTION_PERIOD;
+		BM_Channels[node].TimeoutTime = 2 * BM_Channels[node].MsgCycleTime;
+		BM_Channels[node].BusLoadReductionActive = busLoadReduction;
+		BM_Channels[node].MsgReducedTime = 0;									/* Derived from the node identifier */
+	}
+	BM_Config.BusLoadReductionEnabled = busLoadReduction;
+	BM_Config.Callbacks = &BM_BusCallbacks;
+	BM_BusNodes = nodes;
+	BM_BusPendingCount = 0;
+
+	CanNm_Init(&BM_Config);
+	for (uint32 node = 0; node < nodes; node++) {
+		CanNm_NetworkRequest((NetworkHandleType)node);
+	}
+	for (uint32 tick = 0; tick < (BM_BUS_WARM_UP_CYCLES * BM_BUS_CYCLE_TICKS); tick++) {
+		BM_BusTick();
+	}
+	BM_BusFrames = 0;
+	for (uint32 tick = 0; tick < ticks; tick++) {
+		BM_BusTick();
+	}
+
+	printf("{\"benchmark\":\"bus_load\",\"variant\":\"%s\",\"nodes\":%u,\"bus_load_reduction\":%s,\"msg_cycle_ms\":%.0f,"
+	 "\"frames_per_s\":%.2f,\"frames_per_s_per_node\":%.3f}\n", BM_VARIANT, (unsigned)nodes,
+	 busLoadReduction ? "true" : "false", BM_BUS_CYCLE_TICKS * BM_MAIN_FUNCTION_PERIOD,
+	 (float64)BM_BusFrames / seconds, (float64)BM_BusFrames / seconds / nodes);
+	fflush(stdout);
+
+	BM_Config.Callbacks = NULL;
+	BM_Config.BusLoadReductionEnabled = FALSE;
+}
+
+/*****************************/
+/* Wake-up storm measurement */
+/*****************************/
+/* The network requests count as the first main function period, their immediate transmissions go out right away */
+static void BM_WakeUpStorm( uint32 windowTicks, CanNm_WakeUpStaggerType stagger )
+{
+	uint32 peak;
+	uint32 total;
+
+	BM_ConfigInit();
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		BM_Channels[channel].MsgCycleOffset = 0;
+		BM_Channels[channel].ActiveWakeupBitEnabled = TRUE;
+		BM_Channels[channel].ImmediateNmTransmissions = BM_STORM_IMMEDIATE_TX;
+		BM_Channels[channel].ImmediateNmCycleTime = BM_MAIN_FUNCTION_PERIOD;
+		BM_Channels[channel].RepeatMessageTime = BM_STORM_TICKS * BM_MAIN_FUNCTION_PERIOD;
+		BM_Channels[channel].TimeoutTime = 2 * BM_STORM_TICKS * BM_MAIN_FUNCTION_PERIOD;
+	}
+	BM_Config.WakeUpStaggerTime = (float32)windowTicks * BM_MAIN_FUNCTION_PERIOD;
+	BM_Config.WakeUpStagger = stagger;
+
+	CanNm_Init(&BM_Config);
+	BM_CanIfTransmitCalls = 0;
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_NetworkRequest((NetworkHandleType)channel);
+	}
+	peak = BM_CanIfTransmitCalls;
+	total = BM_CanIfTransmitCalls;
+	for (uint32 tick = 1; tick < BM_STORM_TICKS; tick++) {
+		BM_CanIfTransmitCalls = 0;
+		CanNm_MainFunction();
+		peak = (BM_CanIfTransmitCalls > peak) ? BM_CanIfTransmitCalls : peak;
+		total += BM_CanIfTransmitCalls;
+	}
+
+	printf("{\"benchmark\":\"wake_up_storm\",\"variant\":\"%s\",\"channels\":%u,\"stagger\":\"%s\",\"window_ticks\":%u,"
+	 "\"ticks\":%u,\"transmits\":%u,\"peak_transmits_per_tick\":%u,\"mean_transmits_per_tick\":%.2f}\n", BM_VARIANT,
+	 (unsigned)CANNM_CHANNEL_COUNT, (windowTicks == 0) ? "off" : (stagger == CANNM_WAKEUP_STAGGER_HASH) ? "hash" : "channel_index",
+	 (unsigned)windowTicks, (unsigned)BM_STORM_TICKS, (unsigned)total, (unsigned)peak, (float64)total / BM_STORM_TICKS);
+	fflush(stdout);
+
+	BM_Config.WakeUpStaggerTime = 0;
+	BM_Config.WakeUpStagger = CANNM_WAKEUP_STAGGER_CHANNEL_INDEX;
+}
+
+static const BM_BenchmarkType BM_Benchmarks[] = {
+	{ "main_function_idle", BM_SetupBusSleep, BM_MainFunction },		/* All channels in bus-sleep, timers stopped */
+	{ "main_function_active", BM_SetupNetwork, BM_MainFunction },		/* All channels in network mode, timers running */
+	{ "rx_indication", BM_SetupNetwork, BM_RxIndication },
+	{ "set_user_data", BM_SetupNetwork, BM_SetUserData },
+	{ "trigger_transmit", BM_SetupNetwork, BM_TriggerTransmit },
+	{ "wake_sleep_cycle", BM_SetupBusSleep, BM_WakeSleepCycle }		/* Request, run, release and sleep all channels */
+};
+
+static const BM_BenchmarkType BM_InitBenchmarks[] = {
+	{ "init", BM_SetupInit, BM_Init },
+	{ "init_lazy", BM_SetupLazyInit, BM_Init },
+	{ "init_lazy_all_used", BM_SetupLazyInit, BM_InitAllUsed }
+};
+
+static void BM_Measure( uint32 iterations, const BM_BenchmarkType* benchmark, uint64* timeNs, uint64* cycles )
+{
+	uint64 startNs = BM_GetTimeNs();
+	uint64 startCycles = BM_CYCLES();
+
+	for (uint32 iteration = 0; iteration < iterations; iteration++) {
+		benchmark->Operation(iteration);
+	}
+	*cycles = BM_CYCLES() - startCycles;
+	*timeNs = BM_GetTimeNs() - startNs;
+}
+
+static void BM_Run( const BM_BenchmarkType* benchmark, uint64 minimumTimeNs )
+{
+	float64 nsPerOp[BM_REPETITIONS];
+	float64 cyclesPerOp[BM_REPETITIONS];
+	uint32 iterations = 1;
+	uint64 timeNs;
+	uint64 cycles;
+	uint32 median = 0;
+
+	/* Calibrate the iteration count on the minimum time, which also warms up caches and branch predictors */
+	benchmark->Setup();
+	BM_Measure(iterations, benchmark, &timeNs, &cycles);
+	while (timeNs < minimumTimeNs && iterations < 0x40000000UL) {
+		iterations *= 2;
+		benchmark->Setup();
+		BM_Measure(iterations, benchmark, &timeNs, &cycles);
+	}
+
+	for (uint32 repetition = 0; repetition < BM_REPETITIONS; repetition++) {
+		benchmark->Setup();
+		BM_Measure(iterations, benchmark, &timeNs, &cycles);
+		nsPerOp[repetition] = (float64)timeNs / iterations;
+		cyclesPerOp[repetition] = (float64)cycles / iterations;
+	}
+	for (uint32 repetition = 1; repetition < BM_REPETITIONS; repetition++) {
+		float64 ns = nsPerOp[repetition];
+		float64 cyc = cyclesPerOp[repetition];
+		uint32 position = repetition;
+		while (position > 0 && nsPerOp[position - 1] > ns) {
+			nsPerOp[position] = nsPerOp[position - 1];
+			cyclesPerOp[position] = cyclesPerOp[position - 1];
+			position--;
+		}
+		nsPerOp[position] = ns;
+		cyclesPerOp[position] = cyc;
+	}
+	median = BM_REPETITIONS / 2;
+
+	printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"channels\":%u,\"iterations\":%u,\"ns_per_op\":%.2f,\"ns_per_op_min\":%.2f,",
+	 benchmark->Name, BM_VARIANT, (unsigned)CANNM_CHANNEL_COUNT, (unsigned)iterations, nsPerOp[median], nsPerOp[0]);
+	if (BM_CYCLES_SUPPORTED) {
+		printf("\"cycles_per_op\":%.1f}\n", cyclesPerOp[median]);
+	} else {
+		printf("\"cycles_per_op\":null}\n");
+	}
+	fflush(stdout);
+}
+
+/*====================================================================================================================*\
+    Main
+\*====================================================================================================================*/
+int main(int argc, char** argv)
+{
+	uint64 minimumTimeNs = 100ULL * 1000000ULL;
+	Nm_StateType state;
+	Nm_ModeType mode;
+
+	if (argc > 1 && strcmp(argv[1], "--bus-load") == 0) {
+		uint32 seconds = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : BM_BUS_SECONDS;
+
+		for (uint32 count = 0; count < (sizeof(BM_BusNodeCounts) / sizeof(BM_BusNodeCounts[0])); count++) {
+			if (BM_BusNodeCounts[count] <= CANNM_CHANNEL_COUNT) {
+				BM_BusLoad(BM_BusNodeCounts[count], FALSE, seconds);
+				BM_BusLoad(BM_BusNodeCounts[count], TRUE, seconds);
+			}
+		}
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--wake-up-storm") == 0) {
+		uint32 windowTicks = (argc > 2) ? (uint32)strtoul(argv[2], NULL, 0) : BM_STORM_WINDOW_TICKS;
+
+		BM_WakeUpStorm(0, CANNM_WAKEUP_STAGGER_CHANNEL_INDEX);
+		BM_WakeUpStorm(windowTicks, CANNM_WAKEUP_STAGGER_CHANNEL_INDEX);
+		BM_WakeUpStorm(windowTicks, CANNM_WAKEUP_STAGGER_HASH);
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--init") == 0) {
+		if (argc > 2) {
+			minimumTimeNs = strtoull(argv[2], NULL, 0) * 1000000ULL;
+		}
+		BM_ConfigInit();
+		for (uint32 benchmark = 0; benchmark < (sizeof(BM_InitBenchmarks) / sizeof(BM_InitBenchmarks[0])); benchmark++) {
+			BM_Run(&BM_InitBenchmarks[benchmark], minimumTimeNs);
+		}
+		return 0;
+	}
+	if (argc > 1) {
+		minimumTimeNs = strtoull(argv[1], NULL, 0) * 1000000ULL;
+	}
+	BM_ConfigInit();
+
+	/* The wake/sleep benchmark relies on one cycle ending in bus-sleep */
+	BM_SetupBusSleep();
+	BM_WakeSleepCycle(0);
+	CanNm_GetState(0, &state, &mode);
+	if (mode != NM_MODE_BUS_SLEEP) {
+		fprintf(stderr, "wake/sleep cycle did not reach bus-sleep\n");
+		return 1;
+	}
+
+	for (uint32 benchmark = 0; benchmark < (sizeof(BM_Benchmarks) / sizeof(BM_Benchmarks[0])); benchmark++) {
+		BM_Run(&BM_Benchmarks[benchmark], minimumTimeNs);
+	}
+	return 0;
+}
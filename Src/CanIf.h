@@ -0,0 +1,15 @@
+#ifndef CANIF_H
+#define CANIF_H
+
+/**===================================================================================================================*\
+  @file CanIf.h
+
+  @brief CAN Interface services used by CanNm [SWS_CanNm_00312]
+\*====================================================================================================================*/
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+
+Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr);
+
+#endif /* CANIF_H */
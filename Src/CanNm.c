@@ -42,7 +42,9 @@ SOFTWARE.
 #include "ComStack_Types.h"
 
 /* [SWS_CanNm_00307] */
-//#include "Nm_Cbk.h"
+#ifndef UNIT_TEST
+#include "Nm_Cbk.h"
+#endif
 
 /* [SWS_CanNm_00308] */
 #include "Det.h"
@@ -53,18 +55,25 @@ SOFTWARE.
 /* [SWS_CanNm_00312] */
 #ifndef UNIT_TEST
 #include "CanIf.h"
+#include "CanSM_TxTimeoutException.h"
 #endif
 
 /* [SWS_CanNm_00326] */
-//#include "PduR_CanNm.h"
+#ifndef UNIT_TEST
+#include "PduR_CanNm.h"
+#endif
 
 #include "CanNm.h"
 //#include "CanNm_Cbk.h"
 //#include "CanNm_MemMap.h"
-//#include "SchM_CanNm.h"
+#include "SchM_CanNm.h"
 
 #include "fff.h"
 
+#if (CANNM_LATENCY_ENABLED == STD_ON) && (CANNM_LATENCY_CLOCK == CANNM_LATENCY_CLOCK_MONOTONIC) && !defined(CANNM_LATENCY_GET_TIME_NS)
+#include <time.h>
+#endif
+
 /*====================================================================================================================*\
     Local macros
 \*====================================================================================================================*/
@@ -76,22 +85,226 @@ SOFTWARE.
 
 #define NO_PDU_RECEIVED -1
 
+/* Status of CanNm_Internal_TransmitMessage when the controller token bucket is empty, the caller decides on the retry */
+#define CANNM_E_TX_DEFERRED ((Std_ReturnType)0x02U)
+/* Status of CanNm_Internal_TransmitMessage when the NM PDU is left to CanNm_Internal_FlushCallouts */
+#define CANNM_E_TX_QUEUED ((Std_ReturnType)0x03U)
+#define CANNM_TX_TOKEN		(1UL << 16)			//One NM PDU in the fixed point token count
+
+/* Channel flags of a CanNm_SaveState blob */
+#define CANNM_STATE_REQUESTED					(1U << 0)
+#define CANNM_STATE_TX_ENABLED					(1U << 1)
+#define CANNM_STATE_BUS_LOAD_REDUCTION			(1U << 2)
+#define CANNM_STATE_REMOTE_SLEEP_IND			(1U << 3)
+#define CANNM_STATE_REMOTE_SLEEP_IND_ENABLED	(1U << 4)
+#define CANNM_STATE_PDU_FILTER_ALGORITHM		(1U << 5)
+#define CANNM_STATE_TX_PENDING					(1U << 6)
+
+/* State machine actions, executed in bit order by CanNm_Internal_Transition */
+#define CANNM_ACTION_TX_ENABLE					(1UL << 0)		//Unless passive mode [SWS_CanNm_00072]
+#define CANNM_ACTION_TX_DISABLE					(1UL << 1)		//[SWS_CanNm_00108]
+#define CANNM_ACTION_BUS_LOAD_REDUCTION_OFF		(1UL << 2)		//[SWS_CanNm_00156]
+#define CANNM_ACTION_BUS_LOAD_REDUCTION_ON		(1UL << 3)		//If configured for the channel [SWS_CanNm_00157]
+#define CANNM_ACTION_CLEAR_CBV					(1UL << 4)		//If node detection is enabled [SWS_CanNm_00107]
+#define CANNM_ACTION_SET_REPEAT_MESSAGE_BIT		(1UL << 5)		//[SWS_CanNm_00113][SWS_CanNm_00121]
+#define CANNM_ACTION_CLEAR_ACTIVE_WAKEUP_BIT	(1UL << 6)		//If the active wakeup bit is enabled [SWS_CanNm_00402]
+#define CANNM_ACTION_TX_TIMEOUT_EXCEPTION		(1UL << 7)
+#define CANNM_ACTION_START_TIMEOUT				(1UL << 8)
+#define CANNM_ACTION_START_REPEAT_MESSAGE		(1UL << 9)		//[SWS_CanNm_00102]
+#define CANNM_ACTION_START_MESSAGE_CYCLE		(1UL << 10)		//With MsgCycleOffset [SWS_CanNm_00100]
+#define CANNM_ACTION_START_WAIT_BUS_SLEEP		(1UL << 11)		//[SWS_CanNm_00115]
+#define CANNM_ACTION_START_REMOTE_SLEEP_IND		(1UL << 12)		//If remote sleep indication is enabled [SWS_CanNm_00149]
+#define CANNM_ACTION_CANCEL_REMOTE_SLEEP_IND	(1UL << 13)		//If remote sleep was indicated [SWS_CanNm_00151]
+#define CANNM_ACTION_NETWORK_START_IND			(1UL << 14)		//[SWS_CanNm_00127]
+#define CANNM_ACTION_NETWORK_MODE				(1UL << 15)		//[SWS_CanNm_00097]
+#define CANNM_ACTION_PREPARE_BUS_SLEEP_MODE		(1UL << 16)		//[SWS_CanNm_00114]
+#define CANNM_ACTION_BUS_SLEEP_MODE				(1UL << 17)		//[SWS_CanNm_00126]
+#define CANNM_ACTION_STATE_CHANGE_NOTIFICATION	(1UL << 18)		//If state change indication is enabled
+#define CANNM_ACTION_RX_REMOTE_SLEEP_IND		(1UL << 19)		//Cancel an indicated remote sleep, else restart its timer
+#define CANNM_ACTION_ACTIVE_WAKEUP				(1UL << 20)		//Active wakeup bit and immediate transmissions [SWS_CanNm_00401]
+#define CANNM_ACTION_IMMEDIATE_TX				(1UL << 21)		//[SWS_CanNm_00334][SWS_CanNm_00454]
+
+/* Entering Repeat Message State from Bus-Sleep or Prepare Bus-Sleep Mode [SWS_CanNm_00096] */
+#define CANNM_ACTIONS_NETWORK_START		(CANNM_ACTION_BUS_LOAD_REDUCTION_OFF | CANNM_ACTION_START_TIMEOUT | \
+ CANNM_ACTION_START_REPEAT_MESSAGE | CANNM_ACTION_START_MESSAGE_CYCLE | CANNM_ACTION_NETWORK_MODE | \
+ CANNM_ACTION_STATE_CHANGE_NOTIFICATION)
+/* Entering Repeat Message State from Ready Sleep or Normal Operation State */
+#define CANNM_ACTIONS_REPEAT_MESSAGE	(CANNM_ACTION_BUS_LOAD_REDUCTION_OFF | CANNM_ACTION_START_REPEAT_MESSAGE | \
+ CANNM_ACTION_START_MESSAGE_CYCLE | CANNM_ACTION_CANCEL_REMOTE_SLEEP_IND | CANNM_ACTION_STATE_CHANGE_NOTIFICATION)
+
+/* Interface calls through the callback table of the configuration, NULL entries are skipped */
+#define CANNM_CALLBACK(Callback, ...) \
+	do { if (CanNm_Callbacks->Callback != NULL) { CanNm_Callbacks->Callback(__VA_ARGS__); } } while (0)
+#define CANNM_CAN_IF_TRANSMIT(TxPduId, PduInfoPtr) \
+	((CanNm_Callbacks->CanIfTransmit != NULL) ? CanNm_Callbacks->CanIfTransmit((TxPduId), (PduInfoPtr)) : E_OK)
+
+/* Feature flags: constant FALSE when switched off, constant TRUE in the pre-compile variant, else read from the
+   configuration, so fixed configurations get straight-line code */
+/* Bus load reduction stays a per channel choice in both variants */
+#if (CANNM_BUS_LOAD_REDUCTION_ENABLED == STD_OFF)
+#define CANNM_BUS_LOAD_REDUCTION(ChannelConf)	FALSE
+#else
+#define CANNM_BUS_LOAD_REDUCTION(ChannelConf)	((ChannelConf)->BusLoadReductionActive)
+#endif
+
+#if (CANNM_COM_USER_DATA_SUPPORT == STD_OFF)
+#define CANNM_COM_USER_DATA()					FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_COM_USER_DATA()					TRUE
+#else
+#define CANNM_COM_USER_DATA()					(CanNm_ConfigPtr->ComUserDataSupport)
+#endif
+
+#if (CANNM_COORDINATOR_SYNC_SUPPORT == STD_OFF)
+#define CANNM_COORDINATOR_SYNC()				FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_COORDINATOR_SYNC()				TRUE
+#else
+#define CANNM_COORDINATOR_SYNC()				(CanNm_ConfigPtr->CoordinationSyncSupport)
+#endif
+
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_OFF)
+#define CANNM_DEFERRED_NOTIFICATIONS()			FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_DEFERRED_NOTIFICATIONS()			TRUE
+#else
+#define CANNM_DEFERRED_NOTIFICATIONS()			(CanNm_ConfigPtr->DeferredNotificationsEnabled)
+#endif
+
+#if (CANNM_LAZY_INIT_ENABLED == STD_OFF)
+#define CANNM_LAZY_INIT()						FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_LAZY_INIT()						TRUE
+#else
+#define CANNM_LAZY_INIT()						(CanNm_ConfigPtr->LazyInitEnabled)
+#endif
+
+#if (CANNM_GLOBAL_PN_SUPPORT == STD_OFF)
+#define CANNM_GLOBAL_PN()						FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_GLOBAL_PN()						TRUE
+#else
+#define CANNM_GLOBAL_PN()						(CanNm_ConfigPtr->GlobalPnSupport)
+#endif
+
+#if (CANNM_IMMEDIATE_RESTART_ENABLED == STD_OFF)
+#define CANNM_IMMEDIATE_RESTART()				FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_IMMEDIATE_RESTART()				TRUE
+#else
+#define CANNM_IMMEDIATE_RESTART()				(CanNm_ConfigPtr->ImmediateRestartEnabled)
+#endif
+
+#if (CANNM_PASSIVE_MODE_ENABLED == STD_OFF)
+#define CANNM_PASSIVE_MODE()					FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_PASSIVE_MODE()					TRUE
+#else
+#define CANNM_PASSIVE_MODE()					(CanNm_ConfigPtr->PassiveModeEnabled)
+#endif
+
+#if (CANNM_PDU_RX_INDICATION_ENABLED == STD_OFF)
+#define CANNM_PDU_RX_INDICATION()				FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_PDU_RX_INDICATION()				TRUE
+#else
+#define CANNM_PDU_RX_INDICATION()				(CanNm_ConfigPtr->PduRxIndicationEnabled)
+#endif
+
+#if (CANNM_REMOTE_SLEEP_IND_ENABLED == STD_OFF)
+#define CANNM_REMOTE_SLEEP_IND()				FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_REMOTE_SLEEP_IND()				TRUE
+#else
+#define CANNM_REMOTE_SLEEP_IND()				(CanNm_ConfigPtr->RemoteSleepIndEnabled)
+#endif
+
+#if (CANNM_STATE_CHANGE_IND_ENABLED == STD_OFF)
+#define CANNM_STATE_CHANGE_IND()				FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_STATE_CHANGE_IND()				TRUE
+#else
+#define CANNM_STATE_CHANGE_IND()				(CanNm_ConfigPtr->StateChangeIndEnabled)
+#endif
+
+#if (CANNM_USER_DATA_ENABLED == STD_OFF)
+#define CANNM_USER_DATA()						FALSE
+#elif (CANNM_CONFIG_VARIANT == CANNM_VARIANT_PRE_COMPILE)
+#define CANNM_USER_DATA()						TRUE
+#else
+#define CANNM_USER_DATA()						(CanNm_ConfigPtr->UserDataEnabled)
+#endif
+
+/* Channels served from different cores get a cache line each, packed back to back otherwise */
+#ifndef CANNM_CACHE_LINE_SIZE
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_SPINLOCK)
+#define CANNM_CACHE_LINE_SIZE					64
+#else
+#define CANNM_CACHE_LINE_SIZE					0
+#endif
+#endif
+
+#if (CANNM_CACHE_LINE_SIZE > 0)
+#define CANNM_CHANNEL_ALIGNED					__attribute__((aligned(CANNM_CACHE_LINE_SIZE)))
+#else
+#define CANNM_CHANNEL_ALIGNED
+#endif
+
+#define CANNM_TIMER_BIT(timer)					((uint8)(1U << (timer)))
+
+#define CANNM_SLEEP_READY_WORDS					((CANNM_CHANNEL_COUNT + 31) / 32)
+#define CANNM_SLEEP_READY_BIT(channel)			((uint32)1U << ((channel) % 32))
+
+/* Heap position of a channel without an outstanding transmit confirmation */
+#define CANNM_TX_DEADLINE_NONE					((NetworkHandleType)~0U)
+
+#if (CANNM_TRACE_ENABLED == STD_ON)
+#define CANNM_TRACE(channel, event, arg0, arg1) CanNm_Internal_Trace((channel), (event), (arg0), (arg1))
+#else
+#define CANNM_TRACE(channel, event, arg0, arg1)
+#endif
+
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+#define CANNM_LATENCY_START(channel, path)	CanNm_Internal_LatencyStart((channel), (path))
+#define CANNM_LATENCY_STOP(channel, path)	CanNm_Internal_LatencyStop((channel), (path))
+#define CANNM_LATENCY_CANCEL(channel, path)	(CanNm_Internal.Latency[(channel)].Pending &= (uint8)~(1U << (path)))
+#else
+#define CANNM_LATENCY_START(channel, path)
+#define CANNM_LATENCY_STOP(channel, path)
+#define CANNM_LATENCY_CANCEL(channel, path)
+#endif
+
+#if (CANNM_LATENCY_ENABLED == STD_ON) && (CANNM_LATENCY_CLOCK == CANNM_LATENCY_CLOCK_MONOTONIC)
+#ifndef CANNM_LATENCY_GET_TIME_NS
+#define CANNM_LATENCY_HOST_CLOCK
+#define CANNM_LATENCY_GET_TIME_NS() CanNm_Internal_GetTimeNs()
+#endif
+#define CANNM_LATENCY_NOW() ((uint64)CANNM_LATENCY_GET_TIME_NS())
+#else
+#define CANNM_LATENCY_NOW() ((uint64)CanNm_Internal.MainFunctionTicks)
+#endif
+
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+#define CANNM_STATISTICS_COUNT(channel, counter) \
+	__atomic_fetch_add(&CanNm_Internal.Statistics[(channel)].counter, 1, __ATOMIC_RELAXED)
+#else
+#define CANNM_STATISTICS_COUNT(channel, counter)
+#endif
+
 /*====================================================================================================================*\
     Local types
 \*====================================================================================================================*/
-typedef void (*CanNm_TimerCallback)(void* Timer, const uint8 channel);
+typedef void (*CanNm_TimerCallback)(const NetworkHandleType channel);
 
+/* Timers in the order they are ticked, same as CanNm_TraceTimerType */
 typedef enum {
-	CANNM_TIMER_STOPPED,
-	CANNM_TIMER_STARTED
-} CanNm_TimerState;
-
-typedef struct {
-	uint8						Channel;				
-	CanNm_TimerCallback 		ExpiredCallback;
-	CanNm_TimerState			State;
-	float32						TimeLeft;
-} CanNm_Timer;
+	CANNM_TIMER_TIMEOUT,								//NM-Timeout Timer, Tx Timeout Timer
+	CANNM_TIMER_MESSAGE_CYCLE,
+	CANNM_TIMER_REPEAT_MESSAGE,
+	CANNM_TIMER_WAIT_BUS_SLEEP,
+	CANNM_TIMER_REMOTE_SLEEP_IND,
+	CANNM_TIMER_COUNT
+} CanNm_Internal_TimerType;
 
 typedef enum {
 	CANNM_INIT,
@@ -99,29 +312,222 @@ typedef enum {
 } CanNm_InitStatusType;
 
 typedef struct {
-	uint8						Channel;
-	Nm_ModeType					Mode;					//[SWS_CanNm_00092]
-	Nm_StateType				State;					//[SWS_CanNm_00089]
-	boolean						Requested;
-	boolean						TxEnabled;
+	uint32						Deadlines[CANNM_TIMER_COUNT];	//Expiry tick while started, ticks left while stopped
+	uint32						ReducedCycleTicks;		//Node specific Message Cycle Timer restart on reception [SWS_CanNm_00069]
+	uint8						TimersStarted;			//Bit per CanNm_Internal_TimerType
+	uint8						Mode;					//Nm_ModeType [SWS_CanNm_00092]
+	uint8						State;					//Nm_StateType [SWS_CanNm_00089]
 	sint8						RxLastPdu;
-	CanNm_Timer					TimeoutTimer;			//NM-Timeout Timer, Tx Timeout Timer
-	CanNm_Timer					MessageCycleTimer;
-	CanNm_Timer					RepeatMessageTimer;
-	CanNm_Timer					WaitBusSleepTimer;
-	CanNm_Timer					RemoteSleepIndTimer;
 	uint8						ImmediateTransmissions;
-	boolean						BusLoadReduction;		//[SWS_CanNm_00238]
-	boolean						RemoteSleepInd;
-	boolean						RemoteSleepIndEnabled;
-	boolean						NmPduFilterAlgorithm;
-} CanNm_Internal_ChannelType;
+	uint8						TxRetries;				//Failed immediate transmissions in a row
+	boolean						Requested : 1;
+	boolean						TxEnabled : 1;
+	boolean						BusLoadReduction : 1;	//[SWS_CanNm_00238]
+	boolean						RemoteSleepInd : 1;
+	boolean						RemoteSleepIndEnabled : 1;
+	boolean						NmPduFilterAlgorithm : 1;
+	boolean						TxPending : 1;			//Deferred out-of-cycle transmission, retried by the main function
+	NetworkHandleType			Channel;
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+	const CanNm_ChannelType*	RetainedConf;			//Kept over CanNm_Reconfigure until a safe point
+#endif
+} CANNM_CHANNEL_ALIGNED CanNm_Internal_ChannelType;
+
+typedef struct {
+	uint32						Deadline;				//Main function tick of the confirmation timeout
+	NetworkHandleType			Channel;
+} CanNm_Internal_TxDeadlineType;
+
+/* Packed sleep readiness of all channels, a cluster is ready when each member is in one of the two bitmaps */
+typedef struct {
+	uint32						ReadyToSleep[CANNM_SLEEP_READY_WORDS];		//Ready Sleep, Prepare Bus-Sleep or Bus-Sleep state
+	uint32						RemoteSleepInd[CANNM_SLEEP_READY_WORDS];	//Remote sleep indicated
+	uint32						Clusters[CANNM_COORD_CLUSTER_COUNT][CANNM_SLEEP_READY_WORDS];	//Members per cluster
+	uint32						ClustersUsed;			//Bit per cluster with at least one member
+	uint32						ClustersReady;			//Bit per cluster, as last reported by CanNm_MainFunction
+	boolean						Changed;				//Readiness changed since the last evaluation of the clusters
+} CanNm_Internal_SleepReadyType;
+
+_Static_assert(CANNM_COORD_CLUSTER_COUNT <= 32, "CANNM_COORD_CLUSTER_COUNT exceeds the 32 bit cluster masks");
+
+/* Token bucket of a controller in 1/65536 NM PDUs, refilled for the main function ticks passed when it is taken from */
+typedef struct {
+	uint32						Tokens;
+	uint32						Capacity;				//TxBucketSize tokens, 0 without limit
+	uint32						TokensPerTick;
+	uint32						LastTick;				//Main function tick of the last refill
+} CanNm_Internal_TxLimiterType;
+
+_Static_assert(CANNM_CONTROLLER_COUNT <= CANNM_CHANNEL_COUNT, "CANNM_CONTROLLER_COUNT exceeds the exclusive area instances");
+
+/* Transmit confirmation deadlines of all channels, only the earliest one is checked per main function */
+typedef struct {
+	CanNm_Internal_TxDeadlineType Heap[CANNM_CHANNEL_COUNT];	//Min-heap on Deadline
+	NetworkHandleType			Positions[CANNM_CHANNEL_COUNT];	//Heap index per channel, CANNM_TX_DEADLINE_NONE if confirmed
+	uint32						Count;
+} CanNm_Internal_TxSupervisionType;
+
+/* NM PDU buffers of a channel, the configuration only gives their lengths and may stay read-only */
+typedef struct {
+	uint8						Tx[CANNM_PDU_MAX_LENGTH];	//NID, CBV and user data of the next NM PDU
+	uint8						Rx[CANNM_PDU_MAX_LENGTH];	//Most recently received NM PDU
+} CanNm_Internal_PduBuffersType;
+
+/* Cursors over a CanNm_SaveState blob, the writer counts on past the end to report the size needed */
+typedef struct {
+	uint8*						Buffer;
+	uint32						Size;
+	uint32						Position;
+} CanNm_Internal_StateWriterType;
+
+typedef struct {
+	const uint8*				Buffer;
+	uint32						Size;
+	uint32						Position;
+	boolean						Valid;					//No read went past the end
+} CanNm_Internal_StateReaderType;
+
+typedef enum {
+	CANNM_EVENT_NETWORK_REQUEST,
+	CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE,				//Network request with PnHandleMultipleNetworkRequests [SWS_CanNm_00444]
+	CANNM_EVENT_NETWORK_RELEASE,
+	CANNM_EVENT_PASSIVE_STARTUP,
+	CANNM_EVENT_REPEAT_MESSAGE_REQUEST,
+	CANNM_EVENT_RX,
+	CANNM_EVENT_RX_REPEAT_MESSAGE,						//NM PDU with the Repeat Message Bit set
+	CANNM_EVENT_TX_CONFIRMATION,
+	CANNM_EVENT_TIMEOUT,								//NM-Timeout Timer expired
+	CANNM_EVENT_REPEAT_MESSAGE_REQUESTED,				//Repeat Message Timer expired, network requested
+	CANNM_EVENT_REPEAT_MESSAGE_RELEASED,				//Repeat Message Timer expired, network released
+	CANNM_EVENT_WAIT_BUS_SLEEP,							//Wait Bus-Sleep Timer expired
+	CANNM_EVENT_COUNT
+} CanNm_Internal_EventType;
+
+typedef enum {
+	CANNM_NOTIFICATION_STATE_CHANGE,					//Arg0: previous state, Arg1: next state
+	CANNM_NOTIFICATION_REMOTE_SLEEP_IND,
+	CANNM_NOTIFICATION_REMOTE_SLEEP_CANCELLATION,
+	CANNM_NOTIFICATION_NETWORK_START,
+	CANNM_NOTIFICATION_PDU_RX,
+	CANNM_NOTIFICATION_NETWORK_MODE,					//Callouts only, never deferred
+	CANNM_NOTIFICATION_PREPARE_BUS_SLEEP_MODE,
+	CANNM_NOTIFICATION_BUS_SLEEP_MODE,
+	CANNM_NOTIFICATION_TX_TIMEOUT_EXCEPTION,
+	CANNM_NOTIFICATION_TRANSMIT,						//Arg0: TRUE for a message cycle transmission
+	CANNM_NOTIFICATION_DROPPED							//Removed from a full queue, never delivered
+} CanNm_Internal_NotificationKindType;
+
+typedef struct {
+	Nm_StateType				NextState;				//NM_STATE_UNINIT if the event is ignored in the state
+	uint32						Actions;				//CANNM_ACTION_* bits
+} CanNm_Internal_TransitionType;
+
+_Static_assert(CANNM_CHANNEL_COUNT <= ((1UL << (8 * sizeof(NetworkHandleType))) - 1),
+ "CANNM_CHANNEL_COUNT does not fit NetworkHandleType, define COMSTACK_NETWORK_HANDLE_16BIT");
+
+_Static_assert((CANNM_CACHE_LINE_SIZE == 0) || (sizeof(CanNm_Internal_ChannelType) == CANNM_CACHE_LINE_SIZE),
+ "Runtime state of a channel does not fit CANNM_CACHE_LINE_SIZE");
+
+#if (CANNM_TRACE_ENABLED == STD_ON)
+_Static_assert((CANNM_TRACE_RING_SIZE & (CANNM_TRACE_RING_SIZE - 1)) == 0, "CANNM_TRACE_RING_SIZE must be a power of two");
+
+typedef struct {
+	uint32						Head;					//Records written, only the channel owner advances it
+	CanNm_TraceRecordType		Records[CANNM_TRACE_RING_SIZE];
+} CanNm_Internal_TraceRingType;
+#endif
+
+typedef struct {
+	uint8						Kind;					//CanNm_Internal_NotificationKindType
+	uint8						Arg0;
+	uint8						Arg1;
+} CanNm_Internal_NotificationType;
+
+_Static_assert(CANNM_CALLOUT_QUEUE_SIZE > 0 && CANNM_CALLOUT_QUEUE_SIZE <= 255, "CANNM_CALLOUT_QUEUE_SIZE must be 1 to 255");
+
+typedef struct {
+	uint8						Count;					//Written under the channel exclusive area
+	CanNm_Internal_NotificationType Records[CANNM_CALLOUT_QUEUE_SIZE];
+} CanNm_Internal_CalloutQueueType;
+
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+_Static_assert(CANNM_NOTIFICATION_QUEUE_SIZE > 0 && CANNM_NOTIFICATION_QUEUE_SIZE <= 255,
+ "CANNM_NOTIFICATION_QUEUE_SIZE must be 1 to 255");
+
+typedef struct {
+	uint8						Count;					//Written under the channel exclusive area
+	CanNm_Internal_NotificationType Records[CANNM_NOTIFICATION_QUEUE_SIZE];
+} CanNm_Internal_NotificationQueueType;
+#endif
+
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+typedef struct {
+	uint32						RxCount;
+	uint32						TxCount;
+	uint32						TxFailedCount;
+	uint32						ImmediateTxCount;
+	uint32						TxRetryCount;
+	uint32						TxRetryGiveUpCount;
+	uint32						TxDeferredCount;
+	uint32						TxTimeoutCount;
+	uint32						TxConfirmationTimeoutCount;
+	uint32						RemoteSleepIndCount;
+	uint32						NotificationOverflowCount;
+	uint32						StateTicks[NM_STATE_SYNCHRONIZE + 1];
+	uint32						StateEnteredTick;		//Main function tick of the last state change
+} CanNm_Internal_StatisticsType;
+#endif
+
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+typedef struct {
+	uint8						Pending;				//Bit per CanNm_LatencyPathType with a running measurement
+	uint64						Start[CANNM_LATENCY_PATH_COUNT];
+	CanNm_LatencyHistogramType	Histograms[CANNM_LATENCY_PATH_COUNT];
+} CanNm_Internal_LatencyType;
+#endif
 
 typedef struct {
 	CanNm_InitStatusType 		InitStatus;
+	uint32						MainFunctionTicks;
 	CanNm_Internal_ChannelType	Channels[CANNM_CHANNEL_COUNT];
+	CanNm_Internal_PduBuffersType Pdus[CANNM_CHANNEL_COUNT];
+	CanNm_Internal_TxSupervisionType TxSupervision;
+	CanNm_Internal_SleepReadyType SleepReady;
+	CanNm_Internal_TxLimiterType TxLimiters[CANNM_CONTROLLER_COUNT];
+#if (CANNM_LAZY_INIT_ENABLED == STD_ON)
+	uint32						ChannelsInitialized[CANNM_SLEEP_READY_WORDS];	//Bit per channel set up since CanNm_Init
+#endif
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+	uint32						ChannelsRetainingConfig;	//Channels with a RetainedConf
+#endif
+#if (CANNM_TRACE_ENABLED == STD_ON)
+	CanNm_Internal_TraceRingType TraceRings[CANNM_CHANNEL_COUNT];
+#endif
+	CanNm_Internal_CalloutQueueType Callouts[CANNM_CHANNEL_COUNT];
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	CanNm_Internal_NotificationQueueType Notifications[CANNM_CHANNEL_COUNT];
+#endif
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+	CanNm_Internal_StatisticsType Statistics[CANNM_CHANNEL_COUNT];
+#endif
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+	CanNm_Internal_LatencyType	Latency[CANNM_CHANNEL_COUNT];
+#endif
 } CanNm_InternalType;
 
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+/* Configuration set bound to a configuration image, the tables without pointers stay in the image */
+typedef struct {
+	CanNm_ConfigType			Config;
+	CanNm_ChannelType			Channels[CANNM_CHANNEL_COUNT];
+	CanNm_TxPdu					TxPdus[CANNM_CHANNEL_COUNT];
+	CanNm_UserDataTxPdu			UserDataTxPdus[CANNM_CHANNEL_COUNT];
+	CanNm_RxPdu					RxPdus[CANNM_CHANNEL_COUNT][CANNM_RXPDU_MAX_COUNT];
+	PduInfoType					PduInfos[CANNM_PDU_MAX_LENGTH + 1];	//Per PDU length, shared by all channels
+	CanNm_PnInfo				PnInfo;
+} CanNm_Internal_ImageType;
+#endif
+
 /*====================================================================================================================*\
     Global variables
 \*====================================================================================================================*/
@@ -133,66 +539,233 @@ CanNm_InternalType CanNm_Internal = {
     Local variables (static)
 \*====================================================================================================================*/
 static const CanNm_ConfigType* CanNm_ConfigPtr;
+static const CanNm_CallbacksType* CanNm_Callbacks = &CanNm_DefaultCallbacks;
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+static CanNm_Internal_ImageType CanNm_Internal_Image;
+#endif
+
+/* Mode of each state [SWS_CanNm_00092] */
+static const Nm_ModeType CanNm_Internal_StateModes[NM_STATE_SYNCHRONIZE + 1] = {
+	[NM_STATE_UNINIT]			= NM_MODE_BUS_SLEEP,
+	[NM_STATE_BUS_SLEEP]		= NM_MODE_BUS_SLEEP,
+	[NM_STATE_PREPARE_BUS_SLEEP]= NM_MODE_PREPARE_BUS_SLEEP,
+	[NM_STATE_READY_SLEEP]		= NM_MODE_NETWORK,
+	[NM_STATE_NORMAL_OPERATION]	= NM_MODE_NETWORK,
+	[NM_STATE_REPEAT_MESSAGE]	= NM_MODE_NETWORK,
+	[NM_STATE_SYNCHRONIZE]		= NM_MODE_NETWORK
+};
+
+/* State machine [SWS_CanNm_00089], events missing in a state are ignored */
+static const CanNm_Internal_TransitionType CanNm_Internal_Transitions[NM_STATE_SYNCHRONIZE + 1][CANNM_EVENT_COUNT] = {
+	[NM_STATE_BUS_SLEEP] = {
+		[CANNM_EVENT_NETWORK_REQUEST]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00129][SWS_CanNm_00314]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTIONS_NETWORK_START | CANNM_ACTION_ACTIVE_WAKEUP },
+		[CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE]	= { NM_STATE_REPEAT_MESSAGE,
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTIONS_NETWORK_START | CANNM_ACTION_ACTIVE_WAKEUP },
+		[CANNM_EVENT_PASSIVE_STARTUP]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00128][SWS_CanNm_00314]
+			CANNM_ACTIONS_NETWORK_START },
+		[CANNM_EVENT_RX]						= { NM_STATE_BUS_SLEEP,			//[SWS_CanNm_00127]
+			CANNM_ACTION_NETWORK_START_IND | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+		[CANNM_EVENT_RX_REPEAT_MESSAGE]			= { NM_STATE_BUS_SLEEP,
+			CANNM_ACTION_NETWORK_START_IND | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+	},
+	[NM_STATE_PREPARE_BUS_SLEEP] = {
+		[CANNM_EVENT_NETWORK_REQUEST]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00123][SWS_CanNm_00315]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTIONS_NETWORK_START | CANNM_ACTION_ACTIVE_WAKEUP },
+		[CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE]	= { NM_STATE_REPEAT_MESSAGE,
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTIONS_NETWORK_START | CANNM_ACTION_ACTIVE_WAKEUP },
+		[CANNM_EVENT_PASSIVE_STARTUP]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00128][SWS_CanNm_00315]
+			CANNM_ACTIONS_NETWORK_START },
+		[CANNM_EVENT_RX]						= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00124][SWS_CanNm_00315]
+			CANNM_ACTIONS_NETWORK_START },
+		[CANNM_EVENT_RX_REPEAT_MESSAGE]			= { NM_STATE_REPEAT_MESSAGE,
+			CANNM_ACTIONS_NETWORK_START },
+		[CANNM_EVENT_WAIT_BUS_SLEEP]			= { NM_STATE_BUS_SLEEP,			//[SWS_CanNm_00088]
+			CANNM_ACTION_BUS_SLEEP_MODE | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+	},
+	[NM_STATE_READY_SLEEP] = {
+		[CANNM_EVENT_NETWORK_REQUEST]			= { NM_STATE_NORMAL_OPERATION,	//[SWS_CanNm_00110][SWS_CanNm_00116]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTION_BUS_LOAD_REDUCTION_ON | CANNM_ACTION_START_MESSAGE_CYCLE |
+			CANNM_ACTION_START_REMOTE_SLEEP_IND | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+		[CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE]	= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00444][SWS_CanNm_00454]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTIONS_REPEAT_MESSAGE | CANNM_ACTION_IMMEDIATE_TX },
+		[CANNM_EVENT_REPEAT_MESSAGE_REQUEST]	= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00112]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTION_SET_REPEAT_MESSAGE_BIT | CANNM_ACTIONS_REPEAT_MESSAGE },
+		[CANNM_EVENT_RX]						= { NM_STATE_READY_SLEEP,		//[SWS_CanNm_00098]
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_RX_REPEAT_MESSAGE]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00111][SWS_CanNm_00119]
+			CANNM_ACTION_TX_ENABLE | CANNM_ACTION_START_TIMEOUT | CANNM_ACTIONS_REPEAT_MESSAGE |
+			CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_TX_CONFIRMATION]			= { NM_STATE_READY_SLEEP,		//[SWS_CanNm_00099]
+			CANNM_ACTION_START_TIMEOUT },
+		[CANNM_EVENT_TIMEOUT]					= { NM_STATE_PREPARE_BUS_SLEEP,	//[SWS_CanNm_00109]
+			CANNM_ACTION_CLEAR_ACTIVE_WAKEUP_BIT | CANNM_ACTION_START_WAIT_BUS_SLEEP |
+			CANNM_ACTION_PREPARE_BUS_SLEEP_MODE | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+	},
+	[NM_STATE_NORMAL_OPERATION] = {
+		[CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE]	= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00444][SWS_CanNm_00454]
+			CANNM_ACTIONS_REPEAT_MESSAGE | CANNM_ACTION_IMMEDIATE_TX },
+		[CANNM_EVENT_NETWORK_RELEASE]			= { NM_STATE_READY_SLEEP,		//[SWS_CanNm_00118]
+			CANNM_ACTION_TX_DISABLE | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+		[CANNM_EVENT_REPEAT_MESSAGE_REQUEST]	= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00120]
+			CANNM_ACTION_SET_REPEAT_MESSAGE_BIT | CANNM_ACTIONS_REPEAT_MESSAGE },
+		[CANNM_EVENT_RX]						= { NM_STATE_NORMAL_OPERATION,	//[SWS_CanNm_00098]
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_RX_REPEAT_MESSAGE]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00119]
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTIONS_REPEAT_MESSAGE | CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_TX_CONFIRMATION]			= { NM_STATE_NORMAL_OPERATION,	//[SWS_CanNm_00099]
+			CANNM_ACTION_START_TIMEOUT },
+		[CANNM_EVENT_TIMEOUT]					= { NM_STATE_NORMAL_OPERATION,	//[SWS_CanNm_00117]
+			CANNM_ACTION_TX_TIMEOUT_EXCEPTION | CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+	},
+	[NM_STATE_REPEAT_MESSAGE] = {
+		[CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE]	= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00444][SWS_CanNm_00454]
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_STATE_CHANGE_NOTIFICATION | CANNM_ACTION_IMMEDIATE_TX },
+		[CANNM_EVENT_RX]						= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00098]
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_RX_REPEAT_MESSAGE]			= { NM_STATE_REPEAT_MESSAGE,
+			CANNM_ACTION_START_TIMEOUT | CANNM_ACTION_RX_REMOTE_SLEEP_IND },
+		[CANNM_EVENT_TX_CONFIRMATION]			= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00099]
+			CANNM_ACTION_START_TIMEOUT },
+		[CANNM_EVENT_TIMEOUT]					= { NM_STATE_REPEAT_MESSAGE,	//[SWS_CanNm_00101]
+			CANNM_ACTION_TX_TIMEOUT_EXCEPTION | CANNM_ACTION_START_TIMEOUT },
+		[CANNM_EVENT_REPEAT_MESSAGE_REQUESTED]	= { NM_STATE_NORMAL_OPERATION,	//[SWS_CanNm_00103]
+			CANNM_ACTION_BUS_LOAD_REDUCTION_ON | CANNM_ACTION_CLEAR_CBV | CANNM_ACTION_START_REMOTE_SLEEP_IND |
+			CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+		[CANNM_EVENT_REPEAT_MESSAGE_RELEASED]	= { NM_STATE_READY_SLEEP,		//[SWS_CanNm_00106]
+			CANNM_ACTION_TX_DISABLE | CANNM_ACTION_CLEAR_CBV | CANNM_ACTION_STATE_CHANGE_NOTIFICATION },
+	},
+};
 
 /*====================================================================================================================*\
     Local functions declarations
 \*====================================================================================================================*/
 /* Timer functions */
-static inline void CanNm_Internal_TimerStart( CanNm_Timer* Timer, uint32 timeoutValue );
-static inline void CanNm_Internal_TimerResume( CanNm_Timer* Timer );
-static inline void CanNm_Internal_TimerStop( CanNm_Timer* Timer );
-static inline void CanNm_Internal_TimerReset( CanNm_Timer* Timer, uint32 timeoutValue );
-static inline void CanNm_Internal_TimerTick( CanNm_Timer* Timer, const uint8 channel, const float32 period );
-
-static inline void CanNm_Internal_TimersInit( uint8 channel );
-static inline void CanNm_Internal_TimeoutTimerExpiredCallback( void* Timer, const uint8 channel );
-static inline void CanNm_Internal_MessageCycleTimerExpiredCallback( void* Timer, const uint8 channel );
-static inline void CanNm_Internal_RepeatMessageTimerExpiredCallback( void* Timer, const uint8 channel );
-static inline void CanNm_Internal_WaitBusSleepTimerExpiredCallback( void* Timer, const uint8 channel );
-static inline void CanNm_Internal_RemoteSleepIndTimerExpiredCallback( void* Timer, const uint8 channel );
+static inline void CanNm_Internal_TimerStart( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 timeoutValue );
+static inline void CanNm_Internal_TimerStartTicks( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 ticks );
+static inline void CanNm_Internal_TimerResume( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer );
+static inline void CanNm_Internal_TimerStop( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer );
+static inline void CanNm_Internal_TimerReset( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 timeoutValue );
+static inline void CanNm_Internal_TimerTick( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, const NetworkHandleType channel );
+static inline boolean CanNm_Internal_TimerIsStarted( const CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer );
+static inline uint32 CanNm_Internal_TimerTicksLeft( const CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer );
+static inline uint32 CanNm_Internal_TimeToTicks( uint32 timeoutValue );
+static inline uint32 CanNm_Internal_TimeToPeriods( uint32 timeoutValue, float32 period );
+
+static inline void CanNm_Internal_TimersInit( NetworkHandleType channel );
+static inline void CanNm_Internal_TimeoutTimerExpiredCallback( const NetworkHandleType channel );
+static inline void CanNm_Internal_MessageCycleTimerExpiredCallback( const NetworkHandleType channel );
+static inline void CanNm_Internal_MessageCycleRestart( const CanNm_ChannelType* ChannelConf,
+ 														CanNm_Internal_ChannelType* ChannelInternal, Std_ReturnType txStatus );
+static inline void CanNm_Internal_RepeatMessageTimerExpiredCallback( const NetworkHandleType channel );
+static inline void CanNm_Internal_WaitBusSleepTimerExpiredCallback( const NetworkHandleType channel );
+static inline void CanNm_Internal_RemoteSleepIndTimerExpiredCallback( const NetworkHandleType channel );
+
+static const CanNm_TimerCallback CanNm_Internal_TimerCallbacks[CANNM_TIMER_COUNT] = {
+	[CANNM_TIMER_TIMEOUT]			= CanNm_Internal_TimeoutTimerExpiredCallback,
+	[CANNM_TIMER_MESSAGE_CYCLE]		= CanNm_Internal_MessageCycleTimerExpiredCallback,
+	[CANNM_TIMER_REPEAT_MESSAGE]	= CanNm_Internal_RepeatMessageTimerExpiredCallback,
+	[CANNM_TIMER_WAIT_BUS_SLEEP]	= CanNm_Internal_WaitBusSleepTimerExpiredCallback,
+	[CANNM_TIMER_REMOTE_SLEEP_IND]	= CanNm_Internal_RemoteSleepIndTimerExpiredCallback
+};
 
 /* State Machine functions */
-static inline void CanNm_Internal_BusSleep_to_BusSleep( const CanNm_ChannelType* ChannelConf,
- 														CanNm_Internal_ChannelType* ChannelInternal );
-static inline void 	 CanNm_Internal_BusSleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_RepeatMessage_to_RepeatMessage( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_RepeatMessage_to_ReadySleep( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_RepeatMessage_to_NormalOperation( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_NormalOperation_to_RepeatMessage( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_NormalOperation_to_NormalOperation( const CanNm_ChannelType* ChannelConf,
- 																		CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_NormalOperation_to_ReadySleep( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_ReadySleep_to_NormalOperation( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_ReadySleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_ReadySleep_to_PrepareBusSleep( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_PrepareBusSleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf,
- 																	CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_PrepareBusSleep_to_BusSleep( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_NetworkMode_to_NetworkMode( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
+static Std_ReturnType CanNm_Internal_Transition( const CanNm_ChannelType* ChannelConf,
+ 												CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_EventType Event );
 
 /* Additional functions */
+static void CanNm_Internal_ChannelInit( NetworkHandleType channel );
+static inline void CanNm_Internal_ChannelsClear( void );
+static inline void CanNm_Internal_LazyInit( NetworkHandleType channel );
+static inline const CanNm_ChannelType* CanNm_Internal_GetChannelConf( NetworkHandleType channel );
+static boolean CanNm_Internal_PduLengthsValid( const CanNm_ConfigType* config );
+static inline PduLengthType CanNm_Internal_PduCopyLength( PduLengthType configured, PduLengthType available );
 static inline Std_ReturnType CanNm_Internal_TxDisable( CanNm_Internal_ChannelType* ChannelInternal );
 static inline Std_ReturnType CanNm_Internal_TxEnable( CanNm_Internal_ChannelType* ChannelInternal );
 static inline Std_ReturnType CanNm_Internal_TransmitMessage( const CanNm_ChannelType* ChannelConf,
- 																CanNm_Internal_ChannelType* ChannelInternal );
-static inline void CanNm_Internal_SetPduCbvBit( const CanNm_ChannelType* ChannelConf, const uint8 PduCbvBitPosition );
-static inline void CanNm_Internal_ClearPduCbvBit( const CanNm_ChannelType* ChannelConf, const uint8 PduCbvBitPosition );
+ 																CanNm_Internal_ChannelType* ChannelInternal, boolean cycle );
+static void CanNm_Internal_TransmitCallout( NetworkHandleType channel, boolean cycle );
+static inline void CanNm_Internal_SetPduCbvBit( const CanNm_ChannelType* ChannelConf,
+ 												CanNm_Internal_ChannelType* ChannelInternal, const uint8 PduCbvBitPosition );
+static inline void CanNm_Internal_ClearPduCbvBit( const CanNm_ChannelType* ChannelConf,
+ 												CanNm_Internal_ChannelType* ChannelInternal, const uint8 PduCbvBitPosition );
 static inline void CanNm_Internal_ClearPduCbv( const CanNm_ChannelType* ChannelConf,
  												CanNm_Internal_ChannelType* ChannelInternal );
 static inline uint8 CanNm_Internal_GetUserDataOffset( const CanNm_ChannelType* ChannelConf );
 static inline uint8* CanNm_Internal_GetUserDataPtr( const CanNm_ChannelType* ChannelConf, uint8* MessageSduPtr );
 static inline uint8 CanNm_Internal_GetUserDataLength( const CanNm_ChannelType* ChannelConf );
+static inline uint32 CanNm_Internal_GetTxRetryTicks( const CanNm_ChannelType* ChannelConf, uint8 retry );
+static inline uint8 CanNm_Internal_GetTxRetryLimit( const CanNm_ChannelType* ChannelConf );
+static inline uint32 CanNm_Internal_GetReducedCycleTicks( const CanNm_ChannelType* ChannelConf, float32 period );
+static inline uint32 CanNm_Internal_GetWakeUpStaggerTicks( const CanNm_ChannelType* ChannelConf, NetworkHandleType channel );
+static inline uint32 CanNm_Internal_GetReducedCycleSlots( const CanNm_ChannelType* ChannelConf, float32 period );
+static inline uint32 CanNm_Internal_GetFrameBits( PduLengthType sduLength );
+static inline void CanNm_Internal_TxDeadlinesInit( void );
+static inline void CanNm_Internal_TxDeadlineArm( const CanNm_ChannelType* ChannelConf, NetworkHandleType channel );
+static inline void CanNm_Internal_TxDeadlineInsert( NetworkHandleType channel, uint32 deadline );
+static inline void CanNm_Internal_TxDeadlineClear( NetworkHandleType channel );
+static inline void CanNm_Internal_TxDeadlineRemove( NetworkHandleType channel );
+static inline void CanNm_Internal_TxDeadlineSwap( uint32 first, uint32 second );
+static inline void CanNm_Internal_TxDeadlinesExpire( void );
+static inline void CanNm_Internal_TxLimitersInit( void );
+static inline void CanNm_Internal_TxLimiterConfigure( CanNm_Internal_TxLimiterType* limiter, uint8 controller );
+static inline boolean CanNm_Internal_TxLimiterTake( const CanNm_ChannelType* ChannelConf );
+static inline void CanNm_Internal_SleepReadyInit( void );
+static inline void CanNm_Internal_SetSleepReadyBit( uint32* bitmap, NetworkHandleType channel, boolean value );
+static inline void CanNm_Internal_UpdateSleepReady( const CanNm_Internal_ChannelType* ChannelInternal );
+static inline boolean CanNm_Internal_IsClusterSleepReady( uint8 cluster );
+static inline void CanNm_Internal_CheckClusters( void );
+static inline void CanNm_Internal_StatePut( CanNm_Internal_StateWriterType* writer, uint32 value, uint8 bytes );
+static inline void CanNm_Internal_StatePutBytes( CanNm_Internal_StateWriterType* writer, const uint8* data, uint32 length );
+static inline uint32 CanNm_Internal_StateGet( CanNm_Internal_StateReaderType* reader, uint8 bytes );
+static inline const uint8* CanNm_Internal_StateGetBytes( CanNm_Internal_StateReaderType* reader, uint32 length );
+static uint32 CanNm_Internal_StateCrc( const uint8* data, uint32 length );
+static void CanNm_Internal_SaveChannel( CanNm_Internal_StateWriterType* writer, NetworkHandleType channel );
+static boolean CanNm_Internal_RestoreChannel( CanNm_Internal_StateReaderType* reader, NetworkHandleType channel, boolean apply );
+static boolean CanNm_Internal_RestoreState( const uint8* buffer, uint32 length, boolean apply );
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+static boolean CanNm_Internal_ImageTableValid( const CanNm_ImageHeaderType* Header, const CanNm_ImageTableType* Table,
+ 												uint32 entrySize );
+static boolean CanNm_Internal_ImageChannelValid( const CanNm_ImageHeaderType* Header, const CanNm_ImageChannelType* Channel );
+static boolean CanNm_Internal_ImageValid( const uint8* image, uint32 length );
+static void CanNm_Internal_ImageBind( const uint8* image );
+#endif
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+static boolean CanNm_Internal_ReconfigureValid( const CanNm_ConfigType* Current, const CanNm_ConfigType* Next );
+static inline boolean CanNm_Internal_ReconfigureSafe( const CanNm_Internal_ChannelType* ChannelInternal,
+ 														NetworkHandleType channel );
+static inline void CanNm_Internal_AdoptConfig( CanNm_Internal_ChannelType* ChannelInternal, NetworkHandleType channel );
+#endif
+static inline void CanNm_Internal_StateChanged( const CanNm_Internal_ChannelType* ChannelInternal,
+ 												Nm_StateType PreviousState, Nm_StateType NextState );
+static inline void CanNm_Internal_Notify( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind,
+ 											uint8 arg0, uint8 arg1 );
+static inline void CanNm_Internal_NotificationLatencyStop( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind );
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+static uint8 CanNm_Internal_NotificationMakeRoom( CanNm_Internal_NotificationType* records, uint8 count );
+#endif
+static inline void CanNm_Internal_DeliverNotification( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind,
+ 														uint8 arg0, uint8 arg1 );
+static inline void CanNm_Internal_Callout( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind,
+ 												uint8 arg0, uint8 arg1 );
+static void CanNm_Internal_FlushCallouts( NetworkHandleType channel );
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+static void CanNm_Internal_FlushNotifications( NetworkHandleType channel );
+#endif
+#if (CANNM_TRACE_ENABLED == STD_ON)
+static inline void CanNm_Internal_Trace( NetworkHandleType channel, CanNm_TraceEventType event, uint8 arg0, uint32 arg1 );
+#endif
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+static inline void CanNm_Internal_ResetStatistics( NetworkHandleType channel );
+#endif
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+static inline void CanNm_Internal_LatencyStart( NetworkHandleType channel, CanNm_LatencyPathType path );
+static inline void CanNm_Internal_LatencyStop( NetworkHandleType channel, CanNm_LatencyPathType path );
+static inline void CanNm_Internal_ResetLatency( NetworkHandleType channel );
+#endif
+#ifdef CANNM_LATENCY_HOST_CLOCK
+static inline uint64 CanNm_Internal_GetTimeNs( void );
+#endif
 
 /*====================================================================================================================*\
 	Global inline functions and function macros code
@@ -222,12 +795,27 @@ FAKE_VOID_FUNC(Nm_RemoteSleepInd, NetworkHandleType);
 FAKE_VOID_FUNC(Nm_RepeatMessageIndication, NetworkHandleType);
 FAKE_VOID_FUNC(Nm_StateChangeNotification, NetworkHandleType, Nm_StateType, Nm_StateType);
 FAKE_VOID_FUNC(Nm_TxTimeoutException, NetworkHandleType);
-FAKE_VOID_FUNC(PduR_CanNmRxIndication, PduIdType, PduInfoType*);
+FAKE_VOID_FUNC(PduR_CanNmRxIndication, PduIdType, const PduInfoType*);
 FAKE_VOID_FUNC(PduR_CanNmTriggerTransmit, PduIdType, PduInfoType*);
 FAKE_VOID_FUNC(PduR_CanNmTxConfirmation, PduIdType);
 
 #endif //UNIT_TEST
 
+const CanNm_CallbacksType CanNm_DefaultCallbacks = {
+	.CanIfTransmit = CanIf_Transmit,
+	.CanSmTxTimeoutException = CanSM_TxTimeoutException,
+	.NmBusSleepMode = Nm_BusSleepMode,
+	.NmNetworkMode = Nm_NetworkMode,
+	.NmNetworkStartIndication = Nm_NetworkStartIndication,
+	.NmPduRxIndication = Nm_PduRxIndication,
+	.NmPrepareBusSleepMode = Nm_PrepareBusSleepMode,
+	.NmRemoteSleepCancellation = Nm_RemoteSleepCancellation,
+	.NmRemoteSleepInd = Nm_RemoteSleepInd,
+	.NmStateChangeNotification = Nm_StateChangeNotification,
+	.NmTxTimeoutException = Nm_TxTimeoutException,
+	.PduRRxIndication = PduR_CanNmRxIndication
+};
+
 /*====================================================================================================================*\
     Global functions code
 \*====================================================================================================================*/
@@ -238,36 +826,30 @@ FAKE_VOID_FUNC(PduR_CanNmTxConfirmation, PduIdType);
  */
 void CanNm_Init(const CanNm_ConfigType* cannmConfigPtr)
 {
+	if (!CanNm_Internal_PduLengthsValid(cannmConfigPtr)) {
+		return;																					//PDUs larger than the buffers, stays uninitialized
+	}
     CanNm_ConfigPtr = cannmConfigPtr;	//[SWS_CanNm_00060]
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_Internal.Channels[channel].RetainedConf = NULL;
+	}
+	CanNm_Internal.ChannelsRetainingConfig = 0;
+#endif
+	CanNm_Callbacks = (cannmConfigPtr->Callbacks != NULL) ? cannmConfigPtr->Callbacks : &CanNm_DefaultCallbacks;
+	CanNm_Internal_TxDeadlinesInit();
+	CanNm_Internal_TxLimitersInit();
+	CanNm_Internal_SleepReadyInit();
 
-	for (uint8 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
-		const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-		CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
-
-		ChannelInternal->Channel = channel;
-		ChannelInternal->Mode = NM_MODE_BUS_SLEEP;														//[SWS_CanNm_00144]
-		ChannelInternal->State = NM_STATE_BUS_SLEEP;													//[SWS_CanNm_00141][SWS_CanNm_00094]
-		ChannelInternal->Requested = FALSE;																//[SWS_CanNm_00143]
-		ChannelInternal->TxEnabled = FALSE;
-		ChannelInternal->RxLastPdu = NO_PDU_RECEIVED;
-		ChannelInternal->ImmediateTransmissions = 0;
-		ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00023]
-		ChannelInternal->RemoteSleepInd = FALSE;
-		ChannelInternal->RemoteSleepIndEnabled = CanNm_ConfigPtr->RemoteSleepIndEnabled;
-		ChannelInternal->NmPduFilterAlgorithm = FALSE;
-
-		if (ChannelConf->NodeIdEnabled && ChannelConf->PduNidPosition != CANNM_PDU_OFF) {
-			ChannelConf->TxPdu->TxPduRef->SduDataPtr[ChannelConf->PduNidPosition] = ChannelConf->NodeId;//[SWS_CanNm_00013]
+	if (CANNM_LAZY_INIT()) {
+		CanNm_Internal_ChannelsClear();
+	} else {
+		for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+			CanNm_Internal_ChannelInit(channel);
 		}
-
-		CanNm_Internal_ClearPduCbv(ChannelConf, ChannelInternal);										//[SWS_CanNm_00085]
-
-		uint8* destUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, ChannelConf->UserDataTxPdu->TxUserDataPduRef->SduDataPtr);
-		uint8 userDataLength = CanNm_Internal_GetUserDataLength(ChannelConf);
-		memset(destUserData, 0xFF, userDataLength);														//[SWS_CanNm_00025]
-
-		CanNm_Internal_TimersInit(channel);																//[SWS_CanNm_00061][SWS_CanNm_00033]
 	}
+	CanNm_Internal.SleepReady.ClustersReady = CanNm_Internal.SleepReady.ClustersUsed;	//All channels start in Bus-Sleep
+	CanNm_Internal.SleepReady.Changed = FALSE;
 	CanNm_Internal.InitStatus = CANNM_INIT;
 }
 
@@ -277,15 +859,16 @@ void CanNm_Init(const CanNm_ConfigType* cannmConfigPtr)
  */
 void CanNm_DeInit(void)
 {
-    for (uint8 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+    for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
 		CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
 
-		if (ChannelInternal->State != NM_STATE_BUS_SLEEP) {
+		if (ChannelInternal->State != NM_STATE_BUS_SLEEP && ChannelInternal->State != NM_STATE_UNINIT) {	//Unused with lazy init
 			return;
 		}
 		CanNm_Internal_TimersInit(channel);
 		ChannelInternal->State = NM_STATE_UNINIT;
 	}
+	CanNm_Internal_TxDeadlinesInit();
 	CanNm_Internal.InitStatus = CANNM_UNINIT;
 }
 
@@ -296,16 +879,19 @@ void CanNm_DeInit(void)
  */ 
 Std_ReturnType CanNm_PassiveStartUp(NetworkHandleType nmChannelHandle)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 	Std_ReturnType status = E_OK;
 
-	if (CanNm_ConfigPtr->PassiveModeEnabled && ChannelInternal->Mode != NM_MODE_NETWORK) {				//[SWS_CanNm_00161]
-        CanNm_Internal_BusSleep_to_RepeatMessage(ChannelConf, ChannelInternal);							//[SWS_CanNm_00128][SWS_CanNm_00314][SWS_CanNm_00315]
-		status = E_OK;
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (CANNM_PASSIVE_MODE()) {																			//[SWS_CanNm_00161]
+		status = CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_PASSIVE_STARTUP);	//[SWS_CanNm_00128]
 	} else {
 		status = E_NOT_OK;																				//[SWS_CanNm_00147]
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
 	return status;
 }
 
@@ -315,71 +901,24 @@ Std_ReturnType CanNm_PassiveStartUp(NetworkHandleType nmChannelHandle)
  */
 Std_ReturnType CanNm_NetworkRequest(NetworkHandleType nmChannelHandle)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (!ChannelInternal->Requested) {
+		CANNM_LATENCY_CANCEL(nmChannelHandle, CANNM_LATENCY_NETWORK_RELEASE_TO_BUS_SLEEP);
+		CANNM_LATENCY_START(nmChannelHandle, CANNM_LATENCY_NETWORK_REQUEST_TO_TX);
+	}
 	ChannelInternal->Requested = TRUE;	//[SWS_CanNm_00104][SWS_CanNm_00255]
 
-	if (ChannelInternal->Mode == NM_MODE_BUS_SLEEP) {
-		if (!CanNm_ConfigPtr->PassiveModeEnabled) {
-			ChannelInternal->TxEnabled = TRUE;															//[SWS_CanNm_00072]
-		}
-		CanNm_Internal_BusSleep_to_RepeatMessage(ChannelConf, ChannelInternal);							//[SWS_CanNm_00129][SWS_CanNm_00314]
-		if (ChannelConf->ActiveWakeupBitEnabled) {
-			CanNm_Internal_SetPduCbvBit(ChannelConf, ACTIVE_WAKEUP_BIT);								//[SWS_CanNm_00401]
-			if (ChannelConf->ImmediateNmTransmissions) {												//[SWS_CanNm_00005][SWS_CanNm_00334]
-				ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
-				CanNm_Internal_MessageCycleTimerExpiredCallback(&ChannelInternal->MessageCycleTimer,
-				 ChannelInternal->MessageCycleTimer.Channel);
-			}
-		}
-	} else if (ChannelInternal->Mode == NM_MODE_PREPARE_BUS_SLEEP) {
-		if (!CanNm_ConfigPtr->PassiveModeEnabled) {
-			ChannelInternal->TxEnabled = TRUE;															//[SWS_CanNm_00072]
-		}
-		CanNm_Internal_PrepareBusSleep_to_RepeatMessage(ChannelConf, ChannelInternal);					//[SWS_CanNm_00123][SWS_CanNm_00315]
-		if (ChannelConf->ActiveWakeupBitEnabled) {
-			CanNm_Internal_SetPduCbvBit(ChannelConf, ACTIVE_WAKEUP_BIT);								//[SWS_CanNm_00401]
-			if (CanNm_ConfigPtr->ImmediateRestartEnabled || ChannelConf->ImmediateNmTransmissions) {	//[SWS_CanNm_00005][SWS_CanNm_00122][SWS_CanNm_00334]
-				ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
-				CanNm_Internal_MessageCycleTimerExpiredCallback(&ChannelInternal->MessageCycleTimer,
-				 ChannelInternal->MessageCycleTimer.Channel);
-			}
-		}
-	} else if (ChannelInternal->Mode == NM_MODE_NETWORK) {
-		if (ChannelInternal->State == NM_STATE_READY_SLEEP) {
-			if (ChannelConf->PnHandleMultipleNetworkRequests && ChannelConf->ImmediateNmTransmissions) {//[SWS_CanNm_00444][SWS_CanNm_00454]
-				CanNm_Internal_ReadySleep_to_RepeatMessage(ChannelConf, ChannelInternal);
-				ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
-				CanNm_Internal_MessageCycleTimerExpiredCallback(&ChannelInternal->MessageCycleTimer,
-				 ChannelInternal->MessageCycleTimer.Channel);
-			}
-			else {
-				CanNm_Internal_ReadySleep_to_NormalOperation(ChannelConf, ChannelInternal);				//[SWS_CanNm_00110]
-				if (CanNm_ConfigPtr->RemoteSleepIndEnabled) {											//[SWS_CanNm_00149]
-					CanNm_Internal_TimerStart(&ChannelInternal->RemoteSleepIndTimer, ChannelConf->RemoteSleepIndTime);
-				}
-			}
-		} else if (ChannelInternal->State == NM_STATE_NORMAL_OPERATION) {
-			if (ChannelConf->PnHandleMultipleNetworkRequests && ChannelConf->ImmediateNmTransmissions) {//[SWS_CanNm_00444][SWS_CanNm_00454]
-				CanNm_Internal_NormalOperation_to_RepeatMessage(ChannelConf, ChannelInternal);
-				ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
-				CanNm_Internal_MessageCycleTimerExpiredCallback(&ChannelInternal->MessageCycleTimer,
-				 ChannelInternal->MessageCycleTimer.Channel);
-			}
-		} else if (ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) {
-			if (ChannelConf->PnHandleMultipleNetworkRequests && ChannelConf->ImmediateNmTransmissions) {//[SWS_CanNm_00444][SWS_CanNm_00454]
-				CanNm_Internal_RepeatMessage_to_RepeatMessage(ChannelConf, ChannelInternal);
-				ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
-				CanNm_Internal_MessageCycleTimerExpiredCallback(&ChannelInternal->MessageCycleTimer,
-				 ChannelInternal->MessageCycleTimer.Channel);
-			}		
-		} else {
-			//Nothing to be done
-		}
+	if (ChannelConf->PnHandleMultipleNetworkRequests && ChannelConf->ImmediateNmTransmissions) {		//[SWS_CanNm_00444]
+		(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_NETWORK_REQUEST_IMMEDIATE);
 	} else {
-		//Nothing to be done
+		(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_NETWORK_REQUEST);
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
 	return E_OK;
 }
 
@@ -389,16 +928,20 @@ Std_ReturnType CanNm_NetworkRequest(NetworkHandleType nmChannelHandle)
  */
 Std_ReturnType CanNm_NetworkRelease(NetworkHandleType nmChannelHandle)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelInternal->Requested) {
+		CANNM_LATENCY_CANCEL(nmChannelHandle, CANNM_LATENCY_NETWORK_REQUEST_TO_TX);
+		CANNM_LATENCY_START(nmChannelHandle, CANNM_LATENCY_NETWORK_RELEASE_TO_BUS_SLEEP);
+	}
 	ChannelInternal->Requested = FALSE;	//[SWS_CanNm_00105]
 
-	if (ChannelInternal->Mode == NM_MODE_NETWORK) {
-		if (ChannelInternal->State == NM_STATE_NORMAL_OPERATION) {
-			CanNm_Internal_NormalOperation_to_ReadySleep(ChannelConf, ChannelInternal);			//[SWS_CanNm_00118]
-		}
-	}
+	(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_NETWORK_RELEASE);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
 	return E_OK;
 }
 
@@ -409,12 +952,17 @@ Std_ReturnType CanNm_NetworkRelease(NetworkHandleType nmChannelHandle)
 Std_ReturnType CanNm_DisableCommunication(NetworkHandleType nmChannelHandle)
 {
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	Std_ReturnType status = E_OK;
 
-	if (ChannelInternal->Mode == NM_MODE_NETWORK && !(CanNm_ConfigPtr->PassiveModeEnabled)) {	//[SWS_CanNm_00170]
-		return CanNm_Internal_TxDisable(ChannelInternal);
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelInternal->Mode == NM_MODE_NETWORK && !CANNM_PASSIVE_MODE()) {	//[SWS_CanNm_00170]
+		status = CanNm_Internal_TxDisable(ChannelInternal);
 	} else {																					//[SWS_CanNm_00172][SWS_CanNm_00298]
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_EnableCommunication [SWS_CanNm_00216]
@@ -424,16 +972,21 @@ Std_ReturnType CanNm_DisableCommunication(NetworkHandleType nmChannelHandle)
 Std_ReturnType CanNm_EnableCommunication(NetworkHandleType nmChannelHandle)
 {
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	Std_ReturnType status = E_OK;
 
-	if (ChannelInternal->Mode == NM_MODE_NETWORK && !(CanNm_ConfigPtr->PassiveModeEnabled)) {	//[SWS_CanNm_00170]
-		if (ChannelInternal->MessageCycleTimer.State == CANNM_TIMER_STOPPED) {					//[SWS_CanNm_00176]
-			return CanNm_Internal_TxEnable(ChannelInternal);
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelInternal->Mode == NM_MODE_NETWORK && !CANNM_PASSIVE_MODE()) {	//[SWS_CanNm_00170]
+		if (!CanNm_Internal_TimerIsStarted(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE)) {					//[SWS_CanNm_00176]
+			status = CanNm_Internal_TxEnable(ChannelInternal);
 		} else {																				//[SWS_CanNm_00177]
-			return E_NOT_OK;
+			status = E_NOT_OK;
 		}
 	} else {																					//[SWS_CanNm_00295][SWS_CanNm_00297]
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_SetUserData [SWS_CanNm_00217]
@@ -442,13 +995,16 @@ Std_ReturnType CanNm_EnableCommunication(NetworkHandleType nmChannelHandle)
  */
 Std_ReturnType CanNm_SetUserData(NetworkHandleType nmChannelHandle, const uint8* nmUserDataPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-	if (CanNm_ConfigPtr->UserDataEnabled && !CanNm_ConfigPtr->ComUserDataSupport) {				//[SWS_CanNm_00158][SWS_CanNm_00327]
-		uint8* destUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, ChannelConf->UserDataTxPdu->TxUserDataPduRef->SduDataPtr);
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	if (CANNM_USER_DATA() && !CANNM_COM_USER_DATA()) {				//[SWS_CanNm_00158][SWS_CanNm_00327]
+		uint8* destUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, CanNm_Internal.Pdus[nmChannelHandle].Tx);
 		uint8 userDataLength = CanNm_Internal_GetUserDataLength(ChannelConf);
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, nmChannelHandle);
 		memcpy(destUserData, nmUserDataPtr, userDataLength);									//[SWS_CanNm_00159]	
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, nmChannelHandle);
 		return E_OK;
 	}
 	else {
@@ -462,17 +1018,23 @@ Std_ReturnType CanNm_SetUserData(NetworkHandleType nmChannelHandle, const uint8*
  */
 Std_ReturnType CanNm_GetUserData(NetworkHandleType nmChannelHandle, uint8* nmUserDataPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-	if (CanNm_ConfigPtr->UserDataEnabled && ChannelInternal->RxLastPdu != NO_PDU_RECEIVED) {	//[SWS_CanNm_00158]
-		uint8* srcUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduDataPtr);
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (CANNM_USER_DATA() && ChannelInternal->RxLastPdu != NO_PDU_RECEIVED) {	//[SWS_CanNm_00158]
+		uint8* srcUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, CanNm_Internal.Pdus[nmChannelHandle].Rx);
 		uint8 userDataLength = CanNm_Internal_GetUserDataLength(ChannelConf);
 		memcpy(nmUserDataPtr, srcUserData, userDataLength);										//[SWS_CanNm_00160]
-		return E_OK;
+		status = E_OK;
 	} else {
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_Transmit [SWS_CanNm_00331]
@@ -481,8 +1043,8 @@ Std_ReturnType CanNm_GetUserData(NetworkHandleType nmChannelHandle, uint8* nmUse
  */
 Std_ReturnType CanNm_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
 {
-	if (CanNm_ConfigPtr->ComUserDataSupport || CanNm_ConfigPtr->GlobalPnSupport) {				//[SWS_CanNm_00330]
-		return CanIf_Transmit(TxPduId, PduInfoPtr);
+	if (CANNM_COM_USER_DATA() || CANNM_GLOBAL_PN()) {				//[SWS_CanNm_00330]
+		return CANNM_CAN_IF_TRANSMIT(TxPduId, PduInfoPtr);
 	} else {
 		return E_NOT_OK;
 	}
@@ -494,21 +1056,27 @@ Std_ReturnType CanNm_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
  */
 Std_ReturnType CanNm_GetNodeIdentifier(NetworkHandleType nmChannelHandle, uint8*nmNodeIdPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
 	if (ChannelConf->PduNidPosition != CANNM_PDU_OFF) {
 		if (ChannelInternal->RxLastPdu != NO_PDU_RECEIVED) {
-			uint8 *pduNidPtr = ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduDataPtr;//[SWS_CanNm_00132]
+			uint8 *pduNidPtr = CanNm_Internal.Pdus[nmChannelHandle].Rx;									//[SWS_CanNm_00132]
 			pduNidPtr += ChannelConf->PduNidPosition;
 			*nmNodeIdPtr = *pduNidPtr;
-			return E_OK;
+			status = E_OK;
 		} else {
-			return E_NOT_OK;
+			status = E_NOT_OK;
 		}
 	} else {
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_GetNodeIdentifier [SWS_CanNm_00220]
@@ -517,7 +1085,7 @@ Std_ReturnType CanNm_GetNodeIdentifier(NetworkHandleType nmChannelHandle, uint8*
  */
 Std_ReturnType CanNm_GetLocalNodeIdentifier(NetworkHandleType nmChannelHandle, uint8* nmNodeIdPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 
 	*nmNodeIdPtr = ChannelConf->NodeId;	//[SWS_CanNm_00133]
 	return E_OK;
@@ -529,32 +1097,21 @@ Std_ReturnType CanNm_GetLocalNodeIdentifier(NetworkHandleType nmChannelHandle, u
  */
 Std_ReturnType CanNm_RepeatMessageRequest(NetworkHandleType nmChannelHandle)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF) {
-		if (ChannelInternal->State == NM_STATE_READY_SLEEP) {
-			if (ChannelConf->NodeDetectionEnabled) {								//[SWS_CanNm_00112]
-				CanNm_Internal_SetPduCbvBit(ChannelConf, REPEAT_MESSAGE_REQUEST);	//[SWS_CanNm_00113]
-				CanNm_Internal_ReadySleep_to_RepeatMessage(ChannelConf, ChannelInternal);
-				return E_OK;
-			} else {
-				return E_NOT_OK;
-			}
-		} else if (ChannelInternal->State == NM_STATE_NORMAL_OPERATION) {
-			if (ChannelConf->NodeDetectionEnabled) {								//[SWS_CanNm_00120]
-				CanNm_Internal_SetPduCbvBit(ChannelConf, REPEAT_MESSAGE_REQUEST);	//[SWS_CanNm_00121]
-				CanNm_Internal_NormalOperation_to_RepeatMessage(ChannelConf, ChannelInternal);
-				return E_OK;
-			} else {
-				return E_NOT_OK;
-			}
-		} else {
-			return E_NOT_OK;
-		}
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF && ChannelConf->NodeDetectionEnabled) {		//[SWS_CanNm_00112][SWS_CanNm_00120]
+		status = CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_REPEAT_MESSAGE_REQUEST);
 	} else {
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_GetPduData [SWS_CanNm_00222]
@@ -563,20 +1120,27 @@ Std_ReturnType CanNm_RepeatMessageRequest(NetworkHandleType nmChannelHandle)
  */
 Std_ReturnType CanNm_GetPduData(NetworkHandleType nmChannelHandle, uint8* nmPduDataPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-	if (ChannelConf->NodeDetectionEnabled || CanNm_ConfigPtr->UserDataEnabled || ChannelConf->NodeIdEnabled) {	//[SWS_CanNm_00138]
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelConf->NodeDetectionEnabled || CANNM_USER_DATA() || ChannelConf->NodeIdEnabled) {	//[SWS_CanNm_00138]
 		if (ChannelInternal->RxLastPdu != NO_PDU_RECEIVED) {
-			memcpy(nmPduDataPtr, ChannelConf->RxPdu[0]->RxPduRef->SduDataPtr, ChannelConf->RxPdu[0]->RxPduRef->SduLength);
-			return E_OK;
+			memcpy(nmPduDataPtr, CanNm_Internal.Pdus[nmChannelHandle].Rx,
+			 CanNm_Internal_PduCopyLength(ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduLength, CANNM_PDU_MAX_LENGTH));
+			status = E_OK;
 		} else {
-			return E_NOT_OK;
+			status = E_NOT_OK;
 		}
 
 	} else {
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_GetState [SWS_CanNm_00223]
@@ -587,6 +1151,7 @@ Std_ReturnType CanNm_GetState(NetworkHandleType nmChannelHandle, Nm_StateType* n
 {
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
+	CanNm_Internal_LazyInit(nmChannelHandle);
 	*nmStatePtr = ChannelInternal->State;												//[SWS_CanNm_00091]
 	*nmModePtr = ChannelInternal->Mode;
 	return E_OK;    
@@ -607,19 +1172,28 @@ void CanNm_GetVersionInfo(Std_VersionInfoType* versioninfo)
  */
 Std_ReturnType CanNm_RequestBusSynchronization(NetworkHandleType nmChannelHandle)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-    if (!CanNm_ConfigPtr->PassiveModeEnabled) {											//[SWS_CanNm_00130]
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+    if (!CANNM_PASSIVE_MODE()) {											//[SWS_CanNm_00130]
 		if (ChannelInternal->Mode == NM_MODE_NETWORK && ChannelInternal->TxEnabled) {	//[SWS_CanNm_00181][SWS_CanNm_00187]
-			CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal);
-			return E_OK;			
+			if (CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal, FALSE) == CANNM_E_TX_DEFERRED) {
+				ChannelInternal->TxPending = TRUE;
+			}
+			status = E_OK;
 		} else {
-			return E_NOT_OK;
+			status = E_NOT_OK;
 		}
 	} else {
-		return E_NOT_OK;
+		status = E_NOT_OK;
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
+	return status;
 }
 
 /** @brief CanNm_CheckRemoteSleepInd [SWS_CanNm_00227]
@@ -630,6 +1204,7 @@ Std_ReturnType CanNm_CheckRemoteSleepInd(NetworkHandleType nmChannelHandle, bool
 {
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
+	CanNm_Internal_LazyInit(nmChannelHandle);
 	if (ChannelInternal->State != NM_STATE_BUS_SLEEP && ChannelInternal->State != NM_STATE_PREPARE_BUS_SLEEP 
 		&& ChannelInternal->State != NM_STATE_REPEAT_MESSAGE) {							//[SWS_CanNm_00154]
 		*nmRemoteSleepIndPtr = ChannelInternal->RemoteSleepInd;
@@ -645,16 +1220,44 @@ Std_ReturnType CanNm_CheckRemoteSleepInd(NetworkHandleType nmChannelHandle, bool
  */
 Std_ReturnType CanNm_SetSleepReadyBit(NetworkHandleType nmChannelHandle,boolean nmSleepReadyBit)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[nmChannelHandle];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(nmChannelHandle);
     CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF && CanNm_ConfigPtr->CoordinationSyncSupport) {	//[SWS_CanNm_00342]
-		CanNm_Internal_SetPduCbvBit(ChannelConf, NM_COORDINATOR_SLEEP_READY_BIT);
-		CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal);
-		return E_OK;
+	Std_ReturnType status = E_OK;
+
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF && CANNM_COORDINATOR_SYNC()) {	//[SWS_CanNm_00342]
+		if (nmSleepReadyBit) {
+			CanNm_Internal_SetPduCbvBit(ChannelConf, ChannelInternal, NM_COORDINATOR_SLEEP_READY_BIT);
+		} else {
+			CanNm_Internal_ClearPduCbvBit(ChannelConf, ChannelInternal, NM_COORDINATOR_SLEEP_READY_BIT);
+		}
+		if (CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal, FALSE) == CANNM_E_TX_DEFERRED) {
+			ChannelInternal->TxPending = TRUE;
+		}
+		status = E_OK;
 	} else {
+		status = E_NOT_OK;
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
+	return status;
+}
+
+/** @brief CanNm_GetCoordinatorSleepReady
+ * 
+ * Tells whether every channel of a coordination cluster is ready to sleep, i.e. in Ready Sleep, Prepare Bus-Sleep or
+ * Bus-Sleep state or with remote sleep indicated. Answered from the packed readiness bitmaps, one word per 32 channels.
+ */
+Std_ReturnType CanNm_GetCoordinatorSleepReady(uint8 coordClusterIndex, boolean* sleepReadyPtr)
+{
+	if (CanNm_Internal.InitStatus != CANNM_INIT || sleepReadyPtr == NULL || coordClusterIndex >= CANNM_COORD_CLUSTER_COUNT ||
+	 (CanNm_Internal.SleepReady.ClustersUsed & (1UL << coordClusterIndex)) == 0) {
 		return E_NOT_OK;
 	}
+	*sleepReadyPtr = CanNm_Internal_IsClusterSleepReady(coordClusterIndex);
+	return E_OK;
 }
 
 /** @brief CanNm_TxConfirmation [SWS_CanNm_00228]
@@ -663,14 +1266,20 @@ Std_ReturnType CanNm_SetSleepReadyBit(NetworkHandleType nmChannelHandle,boolean
  */
 void CanNm_TxConfirmation(PduIdType TxPduId, Std_ReturnType result)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[TxPduId];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(TxPduId);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[TxPduId];
 
+	CanNm_Internal_LazyInit(TxPduId);
+	CanNm_Internal_TxDeadlineClear(TxPduId);
 	if (result == E_OK) {
-		CanNm_Internal_NetworkMode_to_NetworkMode(ChannelConf, ChannelInternal);			//[SWS_CanNm_00099]
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, TxPduId);
+		(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_TX_CONFIRMATION);	//[SWS_CanNm_00099]
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, TxPduId);
+		CanNm_Internal_FlushCallouts(TxPduId);
 	}
-	if (CanNm_ConfigPtr->ComUserDataSupport) {
-		PduR_CanNmRxIndication(TxPduId, ChannelConf->TxPdu->TxPduRef); 						//[SWS_CanNm_00329]
+	if (CANNM_COM_USER_DATA()) {
+		PduInfoType pduInfo = { .SduDataPtr = CanNm_Internal.Pdus[TxPduId].Tx, .SduLength = ChannelConf->TxPdu->TxPduRef->SduLength };
+		CANNM_CALLBACK(PduRRxIndication, TxPduId, &pduInfo);										//[SWS_CanNm_00329]
 	}
 }
 
@@ -680,54 +1289,48 @@ void CanNm_TxConfirmation(PduIdType TxPduId, Std_ReturnType result)
  */
 void CanNm_RxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[RxPduId];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[RxPduId];
+	NetworkHandleType channel = (NetworkHandleType)RxPduId;
+	if (CanNm_ConfigPtr->RxPduChannelMap != NULL) {
+		channel = (RxPduId < CanNm_ConfigPtr->RxPduCount) ? CanNm_ConfigPtr->RxPduChannelMap[RxPduId] : CANNM_INVALID_CHANNEL;
+		if (channel >= CANNM_CHANNEL_COUNT) {
+			return;
+		}
+	}
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
 
+	CanNm_Internal_LazyInit(channel);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	if (ChannelInternal->Mode == NM_MODE_BUS_SLEEP) {
+		CANNM_LATENCY_START(channel, CANNM_LATENCY_RX_TO_NETWORK_START);
+	}
 	ChannelInternal->RxLastPdu = (ChannelInternal->RxLastPdu + 1) % (CANNM_RXPDU_MAX_COUNT);
-	memcpy(ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduDataPtr, PduInfoPtr->SduDataPtr,
-	 ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduLength);					//[SWS_CanNm_00035]
+	memcpy(CanNm_Internal.Pdus[channel].Rx, PduInfoPtr->SduDataPtr, CanNm_Internal_PduCopyLength(
+	 ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduLength, PduInfoPtr->SduLength));	//[SWS_CanNm_00035]
+
+	/* A frame too short for the CBV carries no control bits */
+	uint8 cbv = (ChannelConf->PduCbvPosition != CANNM_PDU_OFF && PduInfoPtr->SduLength > ChannelConf->PduCbvPosition) ?
+	 PduInfoPtr->SduDataPtr[ChannelConf->PduCbvPosition] : 0;
+
+	CANNM_STATISTICS_COUNT(channel, RxCount);
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_RX, cbv, RxPduId);
 
 	boolean repeatMessageBitIndication = FALSE;
-	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF && ChannelConf->NodeDetectionEnabled) {
-		uint8 cbv = PduInfoPtr->SduDataPtr[ChannelConf->PduCbvPosition];
+	if (ChannelConf->NodeDetectionEnabled) {
 		repeatMessageBitIndication = cbv & (1 << REPEAT_MESSAGE_REQUEST);
 	}
 
-	if (ChannelInternal->Mode == NM_MODE_BUS_SLEEP) {
-		CanNm_Internal_BusSleep_to_BusSleep(ChannelConf, ChannelInternal);
-		Nm_NetworkStartIndication(RxPduId);													//[SWS_CanNm_00127]
-	} else if (ChannelInternal->Mode == NM_MODE_PREPARE_BUS_SLEEP) {
-		CanNm_Internal_PrepareBusSleep_to_RepeatMessage(ChannelConf, ChannelInternal);		//[SWS_CanNm_00124][SWS_CanNm_00315]
-	} else if (ChannelInternal->Mode == NM_MODE_NETWORK) {
-		CanNm_Internal_NetworkMode_to_NetworkMode(ChannelConf, ChannelInternal);  			//[SWS_CanNm_00098]
-		if (repeatMessageBitIndication) {													//[SWS_CanNm_00119]
-			if (ChannelInternal->State == NM_STATE_READY_SLEEP) {
-				CanNm_Internal_ReadySleep_to_RepeatMessage(ChannelConf, ChannelInternal);	//[SWS_CanNm_00111]
-			} else if (ChannelInternal->State == NM_STATE_NORMAL_OPERATION) {
-				CanNm_Internal_NormalOperation_to_RepeatMessage(ChannelConf, ChannelInternal);
-			} else {
-				//Nothing to be done
-			}
-		}
-		if (ChannelInternal->RemoteSleepInd) {
-			ChannelInternal->RemoteSleepInd = FALSE;
-			Nm_RemoteSleepCancellation(RxPduId);											//[SWS_CanNm_00151]
-		} else if (ChannelInternal->RemoteSleepIndEnabled) {
-			CanNm_Internal_TimerStart(&ChannelInternal->RemoteSleepIndTimer, ChannelConf->RemoteSleepIndTime);
-		} else {
-			//Nothing to be done
-		}
-	} else {
-		//Nothing to be done	
-	}
+	(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal,
+	 repeatMessageBitIndication ? CANNM_EVENT_RX_REPEAT_MESSAGE : CANNM_EVENT_RX);			//[SWS_CanNm_00098][SWS_CanNm_00119]
 
 	if (ChannelInternal->BusLoadReduction) {
-		CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgReducedTime);	//[SWS_CanNm_00069]
+		CanNm_Internal_TimerStartTicks(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, ChannelInternal->ReducedCycleTicks);	//[SWS_CanNm_00069]
 	}
-
-	if (CanNm_ConfigPtr->PduRxIndicationEnabled) {
-		Nm_PduRxIndication(RxPduId);																	//[SWS_CanNm_00037]
+	if (CANNM_PDU_RX_INDICATION()) {
+		CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_PDU_RX, 0, 0);								//[SWS_CanNm_00037]
 	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	CanNm_Internal_FlushCallouts(channel);
 }
 
 /** @brief CanNm_ConfirmPnAvailability [SWS_CanNm_00344]
@@ -739,7 +1342,8 @@ void CanNm_ConfirmPnAvailability(NetworkHandleType nmChannelHandle)
 {
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 
-    if (CanNm_ConfigPtr->GlobalPnSupport) {
+	CanNm_Internal_LazyInit(nmChannelHandle);
+    if (CANNM_GLOBAL_PN()) {
 		ChannelInternal->NmPduFilterAlgorithm = TRUE;
 	}
 }
@@ -754,11 +1358,15 @@ void CanNm_ConfirmPnAvailability(NetworkHandleType nmChannelHandle)
  */
 Std_ReturnType CanNm_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr)
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[TxPduId];
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(TxPduId);
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[TxPduId];
 
+	CanNm_Internal_LazyInit(TxPduId);
 	if (ChannelConf->TxPdu->TxPduRef->SduLength <= PduInfoPtr->SduLength) {
-		memcpy(PduInfoPtr->SduDataPtr, ChannelConf->TxPdu->TxPduRef->SduDataPtr, ChannelConf->TxPdu->TxPduRef->SduLength);	//[SWS_CanNm_00351]
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, TxPduId);
+		memcpy(PduInfoPtr->SduDataPtr, CanNm_Internal.Pdus[TxPduId].Tx,
+		 CanNm_Internal_PduCopyLength(ChannelConf->TxPdu->TxPduRef->SduLength, PduInfoPtr->SduLength));		//[SWS_CanNm_00351]
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, TxPduId);
 		PduInfoPtr->SduLength = ChannelConf->TxPdu->TxPduRef->SduLength;
 		return E_OK;
 	} else {
@@ -772,418 +1380,2242 @@ Std_ReturnType CanNm_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr)
  */
 void CanNm_MainFunction(void)
 {
-	for (uint8 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
-		CanNm_Internal_TimerTick(&CanNm_Internal.Channels[channel].TimeoutTimer, channel, CanNm_ConfigPtr->MainFunctionPeriod);			//[SWS_CanNm_00089]
-		CanNm_Internal_TimerTick(&CanNm_Internal.Channels[channel].MessageCycleTimer, channel, CanNm_ConfigPtr->MainFunctionPeriod);
-		CanNm_Internal_TimerTick(&CanNm_Internal.Channels[channel].RepeatMessageTimer, channel, CanNm_ConfigPtr->MainFunctionPeriod);
-		CanNm_Internal_TimerTick(&CanNm_Internal.Channels[channel].WaitBusSleepTimer, channel, CanNm_ConfigPtr->MainFunctionPeriod);
-		CanNm_Internal_TimerTick(&CanNm_Internal.Channels[channel].RepeatMessageTimer, channel, CanNm_ConfigPtr->MainFunctionPeriod);
+	CanNm_Internal.MainFunctionTicks++;
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		if (ChannelInternal->TimersStarted != 0) {
+			CanNm_Internal_TimerTick(ChannelInternal, CANNM_TIMER_TIMEOUT, channel);			//[SWS_CanNm_00089]
+			CanNm_Internal_TimerTick(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, channel);
+			CanNm_Internal_TimerTick(ChannelInternal, CANNM_TIMER_REPEAT_MESSAGE, channel);
+			CanNm_Internal_TimerTick(ChannelInternal, CANNM_TIMER_WAIT_BUS_SLEEP, channel);
+			CanNm_Internal_TimerTick(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND, channel);
+		}
+		if (ChannelInternal->TxPending) {
+			(void)CanNm_Internal_TransmitMessage(CanNm_Internal_GetChannelConf(channel), ChannelInternal, FALSE);
+		}
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+		if (ChannelInternal->RetainedConf != NULL && CanNm_Internal_ReconfigureSafe(ChannelInternal, channel)) {
+			CanNm_Internal_AdoptConfig(ChannelInternal, channel);
+		}
+#endif
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		CanNm_Internal_FlushCallouts(channel);
 	}
+	CanNm_Internal_TxDeadlinesExpire();
+	CanNm_Internal_CheckClusters();
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		if (__atomic_load_n(&CanNm_Internal.Notifications[channel].Count, __ATOMIC_RELAXED) != 0) {
+			CanNm_Internal_FlushNotifications(channel);
+		}
+	}
+#endif
 }
 
-/*====================================================================================================================*\
-    Local functions (static) code
-\*====================================================================================================================*/
-
-/*******************/
-/* Timer functions */
-/*******************/
-static inline void CanNm_Internal_TimerStart( CanNm_Timer* Timer, uint32 timeoutValue )
+#if (CANNM_VIRTUAL_CLOCK_ENABLED == STD_ON)
+/** @brief CanNm_GetTicksToNextExpiry
+ * 
+ * Number of CanNm_MainFunction calls until the next timer of any channel expires, CANNM_NO_TIMER_EXPIRY when all
+ * timers are stopped.
+ */
+uint32 CanNm_GetTicksToNextExpiry(void)
 {
-	Timer->State = CANNM_TIMER_STARTED;
-	Timer->TimeLeft = timeoutValue;	//[SWS_CanNm_00206]
-}
+	uint32 ticksLeft = CANNM_NO_TIMER_EXPIRY;
 
-static inline void CanNm_Internal_TimerResume( CanNm_Timer* Timer )
-{
-	Timer->State = CANNM_TIMER_STARTED;
-}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		const CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
 
-static inline void CanNm_Internal_TimerStop( CanNm_Timer* Timer )
-{
-	Timer->State = CANNM_TIMER_STOPPED;
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		for (CanNm_Internal_TimerType timer = 0; timer < CANNM_TIMER_COUNT; timer++) {
+			uint32 timerTicksLeft = CanNm_Internal_TimerTicksLeft(ChannelInternal, timer);
+			if (timerTicksLeft < ticksLeft) {
+				ticksLeft = timerTicksLeft;
+			}
+		}
+		if (ChannelInternal->TxPending) {
+			ticksLeft = 1;													//Retried by the next main function
+		}
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	}
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	if (CanNm_Internal.TxSupervision.Count != 0) {
+		sint32 deadlineTicksLeft = (sint32)(CanNm_Internal.TxSupervision.Heap[0].Deadline - CanNm_Internal.MainFunctionTicks);
+		uint32 timerTicksLeft = (deadlineTicksLeft <= 0) ? 1 : (uint32)deadlineTicksLeft;
+		if (timerTicksLeft < ticksLeft) {
+			ticksLeft = timerTicksLeft;
+		}
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	return ticksLeft;
 }
 
-static inline void CanNm_Internal_TimerReset( CanNm_Timer* Timer, uint32 timeoutValue )
+/** @brief CanNm_FastForward
+ * 
+ * Advance the module by a number of main function periods. Periods without a timer expiry are skipped and only the
+ * periods with one run CanNm_MainFunction, so the result is identical to calling CanNm_MainFunction ticks times.
+ */
+void CanNm_FastForward(uint32 ticks)
 {
-	Timer->State = CANNM_TIMER_STOPPED;
-	Timer->TimeLeft = timeoutValue;
-}
+	while (ticks > 0) {
+		uint32 ticksToExpiry = CanNm_GetTicksToNextExpiry();
 
-static inline void CanNm_Internal_TimerTick( CanNm_Timer* Timer, const uint8 channel, const float32 period )
-{
-	if (Timer->State == CANNM_TIMER_STARTED) {
-		if (period >= Timer->TimeLeft) {
-			CanNm_Internal_TimerStop(Timer);
-			Timer->ExpiredCallback(Timer, channel);
-		} else {
-			Timer->TimeLeft -= period;
+		if (ticksToExpiry > ticks) {
+			CanNm_Internal.MainFunctionTicks += ticks;		//Nothing expires within the remaining periods
+			break;
 		}
+		CanNm_Internal.MainFunctionTicks += ticksToExpiry - 1;
+		CanNm_MainFunction();
+		ticks -= ticksToExpiry;
 	}
-	else {
+}
+#endif
+
+/** @brief CanNm_GetMainFunctionTicks
+ * 
+ * Number of CanNm_MainFunction calls since start-up, the default time base of the tracer.
+ */
+uint32 CanNm_GetMainFunctionTicks(void)
+{
+	return CanNm_Internal.MainFunctionTicks;
+}
+
+/** @brief CanNm_SaveState
+ * 
+ * Serialize the runtime state of all channels into a versioned, CRC protected blob: main function ticks, states,
+ * modes, timers, pending transmit confirmations, token buckets, NM PDU buffers and queued notifications. Statistics,
+ * trace and latency records are not part of it. With stateBufferPtr NULL or *stateLengthPtr too small E_NOT_OK is
+ * returned, with the length needed in *stateLengthPtr either way.
+ */
+Std_ReturnType CanNm_SaveState(uint8* stateBufferPtr, uint32* stateLengthPtr)
+{
+	CanNm_Internal_StateWriterType writer = { .Buffer = stateBufferPtr, .Size = 0, .Position = 0 };
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+
+	if (CanNm_Internal.InitStatus != CANNM_INIT || stateLengthPtr == NULL) {
+		return E_NOT_OK;
+	}
+	writer.Size = (stateBufferPtr != NULL) ? *stateLengthPtr : 0;
+	CanNm_Internal_StatePut(&writer, CANNM_STATE_MAGIC, 4);
+	CanNm_Internal_StatePut(&writer, CANNM_STATE_VERSION, 2);
+	CanNm_Internal_StatePut(&writer, CANNM_CHANNEL_COUNT, 2);
+	CanNm_Internal_StatePut(&writer, CANNM_CONTROLLER_COUNT, 2);
+	CanNm_Internal_StatePut(&writer, 0, 4);													//Length, written last
+	CanNm_Internal_StatePut(&writer, CanNm_Internal.MainFunctionTicks, 4);
+	CanNm_Internal_StatePut(&writer, CanNm_Internal.SleepReady.ClustersReady, 4);
+	CanNm_Internal_StatePut(&writer, CanNm_Internal.SleepReady.Changed, 1);
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	CanNm_Internal_StatePut(&writer, Supervision->Count, 2);
+	for (uint32 index = 0; index < Supervision->Count; index++) {
+		CanNm_Internal_StatePut(&writer, Supervision->Heap[index].Channel, 2);
+		CanNm_Internal_StatePut(&writer, Supervision->Heap[index].Deadline, 4);
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	for (uint8 controller = 0; controller < CANNM_CONTROLLER_COUNT; controller++) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+		CanNm_Internal_StatePut(&writer, CanNm_Internal.TxLimiters[controller].Tokens, 4);
+		CanNm_Internal_StatePut(&writer, CanNm_Internal.TxLimiters[controller].LastTick, 4);
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+	}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_Internal_SaveChannel(&writer, channel);
+	}
+
+	uint32 length = writer.Position + 4;
+	if (stateBufferPtr == NULL || length > *stateLengthPtr) {
+		*stateLengthPtr = length;
+		return E_NOT_OK;
+	}
+	writer.Position = 10;
+	CanNm_Internal_StatePut(&writer, length, 4);
+	writer.Position = length - 4;
+	CanNm_Internal_StatePut(&writer, CanNm_Internal_StateCrc(stateBufferPtr, length - 4), 4);
+	*stateLengthPtr = length;
+	return E_OK;
+}
+
+/** @brief CanNm_RestoreState
+ * 
+ * Load a blob written by CanNm_SaveState after CanNm_Init with the same channel and controller counts and PDU
+ * lengths. The blob is checked completely before anything is changed, a rejected blob leaves the module as it was.
+ * No notifications are given for the restored states.
+ */
+Std_ReturnType CanNm_RestoreState(const uint8* stateBufferPtr, uint32 stateLength)
+{
+	if (CanNm_Internal.InitStatus != CANNM_INIT || stateBufferPtr == NULL || stateLength < 4 ||
+	 CanNm_Internal_StateCrc(stateBufferPtr, stateLength - 4) != ((uint32)stateBufferPtr[stateLength - 4] |
+	 ((uint32)stateBufferPtr[stateLength - 3] << 8) | ((uint32)stateBufferPtr[stateLength - 2] << 16) |
+	 ((uint32)stateBufferPtr[stateLength - 1] << 24))) {
+		return E_NOT_OK;
+	}
+	if (!CanNm_Internal_RestoreState(stateBufferPtr, stateLength, FALSE)) {
+		return E_NOT_OK;
+	}
+	(void)CanNm_Internal_RestoreState(stateBufferPtr, stateLength, TRUE);
+	return E_OK;
+}
+
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+/** @brief CanNm_LoadConfigImage
+ * 
+ * Check a configuration image (CanNm_ImageHeaderType) in place and return the configuration set for CanNm_Init in
+ * *configPtrPtr. The image is only read, e.g. from a read-only mmap of CanNm_Cfg.bin shared by many processes, and
+ * has to stay mapped while the set is used. Rx PDU ids, RxPduId map, controllers and PN filter mask are used in place,
+ * the channels are bound into the one set CanNm keeps for images. Fails without changes for an image not matching the
+ * build (counts, PDU buffer size, byte order, layout) and while the module runs on the set bound before.
+ */
+Std_ReturnType CanNm_LoadConfigImage(const uint8* imagePtr, uint32 imageLength, const CanNm_ConfigType** configPtrPtr)
+{
+	if (configPtrPtr == NULL || !CanNm_Internal_ImageValid(imagePtr, imageLength) ||
+	 (CanNm_Internal.InitStatus == CANNM_INIT && CanNm_ConfigPtr == &CanNm_Internal_Image.Config)) {
+		return E_NOT_OK;
+	}
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+	if (CanNm_Internal.InitStatus == CANNM_INIT && CanNm_ReconfigurePending()) {		//Channels may retain the bound set
+		return E_NOT_OK;
+	}
+#endif
+	CanNm_Internal_ImageBind(imagePtr);
+	*configPtrPtr = &CanNm_Internal_Image.Config;
+	return E_OK;
+}
+#endif
+
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+/** @brief CanNm_Reconfigure
+ * 
+ * Publish another configuration set without CanNm_Init, e.g. new timing parameters or PN information. Channels in
+ * Bus-Sleep Mode take it over at once, active channels keep their configuration until their next safe point in
+ * CanNm_MainFunction, when no immediate transmission is left and no NM PDU waits for its confirmation. Token buckets,
+ * wake-up staggering and PN information of the new set apply at once. Fails without changes before CanNm_Init and
+ * for a set that differs in more than parameters (see CanNm_Internal_ReconfigureValid). Readers never lock for the
+ * configuration, the previous set has to stay valid until CanNm_ReconfigurePending returns FALSE. Not reentrant.
+ */
+Std_ReturnType CanNm_Reconfigure(const CanNm_ConfigType* cannmConfigPtr)
+{
+	const CanNm_ConfigType* PreviousConfig = CanNm_ConfigPtr;
+
+	if (CanNm_Internal.InitStatus != CANNM_INIT || cannmConfigPtr == NULL ||
+	 !CanNm_Internal_ReconfigureValid(PreviousConfig, cannmConfigPtr)) {
+		return E_NOT_OK;
+	}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		if (ChannelInternal->RetainedConf == NULL) {								//Still on an older set otherwise
+			__atomic_store_n(&ChannelInternal->RetainedConf, PreviousConfig->ChannelConfig[channel], __ATOMIC_RELAXED);
+			__atomic_fetch_add(&CanNm_Internal.ChannelsRetainingConfig, 1, __ATOMIC_RELAXED);
+		}
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	}
+	__atomic_store_n(&CanNm_ConfigPtr, cannmConfigPtr, __ATOMIC_RELEASE);
+
+	for (uint8 controller = 0; controller < CANNM_CONTROLLER_COUNT; controller++) {
+		CanNm_Internal_TxLimiterType* limiter = &CanNm_Internal.TxLimiters[controller];
+
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+		CanNm_Internal_TxLimiterConfigure(limiter, controller);
+		if (limiter->Tokens > limiter->Capacity) {
+			limiter->Tokens = limiter->Capacity;
+		}
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+	}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		if (ChannelInternal->RetainedConf != NULL && ChannelInternal->Mode == NM_MODE_BUS_SLEEP) {	//Or not set up
+			CanNm_Internal_AdoptConfig(ChannelInternal, channel);
+		}
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	}
+	return E_OK;
+}
+
+/** @brief CanNm_ReconfigurePending
+ * 
+ * TRUE while a channel still runs on a configuration set replaced by CanNm_Reconfigure.
+ */
+boolean CanNm_ReconfigurePending(void)
+{
+	return __atomic_load_n(&CanNm_Internal.ChannelsRetainingConfig, __ATOMIC_ACQUIRE) != 0;
+}
+#endif
+
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+/** @brief CanNm_GetStatistics
+ * 
+ * Copy the runtime counters of a channel. Lock-free, the counters of an active channel may advance while they are
+ * copied.
+ */
+Std_ReturnType CanNm_GetStatistics(NetworkHandleType nmChannelHandle, CanNm_StatisticsType* statisticsPtr)
+{
+	const CanNm_Internal_StatisticsType* statistics = &CanNm_Internal.Statistics[nmChannelHandle];
+	const CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	Nm_StateType state;
+	uint32 enteredTick;
+
+	if (CanNm_Internal.InitStatus != CANNM_INIT) {
+		return E_NOT_OK;
+	}
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	state = __atomic_load_n(&ChannelInternal->State, __ATOMIC_RELAXED);
+	enteredTick = __atomic_load_n(&statistics->StateEnteredTick, __ATOMIC_RELAXED);
+	statisticsPtr->RxCount = __atomic_load_n(&statistics->RxCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxCount = __atomic_load_n(&statistics->TxCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxFailedCount = __atomic_load_n(&statistics->TxFailedCount, __ATOMIC_RELAXED);
+	statisticsPtr->ImmediateTxCount = __atomic_load_n(&statistics->ImmediateTxCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxRetryCount = __atomic_load_n(&statistics->TxRetryCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxRetryGiveUpCount = __atomic_load_n(&statistics->TxRetryGiveUpCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxDeferredCount = __atomic_load_n(&statistics->TxDeferredCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxTimeoutCount = __atomic_load_n(&statistics->TxTimeoutCount, __ATOMIC_RELAXED);
+	statisticsPtr->TxConfirmationTimeoutCount = __atomic_load_n(&statistics->TxConfirmationTimeoutCount, __ATOMIC_RELAXED);
+	statisticsPtr->RemoteSleepIndCount = __atomic_load_n(&statistics->RemoteSleepIndCount, __ATOMIC_RELAXED);
+	statisticsPtr->NotificationOverflowCount = __atomic_load_n(&statistics->NotificationOverflowCount, __ATOMIC_RELAXED);
+	for (uint8 stateIndex = 0; stateIndex <= NM_STATE_SYNCHRONIZE; stateIndex++) {
+		uint32 ticks = __atomic_load_n(&statistics->StateTicks[stateIndex], __ATOMIC_RELAXED);
+		if (stateIndex == state) {
+			ticks += CanNm_Internal.MainFunctionTicks - enteredTick;	//Time in the current state so far
+		}
+		statisticsPtr->StateTime[stateIndex] = (float32)ticks * CanNm_ConfigPtr->MainFunctionPeriod;
+	}
+	return E_OK;
+}
+
+/** @brief CanNm_ResetStatistics
+ * 
+ * Clear the runtime counters of a channel.
+ */
+Std_ReturnType CanNm_ResetStatistics(NetworkHandleType nmChannelHandle)
+{
+	if (CanNm_Internal.InitStatus != CANNM_INIT) {
+		return E_NOT_OK;
+	}
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	CanNm_Internal_ResetStatistics(nmChannelHandle);
+	return E_OK;
+}
+
+/** @brief CanNm_GetObservedBusLoad
+ * 
+ * NM frame and bit rate of a channel measured by the received and transmitted NM PDUs since initialization or the
+ * last CanNm_ResetStatistics call.
+ */
+Std_ReturnType CanNm_GetObservedBusLoad(NetworkHandleType nmChannelHandle, CanNm_BusLoadType* busLoadPtr)
+{
+	CanNm_StatisticsType statistics;
+	float32 elapsedTime = 0.0f;
+
+	if (CanNm_GetStatistics(nmChannelHandle, &statistics) != E_OK) {
+		return E_NOT_OK;
+	}
+	for (uint8 stateIndex = 0; stateIndex <= NM_STATE_SYNCHRONIZE; stateIndex++) {
+		elapsedTime += statistics.StateTime[stateIndex];
+	}
+	uint32 frameBits = CanNm_Internal_GetFrameBits(CanNm_Internal_GetChannelConf(nmChannelHandle)->TxPdu->TxPduRef->SduLength);
+	busLoadPtr->FramesPerSecond = (elapsedTime > 0.0f) ?
+	 ((float32)(statistics.RxCount + statistics.TxCount) * 1000.0f / elapsedTime) : 0.0f;
+	busLoadPtr->BitsPerSecond = busLoadPtr->FramesPerSecond * (float32)frameBits;
+	return E_OK;
+}
+#endif
+
+/** @brief CanNm_EstimateBusLoad
+ * 
+ * Expected NM frame and bit rate of a bus of nodeCount nodes sharing the configuration of a channel, without
+ * initialization. Startup assumes all nodes request the network at once and send their immediate transmissions,
+ * steady state all nodes in Normal Operation State. With bus load reduction the reduced cycles are assumed to be
+ * distinct for configured MsgReducedTime values and derived from consecutive node identifiers otherwise.
+ */
+Std_ReturnType CanNm_EstimateBusLoad(const CanNm_ConfigType* cannmConfigPtr, NetworkHandleType nmChannelHandle,
+ uint16 nodeCount, CanNm_BusLoadEstimateType* estimatePtr)
+{
+	if (cannmConfigPtr == NULL || nmChannelHandle >= CANNM_CHANNEL_COUNT || nodeCount == 0 || estimatePtr == NULL ||
+	 cannmConfigPtr->ChannelConfig[nmChannelHandle] == NULL || cannmConfigPtr->MainFunctionPeriod <= 0.0f) {
+		return E_NOT_OK;
+	}
+	const CanNm_ChannelType* ChannelConf = cannmConfigPtr->ChannelConfig[nmChannelHandle];
+	float32 period = cannmConfigPtr->MainFunctionPeriod;
+	float32 cycleTime = (float32)CanNm_Internal_TimeToPeriods(ChannelConf->MsgCycleTime, period) * period;
+	float32 startupTime = cycleTime;
+	float32 frameBits = (float32)CanNm_Internal_GetFrameBits(ChannelConf->TxPdu->TxPduRef->SduLength);
+
+	if (ChannelConf->ImmediateNmTransmissions > 1 && ChannelConf->ImmediateNmCycleTime > 0.0f) {
+		startupTime = (float32)CanNm_Internal_TimeToPeriods(ChannelConf->ImmediateNmCycleTime, period) * period;
+	}
+	estimatePtr->Startup.FramesPerSecond = (float32)nodeCount * 1000.0f / startupTime;
+	estimatePtr->Steady.FramesPerSecond = (float32)nodeCount * 1000.0f / cycleTime;
+
+	if (CANNM_BUS_LOAD_REDUCTION(ChannelConf) && nodeCount > 1) {
+		uint32 slots = CanNm_Internal_GetReducedCycleSlots(ChannelConf, period);
+		uint32 reducedTicks = (slots == 0) ? CanNm_Internal_GetReducedCycleTicks(ChannelConf, period) :
+		 CanNm_Internal_TimeToPeriods(ChannelConf->MsgCycleTime, period) / 2 + 1;		//Lowest derived slot
+		uint32 senders = (slots == 0) ? 1 : ((nodeCount + slots - 1) / slots);		//Nodes sharing the lowest slot
+		float32 reducedRate = (float32)senders * 1000.0f / ((float32)reducedTicks * period);
+
+		if (reducedRate < estimatePtr->Steady.FramesPerSecond) {
+			estimatePtr->Steady.FramesPerSecond = reducedRate;
+		}
+	}
+	estimatePtr->Startup.BitsPerSecond = estimatePtr->Startup.FramesPerSecond * frameBits;
+	estimatePtr->Steady.BitsPerSecond = estimatePtr->Steady.FramesPerSecond * frameBits;
+	return E_OK;
+}
+
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+/** @brief CanNm_GetLatencyHistogram
+ * 
+ * Copy the latency histogram of one path of a channel. Lock-free, a measurement completing meanwhile may be
+ * partially included.
+ */
+Std_ReturnType CanNm_GetLatencyHistogram(NetworkHandleType nmChannelHandle, CanNm_LatencyPathType path,
+ CanNm_LatencyHistogramType* histogramPtr)
+{
+	const CanNm_LatencyHistogramType* histogram;
+
+	if (CanNm_Internal.InitStatus != CANNM_INIT || path >= CANNM_LATENCY_PATH_COUNT) {
+		return E_NOT_OK;
+	}
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	histogram = &CanNm_Internal.Latency[nmChannelHandle].Histograms[path];
+#if (CANNM_LATENCY_CLOCK == CANNM_LATENCY_CLOCK_MONOTONIC)
+	histogramPtr->TimeUnitNs = 1;
+#else
+	histogramPtr->TimeUnitNs = (uint32)(CanNm_ConfigPtr->MainFunctionPeriod * 1000000.0f);
+#endif
+	histogramPtr->Count = __atomic_load_n(&histogram->Count, __ATOMIC_RELAXED);
+	histogramPtr->Sum = __atomic_load_n(&histogram->Sum, __ATOMIC_RELAXED);
+	histogramPtr->Min = __atomic_load_n(&histogram->Min, __ATOMIC_RELAXED);
+	histogramPtr->Max = __atomic_load_n(&histogram->Max, __ATOMIC_RELAXED);
+	for (uint8 bucket = 0; bucket < CANNM_LATENCY_BUCKET_COUNT; bucket++) {
+		histogramPtr->Buckets[bucket] = __atomic_load_n(&histogram->Buckets[bucket], __ATOMIC_RELAXED);
+	}
+	return E_OK;
+}
+
+/** @brief CanNm_ResetLatencyHistograms
+ * 
+ * Clear the latency histograms of all paths of a channel. Running measurements are kept.
+ */
+Std_ReturnType CanNm_ResetLatencyHistograms(NetworkHandleType nmChannelHandle)
+{
+	if (CanNm_Internal.InitStatus != CANNM_INIT) {
+		return E_NOT_OK;
+	}
+	CanNm_Internal_LazyInit(nmChannelHandle);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	memset(CanNm_Internal.Latency[nmChannelHandle].Histograms, 0, sizeof(CanNm_Internal.Latency[nmChannelHandle].Histograms));
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, nmChannelHandle);
+	return E_OK;
+}
+#endif
+
+#if (CANNM_TRACE_ENABLED == STD_ON)
+/** @brief CanNm_TraceRead
+ * 
+ * Copy trace records of a channel written since *cursorPtr and advance the cursor. Records overwritten before
+ * they could be read are skipped, which shows as a gap in the record sequence numbers; after an overrun the newest
+ * CANNM_TRACE_RING_SIZE - 1 records are left, the slot of the next record may be in writing. Lock-free, may be called
+ * from any context while the channel keeps running.
+ */
+uint32 CanNm_TraceRead(NetworkHandleType nmChannelHandle, uint32* cursorPtr, CanNm_TraceRecordType* recordsPtr, uint32 maxRecords)
+{
+	const CanNm_Internal_TraceRingType* ring = &CanNm_Internal.TraceRings[nmChannelHandle];
+	uint32 head = __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE);
+	uint32 cursor = *cursorPtr;
+	uint32 count;
+
+	if ((head - cursor) >= CANNM_TRACE_RING_SIZE) {
+		cursor = head - CANNM_TRACE_RING_SIZE + 1;			//The slot of record head may be in writing
+	}
+	count = head - cursor;
+	if (count > maxRecords) {
+		count = maxRecords;
+	}
+	for (uint32 record = 0; record < count; record++) {
+		recordsPtr[record] = ring->Records[(cursor + record) & (CANNM_TRACE_RING_SIZE - 1)];
+	}
+
+	/* Drop records the writer may have overwritten while they were copied, or be overwriting for record head */
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	head = __atomic_load_n(&ring->Head, __ATOMIC_RELAXED);
+	if ((head - cursor) >= CANNM_TRACE_RING_SIZE) {
+		uint32 lost = (head - cursor) - CANNM_TRACE_RING_SIZE + 1;
+		if (lost >= count) {
+			*cursorPtr = head - CANNM_TRACE_RING_SIZE + 1;
+			return 0;
+		}
+		memmove(recordsPtr, &recordsPtr[lost], (count - lost) * sizeof(CanNm_TraceRecordType));
+		count -= lost;
+		cursor += lost;
+	}
+	*cursorPtr = cursor + count;
+	return count;
+}
+#endif
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+
+/*******************/
+/* Timer functions */
+/*******************/
+static inline void CanNm_Internal_TimerStart( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 timeoutValue )
+{
+	CanNm_Internal_TimerStartTicks(ChannelInternal, Timer, CanNm_Internal_TimeToTicks(timeoutValue));	//[SWS_CanNm_00206]
+}
+
+static inline void CanNm_Internal_TimerStartTicks( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 ticks )
+{
+	ChannelInternal->TimersStarted |= CANNM_TIMER_BIT(Timer);
+	ChannelInternal->Deadlines[Timer] = CanNm_Internal.MainFunctionTicks + ticks;
+}
+
+static inline void CanNm_Internal_TimerResume( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer )
+{
+	if (!CanNm_Internal_TimerIsStarted(ChannelInternal, Timer)) {
+		ChannelInternal->TimersStarted |= CANNM_TIMER_BIT(Timer);
+		ChannelInternal->Deadlines[Timer] += CanNm_Internal.MainFunctionTicks;
+	}
+}
+
+static inline void CanNm_Internal_TimerStop( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer )
+{
+	if (CanNm_Internal_TimerIsStarted(ChannelInternal, Timer)) {
+		ChannelInternal->Deadlines[Timer] = CanNm_Internal_TimerTicksLeft(ChannelInternal, Timer);
+		ChannelInternal->TimersStarted &= (uint8)~CANNM_TIMER_BIT(Timer);
+	}
+}
+
+static inline void CanNm_Internal_TimerReset( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, uint32 timeoutValue )
+{
+	ChannelInternal->TimersStarted &= (uint8)~CANNM_TIMER_BIT(Timer);
+	ChannelInternal->Deadlines[Timer] = CanNm_Internal_TimeToTicks(timeoutValue);
+}
+
+static inline void CanNm_Internal_TimerTick( CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer, const NetworkHandleType channel )
+{
+	if (CanNm_Internal_TimerIsStarted(ChannelInternal, Timer) &&
+	 (sint32)(CanNm_Internal.MainFunctionTicks - ChannelInternal->Deadlines[Timer]) >= 0) {
+		ChannelInternal->TimersStarted &= (uint8)~CANNM_TIMER_BIT(Timer);
+		ChannelInternal->Deadlines[Timer] = 0;
+		CanNm_Internal_TimerCallbacks[Timer](channel);
+	}
+	else {
 		//Nothing to be done
 	}
 }
 
-static inline void CanNm_Internal_TimersInit( uint8 channel )
+static inline boolean CanNm_Internal_TimerIsStarted( const CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer )
+{
+	return (ChannelInternal->TimersStarted & CANNM_TIMER_BIT(Timer)) != 0;
+}
+
+static inline uint32 CanNm_Internal_TimerTicksLeft( const CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_TimerType Timer )
+{
+	if (!CanNm_Internal_TimerIsStarted(ChannelInternal, Timer)) {
+		return CANNM_NO_TIMER_EXPIRY;
+	} else if ((sint32)(ChannelInternal->Deadlines[Timer] - CanNm_Internal.MainFunctionTicks) <= 0) {
+		return 1;		//Expires with the next main function
+	} else {
+		return ChannelInternal->Deadlines[Timer] - CanNm_Internal.MainFunctionTicks;
+	}
+}
+
+/* A timer expires with the first main function call at or after its timeout, at the earliest with the next one */
+static inline uint32 CanNm_Internal_TimeToTicks( uint32 timeoutValue )
+{
+	return CanNm_Internal_TimeToPeriods(timeoutValue, CanNm_ConfigPtr->MainFunctionPeriod);
+}
+
+static inline uint32 CanNm_Internal_TimeToPeriods( uint32 timeoutValue, float32 period )
+{
+	uint32 ticks = (uint32)((float32)timeoutValue / period);
+
+	if (((float32)ticks * period) < (float32)timeoutValue) {
+		ticks++;
+	}
+	return (ticks == 0) ? 1 : ticks;
+}
+
+static inline void CanNm_Internal_TimersInit( NetworkHandleType channel )
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	ChannelInternal->TimersStarted = 0;
+	memset(ChannelInternal->Deadlines, 0, sizeof(ChannelInternal->Deadlines));
+}
+
+static inline void CanNm_Internal_TimeoutTimerExpiredCallback( const NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TIMER_EXPIRED, CANNM_TRACE_TIMER_TIMEOUT, 0);
+	(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_TIMEOUT);
+}
+
+static inline void CanNm_Internal_MessageCycleTimerExpiredCallback( const NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	Std_ReturnType txStatus;
+
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TIMER_EXPIRED, CANNM_TRACE_TIMER_MESSAGE_CYCLE, 0);
+	if ((ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) || (ChannelInternal->State == NM_STATE_NORMAL_OPERATION)) {
+		txStatus = CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal, TRUE);				//[SWS_CanNm_00032][SWS_CanNm_00087]
+		if (txStatus == CANNM_E_TX_QUEUED) {
+			CanNm_Internal_TimerStop(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE);	//Restarted with the CanIf result
+		} else {
+			CanNm_Internal_MessageCycleRestart(ChannelConf, ChannelInternal, txStatus);
+		}
+	}
+}
+
+/* Next message cycle after a transmission attempt, under the channel exclusive area */
+static inline void CanNm_Internal_MessageCycleRestart( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal, Std_ReturnType txStatus )
+{
+	if (txStatus == CANNM_E_TX_DEFERRED) {
+		CanNm_Internal_TimerStartTicks(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, 1);		//Neither a transmission nor a retry is used up
+	} else if (ChannelInternal->ImmediateTransmissions) {
+		if (txStatus == E_NOT_OK) {
+			if (ChannelInternal->TxRetries >= CanNm_Internal_GetTxRetryLimit(ChannelConf)) {
+				ChannelInternal->ImmediateTransmissions = 0;
+				ChannelInternal->TxRetries = 0;
+				CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, ChannelConf->MsgCycleTime);		//[SWS_CanNm_00335]
+				CANNM_STATISTICS_COUNT(ChannelInternal->Channel, TxRetryGiveUpCount);
+			} else {
+				ChannelInternal->TxRetries++;
+				CanNm_Internal_TimerStartTicks(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE,
+				 CanNm_Internal_GetTxRetryTicks(ChannelConf, ChannelInternal->TxRetries));							//[SWS_CanNm_00335]
+				CANNM_STATISTICS_COUNT(ChannelInternal->Channel, TxRetryCount);
+			}
+		} else {
+			CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, ChannelConf->ImmediateNmCycleTime);		//[SWS_CanNm_00334]
+			ChannelInternal->ImmediateTransmissions--;
+			ChannelInternal->TxRetries = 0;
+			CANNM_STATISTICS_COUNT(ChannelInternal->Channel, ImmediateTxCount);
+		}
+	} else {
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, ChannelConf->MsgCycleTime);					//[SWS_CanNm_00040]
+	}
+}
+
+static inline void CanNm_Internal_RepeatMessageTimerExpiredCallback( const NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TIMER_EXPIRED, CANNM_TRACE_TIMER_REPEAT_MESSAGE, 0);
+	(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal,
+	 ChannelInternal->Requested ? CANNM_EVENT_REPEAT_MESSAGE_REQUESTED : CANNM_EVENT_REPEAT_MESSAGE_RELEASED);
+}
+
+static inline void CanNm_Internal_WaitBusSleepTimerExpiredCallback( const NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TIMER_EXPIRED, CANNM_TRACE_TIMER_WAIT_BUS_SLEEP, 0);
+	(void)CanNm_Internal_Transition(ChannelConf, ChannelInternal, CANNM_EVENT_WAIT_BUS_SLEEP);
+}
+
+static inline void CanNm_Internal_RemoteSleepIndTimerExpiredCallback( const NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TIMER_EXPIRED, CANNM_TRACE_TIMER_REMOTE_SLEEP_IND, 0);
+	ChannelInternal->RemoteSleepInd = TRUE;
+	CanNm_Internal_UpdateSleepReady(ChannelInternal);
+	CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_REMOTE_SLEEP_IND, 0, 0);
+	CANNM_STATISTICS_COUNT(channel, RemoteSleepIndCount);
+	CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND, ChannelConf->RemoteSleepIndTime);								//[SWS_CanNm_00150]
+}
+
+/***************************/
+/* State machine functions */
+/***************************/
+static Std_ReturnType CanNm_Internal_Transition( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal, CanNm_Internal_EventType Event )
+{
+	const CanNm_Internal_TransitionType* transition = &CanNm_Internal_Transitions[ChannelInternal->State][Event];
+	const Nm_StateType previousState = ChannelInternal->State;
+	const NetworkHandleType channel = ChannelInternal->Channel;
+	const uint32 actions = transition->Actions;
+	uint32 staggerTicks = 0;
+
+	if (transition->NextState == NM_STATE_UNINIT) {
+		return E_NOT_OK;
+	}
+	CanNm_Internal_StateChanged(ChannelInternal, previousState, transition->NextState);
+	ChannelInternal->Mode = CanNm_Internal_StateModes[transition->NextState];
+	ChannelInternal->State = transition->NextState;
+
+	if ((actions & CANNM_ACTION_TX_ENABLE) && !CANNM_PASSIVE_MODE()) {
+		ChannelInternal->TxEnabled = TRUE;
+	}
+	if (actions & CANNM_ACTION_TX_DISABLE) {
+		ChannelInternal->TxEnabled = FALSE;
+	}
+	if (actions & CANNM_ACTION_BUS_LOAD_REDUCTION_OFF) {
+		ChannelInternal->BusLoadReduction = FALSE;
+	}
+	if ((actions & CANNM_ACTION_BUS_LOAD_REDUCTION_ON) && CANNM_BUS_LOAD_REDUCTION(ChannelConf)) {
+		ChannelInternal->BusLoadReduction = TRUE;
+	}
+	if ((actions & CANNM_ACTION_CLEAR_CBV) && ChannelConf->NodeDetectionEnabled) {
+		CanNm_Internal_ClearPduCbv(ChannelConf, ChannelInternal);
+	}
+	if (actions & CANNM_ACTION_SET_REPEAT_MESSAGE_BIT) {
+		CanNm_Internal_SetPduCbvBit(ChannelConf, ChannelInternal, REPEAT_MESSAGE_REQUEST);
+	}
+	if ((actions & CANNM_ACTION_CLEAR_ACTIVE_WAKEUP_BIT) && ChannelConf->ActiveWakeupBitEnabled) {
+		CanNm_Internal_ClearPduCbvBit(ChannelConf, ChannelInternal, ACTIVE_WAKEUP_BIT);
+	}
+	if (actions & CANNM_ACTION_TX_TIMEOUT_EXCEPTION) {
+		CanNm_Internal_Callout(channel, CANNM_NOTIFICATION_TX_TIMEOUT_EXCEPTION, 0, 0);
+		CANNM_STATISTICS_COUNT(channel, TxTimeoutCount);
+	}
+	if (actions & CANNM_ACTION_START_TIMEOUT) {
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_TIMEOUT, ChannelConf->TimeoutTime);
+	}
+	if (actions & CANNM_ACTION_START_REPEAT_MESSAGE) {
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_REPEAT_MESSAGE, ChannelConf->RepeatMessageTime);
+	}
+	if (actions & CANNM_ACTION_NETWORK_MODE) {
+		staggerTicks = CanNm_Internal_GetWakeUpStaggerTicks(ChannelConf, channel);
+	}
+	if (actions & CANNM_ACTION_START_MESSAGE_CYCLE) {
+		CanNm_Internal_TimerStartTicks(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE,
+		 CanNm_Internal_TimeToTicks(ChannelConf->MsgCycleOffset) + staggerTicks);
+	}
+	if (actions & CANNM_ACTION_START_WAIT_BUS_SLEEP) {
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_WAIT_BUS_SLEEP, ChannelConf->WaitBusSleepTime);
+	}
+	if ((actions & CANNM_ACTION_START_REMOTE_SLEEP_IND) && CANNM_REMOTE_SLEEP_IND()) {
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND, ChannelConf->RemoteSleepIndTime);
+	}
+	if ((actions & CANNM_ACTION_CANCEL_REMOTE_SLEEP_IND) && ChannelInternal->RemoteSleepInd) {
+		ChannelInternal->RemoteSleepInd = FALSE;
+		CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_REMOTE_SLEEP_CANCELLATION, 0, 0);
+	}
+	if (actions & CANNM_ACTION_NETWORK_START_IND) {
+		CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_NETWORK_START, 0, 0);
+	}
+	if (actions & CANNM_ACTION_NETWORK_MODE) {
+		CanNm_Internal_Callout(channel, CANNM_NOTIFICATION_NETWORK_MODE, 0, 0);
+	}
+	if (actions & CANNM_ACTION_PREPARE_BUS_SLEEP_MODE) {
+		CanNm_Internal_Callout(channel, CANNM_NOTIFICATION_PREPARE_BUS_SLEEP_MODE, 0, 0);
+	}
+	if (actions & CANNM_ACTION_BUS_SLEEP_MODE) {
+		CANNM_LATENCY_STOP(channel, CANNM_LATENCY_NETWORK_RELEASE_TO_BUS_SLEEP);
+		CanNm_Internal_Callout(channel, CANNM_NOTIFICATION_BUS_SLEEP_MODE, 0, 0);
+	}
+	if ((actions & CANNM_ACTION_STATE_CHANGE_NOTIFICATION) && CANNM_STATE_CHANGE_IND()) {
+		CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_STATE_CHANGE, previousState, ChannelInternal->State);
+	}
+	if (actions & CANNM_ACTION_RX_REMOTE_SLEEP_IND) {
+		if (ChannelInternal->RemoteSleepInd) {
+			ChannelInternal->RemoteSleepInd = FALSE;
+			CanNm_Internal_Notify(channel, CANNM_NOTIFICATION_REMOTE_SLEEP_CANCELLATION, 0, 0);	//[SWS_CanNm_00151]
+		} else if (ChannelInternal->RemoteSleepIndEnabled) {
+			CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND, ChannelConf->RemoteSleepIndTime);
+		} else {
+			//Nothing to be done
+		}
+	}
+	if ((actions & CANNM_ACTION_ACTIVE_WAKEUP) && ChannelConf->ActiveWakeupBitEnabled) {
+		CanNm_Internal_SetPduCbvBit(ChannelConf, ChannelInternal, ACTIVE_WAKEUP_BIT);
+		if (ChannelConf->ImmediateNmTransmissions ||
+		 (previousState == NM_STATE_PREPARE_BUS_SLEEP && CANNM_IMMEDIATE_RESTART())) {		//[SWS_CanNm_00005][SWS_CanNm_00122]
+			ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
+			ChannelInternal->TxRetries = 0;
+			if (staggerTicks) {
+				CanNm_Internal_TimerStartTicks(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, staggerTicks);
+			} else {
+				CanNm_Internal_MessageCycleTimerExpiredCallback(channel);
+			}
+		}
+	}
+	if (actions & CANNM_ACTION_IMMEDIATE_TX) {
+		ChannelInternal->ImmediateTransmissions = ChannelConf->ImmediateNmTransmissions;
+		ChannelInternal->TxRetries = 0;
+		CanNm_Internal_MessageCycleTimerExpiredCallback(channel);
+	}
+	CanNm_Internal_UpdateSleepReady(ChannelInternal);
+	return E_OK;
+}
+
+/************************/
+/* Additional functions */
+/************************/
+/* Runtime state, Tx PDU and counters of a channel at start-up, done by CanNm_Init or on first use with lazy init */
+static void CanNm_Internal_ChannelInit( NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+
+	ChannelInternal->Channel = channel;
+	ChannelInternal->Mode = NM_MODE_BUS_SLEEP;														//[SWS_CanNm_00144]
+	ChannelInternal->State = NM_STATE_BUS_SLEEP;													//[SWS_CanNm_00141][SWS_CanNm_00094]
+	ChannelInternal->Requested = FALSE;																//[SWS_CanNm_00143]
+	ChannelInternal->TxEnabled = FALSE;
+	ChannelInternal->RxLastPdu = NO_PDU_RECEIVED;
+	ChannelInternal->ImmediateTransmissions = 0;
+	ChannelInternal->TxRetries = 0;
+	ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00023]
+	ChannelInternal->ReducedCycleTicks = CanNm_Internal_GetReducedCycleTicks(ChannelConf, CanNm_ConfigPtr->MainFunctionPeriod);
+	ChannelInternal->RemoteSleepInd = FALSE;
+	ChannelInternal->RemoteSleepIndEnabled = CANNM_REMOTE_SLEEP_IND();
+	ChannelInternal->NmPduFilterAlgorithm = FALSE;
+	ChannelInternal->TxPending = FALSE;
+
+	if (ChannelConf->NodeIdEnabled && ChannelConf->PduNidPosition != CANNM_PDU_OFF) {
+		CanNm_Internal.Pdus[channel].Tx[ChannelConf->PduNidPosition] = ChannelConf->NodeId;		//[SWS_CanNm_00013]
+	}
+
+	CanNm_Internal_ClearPduCbv(ChannelConf, ChannelInternal);										//[SWS_CanNm_00085]
+
+	uint8* destUserData = CanNm_Internal_GetUserDataPtr(ChannelConf, CanNm_Internal.Pdus[channel].Tx);
+	uint8 userDataLength = CanNm_Internal_GetUserDataLength(ChannelConf);
+	memset(destUserData, 0xFF, userDataLength);														//[SWS_CanNm_00025]
+
+	CanNm_Internal_TimersInit(channel);																//[SWS_CanNm_00061][SWS_CanNm_00033]
+	CanNm_Internal_UpdateSleepReady(ChannelInternal);
+	CanNm_Internal.Callouts[channel].Count = 0;
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	CanNm_Internal.Notifications[channel].Count = 0;
+#endif
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+	CanNm_Internal_ResetStatistics(channel);
+#endif
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+	CanNm_Internal_ResetLatency(channel);
+#endif
+}
+
+/* Lazy CanNm_Init: channels stay uninitialized with no timer running and count as sleeping until their first use */
+static inline void CanNm_Internal_ChannelsClear( void )
+{
+#if (CANNM_LAZY_INIT_ENABLED == STD_ON)
+	memset(CanNm_Internal.Channels, 0, sizeof(CanNm_Internal.Channels));						//NM_STATE_UNINIT, timers stopped
+	memset(CanNm_Internal.ChannelsInitialized, 0, sizeof(CanNm_Internal.ChannelsInitialized));
+	memset(CanNm_Internal.SleepReady.ReadyToSleep, 0xFF, sizeof(CanNm_Internal.SleepReady.ReadyToSleep));
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	memset(CanNm_Internal.Notifications, 0, sizeof(CanNm_Internal.Notifications));
+#endif
+#endif
+}
+
+/* Called before a channel is used by an API or a reception, sets it up once after a lazy CanNm_Init */
+static inline void CanNm_Internal_LazyInit( NetworkHandleType channel )
+{
+#if (CANNM_LAZY_INIT_ENABLED == STD_ON)
+	uint32* word = &CanNm_Internal.ChannelsInitialized[channel / 32];
+	uint32 bit = CANNM_SLEEP_READY_BIT(channel);
+
+	if (CANNM_LAZY_INIT() && (__atomic_load_n(word, __ATOMIC_ACQUIRE) & bit) == 0) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+		if ((__atomic_load_n(word, __ATOMIC_RELAXED) & bit) == 0) {							//Not set up by a concurrent first use
+			CanNm_Internal_ChannelInit(channel);
+			__atomic_fetch_or(word, bit, __ATOMIC_RELEASE);
+		}
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	}
+#else
+	(void)channel;
+#endif
+}
+
+/* Configuration of a channel: the published set, or the one it keeps over CanNm_Reconfigure until its safe point. The
+   set is loaded first, a channel to retain its configuration is marked before the new set is published. */
+static inline const CanNm_ChannelType* CanNm_Internal_GetChannelConf( NetworkHandleType channel )
+{
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+	const CanNm_ConfigType* Config = __atomic_load_n(&CanNm_ConfigPtr, __ATOMIC_ACQUIRE);
+	const CanNm_ChannelType* RetainedConf = __atomic_load_n(&CanNm_Internal.Channels[channel].RetainedConf, __ATOMIC_ACQUIRE);
+
+	return (RetainedConf != NULL) ? RetainedConf : Config->ChannelConfig[channel];
+#else
+	return CanNm_ConfigPtr->ChannelConfig[channel];
+#endif
+}
+
+/* Tx, user data and Rx PDUs of every channel have to fit the CANNM_PDU_MAX_LENGTH buffers in CanNm_Internal.Pdus */
+static boolean CanNm_Internal_PduLengthsValid( const CanNm_ConfigType* config )
+{
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		const CanNm_ChannelType* ChannelConf = config->ChannelConfig[channel];
+
+		if (ChannelConf->TxPdu->TxPduRef->SduLength > CANNM_PDU_MAX_LENGTH || (ChannelConf->UserDataTxPdu != NULL &&
+		 ChannelConf->UserDataTxPdu->TxUserDataPduRef->SduLength > CANNM_PDU_MAX_LENGTH)) {
+			return FALSE;
+		}
+		for (uint32 slot = 0; slot < CANNM_RXPDU_MAX_COUNT; slot++) {
+			if (ChannelConf->RxPdu[slot] != NULL && ChannelConf->RxPdu[slot]->RxPduRef->SduLength > CANNM_PDU_MAX_LENGTH) {
+				return FALSE;
+			}
+		}
+	}
+	return TRUE;
+}
+
+/* Bytes to copy between a PDU buffer and a caller buffer: the configured length, at most what both buffers hold */
+static inline PduLengthType CanNm_Internal_PduCopyLength( PduLengthType configured, PduLengthType available )
+{
+	PduLengthType length = (configured < available) ? configured : available;
+
+	return (length < CANNM_PDU_MAX_LENGTH) ? length : CANNM_PDU_MAX_LENGTH;
+}
+
+static inline Std_ReturnType CanNm_Internal_TxDisable( CanNm_Internal_ChannelType* ChannelInternal )
+{
+	ChannelInternal->TxEnabled = FALSE;
+	if (CANNM_REMOTE_SLEEP_IND()) {
+		ChannelInternal->RemoteSleepIndEnabled = FALSE;												//[SWS_CanNm_00175]
+		CanNm_Internal_TimerStop(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND);
+	}								
+	CanNm_Internal_TimerStop(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE);									//[SWS_CanNm_00051][SWS_CanNm_00173]
+	CanNm_Internal_TimerStop(ChannelInternal, CANNM_TIMER_TIMEOUT);										//[SWS_CanNm_00174]
+	return E_OK;
+}
+
+static inline Std_ReturnType CanNm_Internal_TxEnable( CanNm_Internal_ChannelType* ChannelInternal )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(ChannelInternal->Channel);
+
+	if (!CANNM_PASSIVE_MODE()) {
+		ChannelInternal->TxEnabled = TRUE;															//[SWS_CanNm_00237]
+		if (CANNM_REMOTE_SLEEP_IND()) {
+			ChannelInternal->RemoteSleepIndEnabled = TRUE;											//[SWS_CanNm_00180]
+			CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_REMOTE_SLEEP_IND, ChannelConf->RemoteSleepIndTime);
+		}											
+		CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, 1);							//[SWS_CanNm_00178]
+		return E_OK;
+	} else {
+		return E_NOT_OK;
+	}
+}
+
+/* Called under the channel exclusive area: the NM PDU is handed to CanIf by CanNm_Internal_FlushCallouts once the area
+   is left. A full callout queue defers the transmission like an empty token bucket */
+static inline Std_ReturnType CanNm_Internal_TransmitMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal, boolean cycle )
+{
+	Std_ReturnType status = E_OK;
+
+	if (ChannelInternal->TxEnabled) {
+		if (CanNm_Internal.Callouts[ChannelInternal->Channel].Count == CANNM_CALLOUT_QUEUE_SIZE ||
+		 !CanNm_Internal_TxLimiterTake(ChannelConf)) {
+			CANNM_STATISTICS_COUNT(ChannelInternal->Channel, TxDeferredCount);
+			return CANNM_E_TX_DEFERRED;
+		}
+		CanNm_Internal_Callout(ChannelInternal->Channel, CANNM_NOTIFICATION_TRANSMIT, cycle, 0);
+		status = CANNM_E_TX_QUEUED;
+	}
+	ChannelInternal->TxPending = FALSE;									//Any NM PDU passed on carries the pending request
+	return status;
+}
+
+/* Outside of all exclusive areas: transmits a copy of the Tx PDU and accounts for the result under the channel area */
+static void CanNm_Internal_TransmitCallout( NetworkHandleType channel, boolean cycle )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	uint8 sdu[CANNM_PDU_MAX_LENGTH];
+	PduInfoType pduInfo = { .SduDataPtr = sdu, .SduLength = ChannelConf->TxPdu->TxPduRef->SduLength };
+	Std_ReturnType status;
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+	memcpy(sdu, CanNm_Internal.Pdus[channel].Tx, CanNm_Internal_PduCopyLength(pduInfo.SduLength, CANNM_PDU_MAX_LENGTH));
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+	status = CANNM_CAN_IF_TRANSMIT(ChannelConf->TxPdu->TxConfirmationPduId, &pduInfo);				//[SWS_CanNm_00032]
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	CANNM_TRACE(channel, CANNM_TRACE_EVENT_TX, status, ChannelConf->TxPdu->TxConfirmationPduId);
+	if (status == E_OK) {
+		CANNM_LATENCY_STOP(channel, CANNM_LATENCY_NETWORK_REQUEST_TO_TX);
+		CANNM_STATISTICS_COUNT(channel, TxCount);
+		CanNm_Internal_TxDeadlineArm(ChannelConf, channel);
+	} else {
+		CANNM_STATISTICS_COUNT(channel, TxFailedCount);
+	}
+	/* A message cycle started meanwhile, or a state without one, supersedes the restart */
+	if (cycle && !CanNm_Internal_TimerIsStarted(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) &&
+	 ((ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) || (ChannelInternal->State == NM_STATE_NORMAL_OPERATION))) {
+		CanNm_Internal_MessageCycleRestart(ChannelConf, ChannelInternal, status);
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+}
+
+static inline void CanNm_Internal_TxDeadlinesInit( void )
+{
+	CanNm_Internal.TxSupervision.Count = 0;
+	memset(CanNm_Internal.TxSupervision.Positions, 0xFF, sizeof(CanNm_Internal.TxSupervision.Positions));
+}
+
+/* An accepted NM PDU is supervised until CanNm_TxConfirmation, a pending supervision keeps its earlier deadline */
+static inline void CanNm_Internal_TxDeadlineArm( const CanNm_ChannelType* ChannelConf, NetworkHandleType channel )
+{
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+
+	if (ChannelConf->MsgTimeoutTime <= 0.0f || CanNm_Callbacks->CanIfTransmit == NULL) {
+		return;
+	}
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	if (Supervision->Positions[channel] == CANNM_TX_DEADLINE_NONE) {
+		CanNm_Internal_TxDeadlineInsert(channel, CanNm_Internal.MainFunctionTicks +
+		 CanNm_Internal_TimeToTicks(ChannelConf->MsgTimeoutTime));
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+}
+
+/* Add the deadline of a channel without one to the heap, under the Tx supervision exclusive area */
+static inline void CanNm_Internal_TxDeadlineInsert( NetworkHandleType channel, uint32 deadline )
+{
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+	uint32 index = Supervision->Count++;
+
+	Supervision->Heap[index].Deadline = deadline;
+	Supervision->Heap[index].Channel = channel;
+	Supervision->Positions[channel] = (NetworkHandleType)index;
+	while (index > 0 && index < CANNM_CHANNEL_COUNT &&
+	 (sint32)(Supervision->Heap[index].Deadline - Supervision->Heap[(index - 1) / 2].Deadline) < 0) {
+		CanNm_Internal_TxDeadlineSwap(index, (index - 1) / 2);
+		index = (index - 1) / 2;
+	}
+}
+
+static inline void CanNm_Internal_TxDeadlineClear( NetworkHandleType channel )
+{
+	if (__atomic_load_n(&CanNm_Internal.TxSupervision.Positions[channel], __ATOMIC_RELAXED) != CANNM_TX_DEADLINE_NONE) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+		CanNm_Internal_TxDeadlineRemove(channel);
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	}
+}
+
+/* Called inside the TXSUPERVISION area: the last entry takes the place of the removed one and moves up or down */
+static inline void CanNm_Internal_TxDeadlineRemove( NetworkHandleType channel )
+{
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+	uint32 index = Supervision->Positions[channel];
+
+	if (index == CANNM_TX_DEADLINE_NONE) {
+		return;
+	}
+	Supervision->Count--;
+	Supervision->Positions[channel] = CANNM_TX_DEADLINE_NONE;
+	if (index == Supervision->Count) {
+		return;
+	}
+	Supervision->Heap[index] = Supervision->Heap[Supervision->Count];
+	Supervision->Positions[Supervision->Heap[index].Channel] = (NetworkHandleType)index;
+	while (index > 0 && index < CANNM_CHANNEL_COUNT &&
+	 (sint32)(Supervision->Heap[index].Deadline - Supervision->Heap[(index - 1) / 2].Deadline) < 0) {
+		CanNm_Internal_TxDeadlineSwap(index, (index - 1) / 2);
+		index = (index - 1) / 2;
+	}
+	for (;;) {
+		uint32 earliest = index;
+		uint32 child = (2 * index) + 1;
+
+		if (child >= CANNM_CHANNEL_COUNT) {									//Bound the compiler can see
+			break;
+		}
+		if (child < Supervision->Count && (sint32)(Supervision->Heap[child].Deadline - Supervision->Heap[earliest].Deadline) < 0) {
+			earliest = child;
+		}
+		if (child + 1 < Supervision->Count && child + 1 < CANNM_CHANNEL_COUNT && (sint32)(Supervision->Heap[child + 1].Deadline - Supervision->Heap[earliest].Deadline) < 0) {
+			earliest = child + 1;
+		}
+		if (earliest == index) {
+			break;
+		}
+		CanNm_Internal_TxDeadlineSwap(index, earliest);
+		index = earliest;
+	}
+}
+
+static inline void CanNm_Internal_TxDeadlineSwap( uint32 first, uint32 second )
+{
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+	CanNm_Internal_TxDeadlineType entry = Supervision->Heap[first];
+
+	Supervision->Heap[first] = Supervision->Heap[second];
+	Supervision->Heap[second] = entry;
+	Supervision->Positions[Supervision->Heap[first].Channel] = (NetworkHandleType)first;
+	Supervision->Positions[Supervision->Heap[second].Channel] = (NetworkHandleType)second;
+}
+
+/* Reports every channel whose transmit confirmation is overdue, the exception is raised outside the lock */
+static inline void CanNm_Internal_TxDeadlinesExpire( void )
+{
+	CanNm_Internal_TxSupervisionType* Supervision = &CanNm_Internal.TxSupervision;
+
+	while (__atomic_load_n(&Supervision->Count, __ATOMIC_RELAXED) != 0) {
+		NetworkHandleType channel;
+
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+		if (Supervision->Count == 0 || (sint32)(Supervision->Heap[0].Deadline - CanNm_Internal.MainFunctionTicks) > 0) {
+			SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+			break;
+		}
+		channel = Supervision->Heap[0].Channel;
+		CanNm_Internal_TxDeadlineRemove(channel);
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+		CANNM_CALLBACK(CanSmTxTimeoutException, channel);
+		CANNM_STATISTICS_COUNT(channel, TxConfirmationTimeoutCount);
+	}
+}
+
+static inline void CanNm_Internal_SetPduCbvBit( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal, const uint8 PduCbvBitPosition )
+{
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+	CanNm_Internal.Pdus[ChannelInternal->Channel].Tx[ChannelConf->PduCbvPosition] |= (1 << PduCbvBitPosition);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+}
+
+static inline void CanNm_Internal_ClearPduCbvBit( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal, const uint8 PduCbvBitPosition )
+{
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+	CanNm_Internal.Pdus[ChannelInternal->Channel].Tx[ChannelConf->PduCbvPosition] &= ~(1 << PduCbvBitPosition);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+}
+
+static inline void CanNm_Internal_ClearPduCbv( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+{
+	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+		CanNm_Internal.Pdus[ChannelInternal->Channel].Tx[ChannelConf->PduCbvPosition] = 0x00;
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, ChannelInternal->Channel);
+	}
+}
+
+static inline uint8 CanNm_Internal_GetUserDataOffset( const CanNm_ChannelType* ChannelConf )
+{
+	uint8 userDataPos = 0;
+	userDataPos += (ChannelConf->PduNidPosition == CANNM_PDU_OFF) ? 0 : 1;
+	userDataPos += (ChannelConf->PduCbvPosition == CANNM_PDU_OFF) ? 0 : 1;
+	return userDataPos;
+}
+
+static inline uint8* CanNm_Internal_GetUserDataPtr( const CanNm_ChannelType* ChannelConf, uint8* MessageSduPtr )
+{
+	uint8 userDataOffset = CanNm_Internal_GetUserDataOffset(ChannelConf);
+	return &MessageSduPtr[userDataOffset];
+}
+
+static inline uint8 CanNm_Internal_GetUserDataLength( const CanNm_ChannelType* ChannelConf )
+{
+	uint8 userDataOffset = CanNm_Internal_GetUserDataOffset(ChannelConf);
+	return ChannelConf->UserDataTxPdu->TxUserDataPduRef->SduLength - userDataOffset;
+}
+
+/* Delay before the given retry of a failed immediate transmission, each channel backs off on its own failures */
+static inline uint32 CanNm_Internal_GetTxRetryTicks( const CanNm_ChannelType* ChannelConf, uint8 retry )
+{
+	uint32 ticks = CanNm_Internal_TimeToTicks(ChannelConf->TxRetryTime);
+	uint32 maxTicks = CanNm_Internal_TimeToTicks((ChannelConf->TxRetryMaxTime > 0.0f) ? ChannelConf->TxRetryMaxTime : ChannelConf->MsgCycleTime);
+
+	switch (ChannelConf->TxRetryPolicy) {
+	case CANNM_TX_RETRY_FIXED:
+		return ticks;
+	case CANNM_TX_RETRY_EXPONENTIAL:
+		for (uint8 doubling = 1; doubling < retry && ticks < maxTicks; doubling++) {
+			ticks *= 2;
+		}
+		return (ticks < maxTicks) ? ticks : maxTicks;
+	default:
+		return 1;
+	}
+}
+
+static inline uint8 CanNm_Internal_GetTxRetryLimit( const CanNm_ChannelType* ChannelConf )
 {
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	return (ChannelConf->TxRetryPolicy == CANNM_TX_RETRY_NEXT_MAIN_FUNCTION) ? 1 : ChannelConf->TxRetryLimit;
+}
+
+/* Channels started together take distinct slots of the window in index order, or hashed slots that also differ
+   between ECUs using the same channel index on one bus. The delay adds to MsgCycleOffset and never shortens it */
+static inline uint32 CanNm_Internal_GetWakeUpStaggerTicks( const CanNm_ChannelType* ChannelConf, NetworkHandleType channel )
+{
+	uint32 key = (uint32)channel;
+
+	if (CanNm_ConfigPtr->WakeUpStaggerTime <= 0.0f) {
+		return 0;
+	}
+	if (CanNm_ConfigPtr->WakeUpStagger == CANNM_WAKEUP_STAGGER_HASH) {
+		key = (uint32)(((key << 8) | ChannelConf->NodeId) * 2654435761U) >> 16;	//Fibonacci hashing
+	}
+	return key % CanNm_Internal_TimeToTicks(CanNm_ConfigPtr->WakeUpStaggerTime);
+}
+
+/* Without a configured MsgReducedTime the node identifier picks a slot between half and full MsgCycleTime, so on a
+   bus of nodes with distinct identifiers the two lowest ones keep sending and all others only receive */
+static inline uint32 CanNm_Internal_GetReducedCycleTicks( const CanNm_ChannelType* ChannelConf, float32 period )
+{
+	uint32 cycleTicks = CanNm_Internal_TimeToPeriods(ChannelConf->MsgCycleTime, period);
+	uint32 slots = CanNm_Internal_GetReducedCycleSlots(ChannelConf, period);
 
-	ChannelInternal->TimeoutTimer.Channel = channel;
-	ChannelInternal->TimeoutTimer.ExpiredCallback = CanNm_Internal_TimeoutTimerExpiredCallback;
-	ChannelInternal->TimeoutTimer.State = CANNM_TIMER_STOPPED;
-	ChannelInternal->TimeoutTimer.TimeLeft = 0;
+	if (ChannelConf->MsgReducedTime > 0.0f) {
+		return CanNm_Internal_TimeToPeriods(ChannelConf->MsgReducedTime, period);
+	} else if (slots == 0) {
+		return cycleTicks;
+	} else {
+		return (cycleTicks / 2) + 1 + (ChannelConf->NodeId % slots);
+	}
+}
+
+/* Distinct reduced cycles the node identifiers are spread over, 0 with a configured MsgReducedTime */
+static inline uint32 CanNm_Internal_GetReducedCycleSlots( const CanNm_ChannelType* ChannelConf, float32 period )
+{
+	uint32 cycleTicks = CanNm_Internal_TimeToPeriods(ChannelConf->MsgCycleTime, period);
 
-	ChannelInternal->MessageCycleTimer.Channel = channel;
-	ChannelInternal->MessageCycleTimer.ExpiredCallback = CanNm_Internal_MessageCycleTimerExpiredCallback;
-	ChannelInternal->MessageCycleTimer.State = CANNM_TIMER_STOPPED;
-	ChannelInternal->MessageCycleTimer.TimeLeft = 0;
+	if (ChannelConf->MsgReducedTime > 0.0f || cycleTicks < 3) {
+		return 0;
+	}
+	return cycleTicks - (cycleTicks / 2) - 1;
+}
 
-	ChannelInternal->RepeatMessageTimer.Channel = channel;
-	ChannelInternal->RepeatMessageTimer.ExpiredCallback = CanNm_Internal_RepeatMessageTimerExpiredCallback;
-	ChannelInternal->RepeatMessageTimer.State = CANNM_TIMER_STOPPED;
-	ChannelInternal->RepeatMessageTimer.TimeLeft = 0;
+/* Bits of a data frame with an 11 bit identifier at the nominal bit rate with worst case bit stuffing: classic CAN up
+   to 8 bytes, CAN FD without bit rate switch above */
+static inline uint32 CanNm_Internal_GetFrameBits( PduLengthType sduLength )
+{
+	static const uint8 fdLengths[] = { 12, 16, 20, 24, 32, 48, 64 };
+	uint32 length = sduLength;
 
-	ChannelInternal->WaitBusSleepTimer.Channel = channel;
-	ChannelInternal->WaitBusSleepTimer.ExpiredCallback = CanNm_Internal_WaitBusSleepTimerExpiredCallback;
-	ChannelInternal->WaitBusSleepTimer.State = CANNM_TIMER_STOPPED;
-	ChannelInternal->WaitBusSleepTimer.TimeLeft = 0;
+	if (length <= 8) {
+		return (8 * length) + 47 + ((34 + (8 * length) - 1) / 4);
+	}
+	for (uint8 index = 0; index < sizeof(fdLengths); index++) {
+		if (length <= fdLengths[index]) {
+			length = fdLengths[index];
+			break;
+		}
+	}
+	uint32 crcBits = (length <= 16) ? 17 : 21;
+	return 22 + (8 * length) + ((22 + (8 * length) - 1) / 4) + 4 + crcBits + ((4 + crcBits + 3) / 4) + 13;
+}
 
-	ChannelInternal->RemoteSleepIndTimer.Channel = channel;
-	ChannelInternal->RemoteSleepIndTimer.ExpiredCallback = CanNm_Internal_RemoteSleepIndTimerExpiredCallback;
-	ChannelInternal->RemoteSleepIndTimer.State = CANNM_TIMER_STOPPED;
-	ChannelInternal->RemoteSleepIndTimer.TimeLeft = 0;
+#if (CANNM_TRACE_ENABLED == STD_ON)
+static inline void CanNm_Internal_Trace( NetworkHandleType channel, CanNm_TraceEventType event, uint8 arg0, uint32 arg1 )
+{
+	CanNm_Internal_TraceRingType* ring = &CanNm_Internal.TraceRings[channel];
+	uint32 head = ring->Head;
+	CanNm_TraceRecordType* record = &ring->Records[head & (CANNM_TRACE_RING_SIZE - 1)];
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);										//Head of the last record before the slot
+	record->Timestamp = CANNM_TRACE_TIMESTAMP();
+	record->Sequence = head;
+	record->Channel = channel;
+	record->Event = (uint8)event;
+	record->Arg0 = arg0;
+	record->Arg1 = arg1;
+	__atomic_store_n(&ring->Head, head + 1, __ATOMIC_RELEASE);
 }
+#endif
 
-static inline void CanNm_Internal_TimeoutTimerExpiredCallback( void* Timer, const uint8 channel )
+static inline void CanNm_Internal_TxLimitersInit( void )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	for (uint8 controller = 0; controller < CANNM_CONTROLLER_COUNT; controller++) {
+		CanNm_Internal_TxLimiterType* limiter = &CanNm_Internal.TxLimiters[controller];
 
-	if (ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) {
-		Nm_TxTimeoutException(ChannelInternal->Channel);
-		CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);
-	} else if (ChannelInternal->State == NM_STATE_NORMAL_OPERATION) {
-		Nm_TxTimeoutException(ChannelInternal->Channel);
-		CanNm_Internal_NormalOperation_to_NormalOperation(ChannelConf, ChannelInternal);
-	} else if (ChannelInternal->State == NM_STATE_READY_SLEEP) {
-		if (ChannelConf->ActiveWakeupBitEnabled) {
-			CanNm_Internal_ClearPduCbvBit(ChannelConf, ACTIVE_WAKEUP_BIT);		  					//[SWS_CanNm_00402]
-		}
-		CanNm_Internal_ReadySleep_to_PrepareBusSleep(ChannelConf, ChannelInternal);					//[SWS_CanNm_00109]
+		CanNm_Internal_TxLimiterConfigure(limiter, controller);
+		limiter->Tokens = limiter->Capacity;
+		limiter->LastTick = CanNm_Internal.MainFunctionTicks;
+	}
+}
+
+/* Capacity and refill rate of the token bucket of a controller from ControllerConfig */
+static inline void CanNm_Internal_TxLimiterConfigure( CanNm_Internal_TxLimiterType* limiter, uint8 controller )
+{
+	const CanNm_ControllerType* ControllerConf = (CanNm_ConfigPtr->ControllerConfig != NULL) ?
+	 &CanNm_ConfigPtr->ControllerConfig[controller] : NULL;
+
+	limiter->Capacity = (ControllerConf != NULL) ? (uint32)ControllerConf->TxBucketSize * CANNM_TX_TOKEN : 0;
+	if (ControllerConf != NULL && ControllerConf->TxTokenTime > 0.0f) {
+		float32 tokensPerTick = CanNm_ConfigPtr->MainFunctionPeriod / ControllerConf->TxTokenTime * (float32)CANNM_TX_TOKEN;
+
+		limiter->TokensPerTick = (tokensPerTick < (float32)limiter->Capacity) ? (uint32)tokensPerTick : limiter->Capacity;
+		if ((float32)limiter->TokensPerTick < tokensPerTick && limiter->TokensPerTick < limiter->Capacity) {
+			limiter->TokensPerTick++;											//A token is never later than TxTokenTime
+		}
 	} else {
-		//Nothing to be done
-	}	
+		limiter->TokensPerTick = limiter->Capacity;
+	}
 }
 
-static inline void CanNm_Internal_MessageCycleTimerExpiredCallback( void* Timer, const uint8 channel )
+/* Excess NM PDUs wait for the next main function instead of failing in a full controller queue, where every failure
+   would schedule a retry and add to the congestion */
+static inline boolean CanNm_Internal_TxLimiterTake( const CanNm_ChannelType* ChannelConf )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
-	Std_ReturnType txStatus = E_OK;
-	static Std_ReturnType lastTxStatus;
+	CanNm_Internal_TxLimiterType* limiter;
+	uint32 ticks;
+	boolean granted;
 
-	if ((ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) || (ChannelInternal->State == NM_STATE_NORMAL_OPERATION)) {
-		txStatus = CanNm_Internal_TransmitMessage(ChannelConf, ChannelInternal);					//[SWS_CanNm_00032][SWS_CanNm_00087]
-		if (ChannelInternal->ImmediateTransmissions) {
-			if (txStatus == E_NOT_OK) {
-				if (lastTxStatus == E_NOT_OK) {
-					ChannelInternal->ImmediateTransmissions = 0;
-					CanNm_Internal_TimerStart((CanNm_Timer*)Timer, ChannelConf->MsgCycleTime);		//[SWS_CanNm_00335]
-				} else {
-					CanNm_Internal_TimerStart((CanNm_Timer*)Timer, 1);								//[SWS_CanNm_00335]
-				}
-			} else {
-				CanNm_Internal_TimerStart((CanNm_Timer*)Timer, ChannelConf->ImmediateNmCycleTime);	//[SWS_CanNm_00334]
-				ChannelInternal->ImmediateTransmissions--;
-			}
-		} else {
-			CanNm_Internal_TimerStart((CanNm_Timer*)Timer, ChannelConf->MsgCycleTime);				//[SWS_CanNm_00040]
+	if (ChannelConf->ControllerIndex >= CANNM_CONTROLLER_COUNT ||
+	 CanNm_Internal.TxLimiters[ChannelConf->ControllerIndex].Capacity == 0) {
+		return TRUE;
+	}
+	limiter = &CanNm_Internal.TxLimiters[ChannelConf->ControllerIndex];
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, ChannelConf->ControllerIndex);
+	ticks = CanNm_Internal.MainFunctionTicks - limiter->LastTick;
+	if (ticks != 0) {
+		uint64 tokens = (uint64)limiter->Tokens + ((uint64)ticks * limiter->TokensPerTick);
+
+		limiter->Tokens = (tokens < limiter->Capacity) ? (uint32)tokens : limiter->Capacity;
+		limiter->LastTick = CanNm_Internal.MainFunctionTicks;
+	}
+	granted = (limiter->Tokens >= CANNM_TX_TOKEN);
+	if (granted) {
+		limiter->Tokens -= CANNM_TX_TOKEN;
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, ChannelConf->ControllerIndex);
+	return granted;
+}
+
+static inline void CanNm_Internal_SleepReadyInit( void )
+{
+	CanNm_Internal_SleepReadyType* SleepReady = &CanNm_Internal.SleepReady;
+
+	memset(SleepReady, 0, sizeof(*SleepReady));
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		uint8 cluster = CanNm_Internal_GetChannelConf(channel)->CoordClusterIndex;
+
+		if (cluster < CANNM_COORD_CLUSTER_COUNT) {
+			SleepReady->Clusters[cluster][channel / 32] |= CANNM_SLEEP_READY_BIT(channel);
+			SleepReady->ClustersUsed |= 1UL << cluster;
 		}
 	}
-	lastTxStatus = txStatus;
 }
 
-static inline void CanNm_Internal_RepeatMessageTimerExpiredCallback( void* Timer, const uint8 channel )
+static inline void CanNm_Internal_SetSleepReadyBit( uint32* bitmap, NetworkHandleType channel, boolean value )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	uint32* word = &bitmap[channel / 32];
+	uint32 bit = CANNM_SLEEP_READY_BIT(channel);
 
-	if (ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) {
-		if (ChannelInternal->Requested) {
-			CanNm_Internal_RepeatMessage_to_NormalOperation(ChannelConf, ChannelInternal);			//[SWS_CanNm_00103]
+	if (((__atomic_load_n(word, __ATOMIC_RELAXED) & bit) != 0) != value) {
+		if (value) {
+			__atomic_fetch_or(word, bit, __ATOMIC_RELAXED);
 		} else {
-			CanNm_Internal_RepeatMessage_to_ReadySleep(ChannelConf, ChannelInternal);				//[SWS_CanNm_00106]
+			__atomic_fetch_and(word, ~bit, __ATOMIC_RELAXED);
 		}
+		__atomic_store_n(&CanNm_Internal.SleepReady.Changed, TRUE, __ATOMIC_RELEASE);
 	}
 }
 
-static inline void CanNm_Internal_WaitBusSleepTimerExpiredCallback( void* Timer, const uint8 channel )
+/* Called under the channel exclusive area after the state or the remote sleep indication may have changed */
+static inline void CanNm_Internal_UpdateSleepReady( const CanNm_Internal_ChannelType* ChannelInternal )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	Nm_StateType state = ChannelInternal->State;
+
+	CanNm_Internal_SetSleepReadyBit(CanNm_Internal.SleepReady.ReadyToSleep, ChannelInternal->Channel,
+	 state == NM_STATE_READY_SLEEP || state == NM_STATE_PREPARE_BUS_SLEEP || state == NM_STATE_BUS_SLEEP);
+	CanNm_Internal_SetSleepReadyBit(CanNm_Internal.SleepReady.RemoteSleepInd, ChannelInternal->Channel,
+	 ChannelInternal->RemoteSleepInd);
+}
+
+static inline boolean CanNm_Internal_IsClusterSleepReady( uint8 cluster )
+{
+	const CanNm_Internal_SleepReadyType* SleepReady = &CanNm_Internal.SleepReady;
 
-	if (ChannelInternal->Mode == NM_MODE_PREPARE_BUS_SLEEP) {
-		CanNm_Internal_PrepareBusSleep_to_BusSleep(ChannelConf, ChannelInternal);					//[SWS_CanNm_00088]
+	for (uint32 word = 0; word < CANNM_SLEEP_READY_WORDS; word++) {
+		uint32 ready = __atomic_load_n(&SleepReady->ReadyToSleep[word], __ATOMIC_RELAXED) |
+		 __atomic_load_n(&SleepReady->RemoteSleepInd[word], __ATOMIC_RELAXED);
+
+		if ((SleepReady->Clusters[cluster][word] & ~ready) != 0) {
+			return FALSE;
+		}
 	}
+	return TRUE;
 }
 
-static inline void CanNm_Internal_RemoteSleepIndTimerExpiredCallback( void* Timer, const uint8 channel )
+/* Main function context only: reports clusters that became ready to sleep or left that condition */
+static inline void CanNm_Internal_CheckClusters( void )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
-	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	CanNm_Internal_SleepReadyType* SleepReady = &CanNm_Internal.SleepReady;
 
-	ChannelInternal->RemoteSleepInd = TRUE;
-	Nm_RemoteSleepInd(channel);
-	CanNm_Internal_TimerStart(Timer, ChannelConf->RemoteSleepIndTime);								//[SWS_CanNm_00150]
+	if (!__atomic_exchange_n(&SleepReady->Changed, FALSE, __ATOMIC_ACQUIRE)) {
+		return;
+	}
+	for (uint8 cluster = 0; cluster < CANNM_COORD_CLUSTER_COUNT; cluster++) {
+		uint32 bit = 1UL << cluster;
+		boolean ready = CanNm_Internal_IsClusterSleepReady(cluster);
+
+		if ((SleepReady->ClustersUsed & bit) == 0 || ready == ((SleepReady->ClustersReady & bit) != 0)) {
+			continue;
+		}
+		SleepReady->ClustersReady ^= bit;
+		if (ready) {
+			CANNM_CALLBACK(CoordSleepReadyIndication, cluster);
+		} else {
+			CANNM_CALLBACK(CoordSleepReadyCancellation, cluster);
+		}
+	}
 }
 
-/***************************/
-/* State machine functions */
-/***************************/
-static inline void CanNm_Internal_BusSleep_to_BusSleep( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+static inline void CanNm_Internal_StatePut( CanNm_Internal_StateWriterType* writer, uint32 value, uint8 bytes )
 {
-	Nm_NetworkStartIndication(ChannelInternal->Channel);
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_BUS_SLEEP, NM_STATE_BUS_SLEEP);
+	for (uint8 index = 0; index < bytes; index++, writer->Position++) {
+		if (writer->Position < writer->Size) {
+			writer->Buffer[writer->Position] = (uint8)(value >> (8 * index));		//Little endian
+		}
 	}
 }
 
-static inline void CanNm_Internal_BusSleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+static inline void CanNm_Internal_StatePutBytes( CanNm_Internal_StateWriterType* writer, const uint8* data, uint32 length )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_REPEAT_MESSAGE;
-	ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00156]
-	CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);			//[SWS_CanNm_00096]
-	CanNm_Internal_TimerStart(&ChannelInternal->RepeatMessageTimer, ChannelConf->RepeatMessageTime);//[SWS_CanNm_00102]
-	CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgCycleOffset);	//[SWS_CanNm_00100]
-	Nm_NetworkMode(ChannelInternal->Channel);														//[SWS_CanNm_00097]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_BUS_SLEEP, NM_STATE_REPEAT_MESSAGE);
+	if (writer->Position + length <= writer->Size) {
+		memcpy(&writer->Buffer[writer->Position], data, length);
 	}
+	writer->Position += length;
 }
 
-static inline void CanNm_Internal_RepeatMessage_to_RepeatMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+static inline uint32 CanNm_Internal_StateGet( CanNm_Internal_StateReaderType* reader, uint8 bytes )
 {
-	CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);			//[SWS_CanNm_00101]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_REPEAT_MESSAGE, NM_STATE_REPEAT_MESSAGE);
+	uint32 value = 0;
+
+	if (reader->Position + bytes > reader->Size) {
+		reader->Valid = FALSE;
+		return 0;
 	}
+	for (uint8 index = 0; index < bytes; index++) {
+		value |= (uint32)reader->Buffer[reader->Position++] << (8 * index);
+	}
+	return value;
 }
 
-static inline void CanNm_Internal_RepeatMessage_to_ReadySleep( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Returns the bytes in place, NULL past the end of the blob */
+static inline const uint8* CanNm_Internal_StateGetBytes( CanNm_Internal_StateReaderType* reader, uint32 length )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_READY_SLEEP;
-	ChannelInternal->TxEnabled = FALSE;																//[SWS_CanNm_00108]
-	if (ChannelConf->NodeDetectionEnabled) {
-		CanNm_Internal_ClearPduCbv(ChannelConf, ChannelInternal);									//[SWS_CanNm_00107]
+	const uint8* data = &reader->Buffer[reader->Position];
+
+	if (reader->Position + length > reader->Size) {
+		reader->Valid = FALSE;
+		return NULL;
 	}
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_REPEAT_MESSAGE, NM_STATE_READY_SLEEP);
+	reader->Position += length;
+	return data;
+}
+
+static uint32 CanNm_Internal_StateCrc( const uint8* data, uint32 length )
+{
+	uint32 crc = 0xFFFFFFFFUL;
+
+	for (uint32 index = 0; index < length; index++) {
+		crc ^= data[index];
+		for (uint8 bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));						//CRC-32, reflected
+		}
 	}
+	return ~crc;
 }
 
-static inline void CanNm_Internal_RepeatMessage_to_NormalOperation( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Timers are saved only where their deadline or remaining ticks are not zero, PDU buffers with their length */
+static void CanNm_Internal_SaveChannel( CanNm_Internal_StateWriterType* writer, NetworkHandleType channel )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_NORMAL_OPERATION;
-	if (ChannelConf->BusLoadReductionActive) {
-		ChannelInternal->BusLoadReduction = TRUE;													//[SWS_CanNm_00157]
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	const CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	const CanNm_Internal_PduBuffersType* Pdus = &CanNm_Internal.Pdus[channel];
+	PduLengthType txLength = ChannelConf->TxPdu->TxPduRef->SduLength;
+	uint8 deadlineMask = 0;
+
+	CanNm_Internal_LazyInit(channel);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	for (uint8 timer = 0; timer < CANNM_TIMER_COUNT; timer++) {
+		deadlineMask |= (ChannelInternal->Deadlines[timer] != 0) ? (uint8)(1U << timer) : 0;
 	}
-	if (ChannelConf->NodeDetectionEnabled) {
-		CanNm_Internal_ClearPduCbv(ChannelConf, ChannelInternal);									//[SWS_CanNm_00107]
+	CanNm_Internal_StatePut(writer, ChannelInternal->State, 1);
+	CanNm_Internal_StatePut(writer, ChannelInternal->Mode, 1);
+	CanNm_Internal_StatePut(writer, (ChannelInternal->Requested ? CANNM_STATE_REQUESTED : 0) |
+	 (ChannelInternal->TxEnabled ? CANNM_STATE_TX_ENABLED : 0) |
+	 (ChannelInternal->BusLoadReduction ? CANNM_STATE_BUS_LOAD_REDUCTION : 0) |
+	 (ChannelInternal->RemoteSleepInd ? CANNM_STATE_REMOTE_SLEEP_IND : 0) |
+	 (ChannelInternal->RemoteSleepIndEnabled ? CANNM_STATE_REMOTE_SLEEP_IND_ENABLED : 0) |
+	 (ChannelInternal->NmPduFilterAlgorithm ? CANNM_STATE_PDU_FILTER_ALGORITHM : 0) |
+	 (ChannelInternal->TxPending ? CANNM_STATE_TX_PENDING : 0), 1);
+	CanNm_Internal_StatePut(writer, (uint8)ChannelInternal->RxLastPdu, 1);
+	CanNm_Internal_StatePut(writer, ChannelInternal->ImmediateTransmissions, 1);
+	CanNm_Internal_StatePut(writer, ChannelInternal->TxRetries, 1);
+	CanNm_Internal_StatePut(writer, ChannelInternal->TimersStarted, 1);
+	CanNm_Internal_StatePut(writer, deadlineMask, 1);
+	for (uint8 timer = 0; timer < CANNM_TIMER_COUNT; timer++) {
+		if (deadlineMask & (1U << timer)) {
+			CanNm_Internal_StatePut(writer, ChannelInternal->Deadlines[timer], 4);
+		}
 	}
-	if (CanNm_ConfigPtr->RemoteSleepIndEnabled) {													//[SWS_CanNm_00149]
-		CanNm_Internal_TimerStart(&ChannelInternal->RemoteSleepIndTimer, ChannelConf->RemoteSleepIndTime);
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+	CanNm_Internal_StatePut(writer, txLength, 2);
+	CanNm_Internal_StatePutBytes(writer, Pdus->Tx, txLength);								//NID, CBV and user data
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+
+	if (ChannelInternal->RxLastPdu != NO_PDU_RECEIVED) {
+		PduLengthType rxLength = ChannelConf->RxPdu[ChannelInternal->RxLastPdu]->RxPduRef->SduLength;
+
+		CanNm_Internal_StatePut(writer, rxLength, 2);
+		CanNm_Internal_StatePutBytes(writer, Pdus->Rx, rxLength);
 	}
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_REPEAT_MESSAGE, NM_STATE_NORMAL_OPERATION);
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	CanNm_Internal_StatePut(writer, CanNm_Internal.Notifications[channel].Count, 1);
+	for (uint8 index = 0; index < CanNm_Internal.Notifications[channel].Count; index++) {
+		const CanNm_Internal_NotificationType* notification = &CanNm_Internal.Notifications[channel].Records[index];
+
+		CanNm_Internal_StatePut(writer, notification->Kind, 1);
+		CanNm_Internal_StatePut(writer, notification->Arg0, 1);
+		CanNm_Internal_StatePut(writer, notification->Arg1, 1);
 	}
+#else
+	CanNm_Internal_StatePut(writer, 0, 1);
+#endif
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
 }
 
-static inline void CanNm_Internal_NormalOperation_to_RepeatMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Reads and checks the record of a channel against its configuration, stores it only with apply */
+static boolean CanNm_Internal_RestoreChannel( CanNm_Internal_StateReaderType* reader, NetworkHandleType channel, boolean apply )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_REPEAT_MESSAGE;
-	ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00156]
-	CanNm_Internal_TimerStart(&ChannelInternal->RepeatMessageTimer, ChannelConf->RepeatMessageTime);//[SWS_CanNm_00102]
-	CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgCycleOffset);	//[SWS_CanNm_00100]
-	if (ChannelInternal->RemoteSleepInd) {
-		ChannelInternal->RemoteSleepInd = FALSE;
-		Nm_RemoteSleepCancellation(ChannelInternal->Channel);										//[SWS_CanNm_00151]
+	const CanNm_ChannelType* ChannelConf = CanNm_Internal_GetChannelConf(channel);
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[channel];
+	CanNm_Internal_PduBuffersType* Pdus = &CanNm_Internal.Pdus[channel];
+	PduLengthType txLength = ChannelConf->TxPdu->TxPduRef->SduLength;
+	PduLengthType rxLength = 0;
+	uint32 deadlines[CANNM_TIMER_COUNT] = { 0 };
+	uint8 state = (uint8)CanNm_Internal_StateGet(reader, 1);
+	uint8 mode = (uint8)CanNm_Internal_StateGet(reader, 1);
+	uint8 flags = (uint8)CanNm_Internal_StateGet(reader, 1);
+	sint32 rxLastPdu = (sint8)CanNm_Internal_StateGet(reader, 1);	//Wider than both NO_PDU_RECEIVED and CANNM_RXPDU_MAX_COUNT
+	uint8 immediateTransmissions = (uint8)CanNm_Internal_StateGet(reader, 1);
+	uint8 txRetries = (uint8)CanNm_Internal_StateGet(reader, 1);
+	uint8 timersStarted = (uint8)CanNm_Internal_StateGet(reader, 1);
+	uint8 deadlineMask = (uint8)CanNm_Internal_StateGet(reader, 1);
+	const uint8* txData;
+	const uint8* rxData = NULL;
+	const uint8* notifications;
+	uint8 notificationCount;
+
+	for (uint8 timer = 0; timer < CANNM_TIMER_COUNT; timer++) {
+		if (deadlineMask & (1U << timer)) {
+			deadlines[timer] = CanNm_Internal_StateGet(reader, 4);
+		}
+	}
+	if (state > NM_STATE_SYNCHRONIZE || mode > NM_MODE_NETWORK || (timersStarted >> CANNM_TIMER_COUNT) != 0 ||
+	 (deadlineMask >> CANNM_TIMER_COUNT) != 0 || txLength > CANNM_PDU_MAX_LENGTH ||
+	 CanNm_Internal_StateGet(reader, 2) != txLength) {
+		return FALSE;
+	}
+	txData = CanNm_Internal_StateGetBytes(reader, txLength);
+	if (rxLastPdu != NO_PDU_RECEIVED) {
+		if (rxLastPdu < 0 || rxLastPdu >= CANNM_RXPDU_MAX_COUNT || ChannelConf->RxPdu[rxLastPdu] == NULL) {
+			return FALSE;
+		}
+		rxLength = ChannelConf->RxPdu[rxLastPdu]->RxPduRef->SduLength;
+		if (rxLength > CANNM_PDU_MAX_LENGTH || CanNm_Internal_StateGet(reader, 2) != rxLength) {
+			return FALSE;
+		}
+		rxData = CanNm_Internal_StateGetBytes(reader, rxLength);
+	}
+	notificationCount = (uint8)CanNm_Internal_StateGet(reader, 1);
+	notifications = CanNm_Internal_StateGetBytes(reader, 3UL * notificationCount);
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	if (notificationCount > CANNM_NOTIFICATION_QUEUE_SIZE) {
+		return FALSE;
+	}
+	for (uint8 index = 0; index < notificationCount && notifications != NULL; index++) {
+		if (notifications[3 * index] > CANNM_NOTIFICATION_PDU_RX) {
+			return FALSE;
+		}
+	}
+#else
+	(void)notifications;
+	if (notificationCount != 0) {
+		return FALSE;
+	}
+#endif
+	if (!reader->Valid || !apply) {
+		return reader->Valid;
+	}
+
+	CanNm_Internal_LazyInit(channel);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	ChannelInternal->State = state;
+	ChannelInternal->Mode = mode;
+	ChannelInternal->Requested = (flags & CANNM_STATE_REQUESTED) != 0;
+	ChannelInternal->TxEnabled = (flags & CANNM_STATE_TX_ENABLED) != 0;
+	ChannelInternal->BusLoadReduction = (flags & CANNM_STATE_BUS_LOAD_REDUCTION) != 0;
+	ChannelInternal->RemoteSleepInd = (flags & CANNM_STATE_REMOTE_SLEEP_IND) != 0;
+	ChannelInternal->RemoteSleepIndEnabled = (flags & CANNM_STATE_REMOTE_SLEEP_IND_ENABLED) != 0;
+	ChannelInternal->NmPduFilterAlgorithm = (flags & CANNM_STATE_PDU_FILTER_ALGORITHM) != 0;
+	ChannelInternal->TxPending = (flags & CANNM_STATE_TX_PENDING) != 0;
+	ChannelInternal->RxLastPdu = (sint8)rxLastPdu;
+	ChannelInternal->ImmediateTransmissions = immediateTransmissions;
+	ChannelInternal->TxRetries = txRetries;
+	ChannelInternal->TimersStarted = timersStarted;
+	memcpy(ChannelInternal->Deadlines, deadlines, sizeof(ChannelInternal->Deadlines));
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+	memcpy(Pdus->Tx, txData, txLength);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+
+	if (rxData != NULL) {
+		memcpy(Pdus->Rx, rxData, rxLength);
+	}
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	CanNm_Internal.Notifications[channel].Count = notificationCount;
+	for (uint8 index = 0; index < notificationCount; index++) {
+		CanNm_Internal.Notifications[channel].Records[index].Kind = notifications[3 * index];
+		CanNm_Internal.Notifications[channel].Records[index].Arg0 = notifications[(3 * index) + 1];
+		CanNm_Internal.Notifications[channel].Records[index].Arg1 = notifications[(3 * index) + 2];
+	}
+#endif
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+	__atomic_store_n(&CanNm_Internal.Statistics[channel].StateEnteredTick, CanNm_Internal.MainFunctionTicks,
+	 __ATOMIC_RELAXED);																	//Restored state counts from here
+#endif
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+	CanNm_Internal.Latency[channel].Pending = 0;										//Started on the old time base
+#endif
+	CanNm_Internal_UpdateSleepReady(ChannelInternal);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	return TRUE;
+}
+
+/* Called once to check the whole blob and, only if it is valid, once more to store it */
+static boolean CanNm_Internal_RestoreState( const uint8* buffer, uint32 length, boolean apply )
+{
+	CanNm_Internal_StateReaderType reader = { .Buffer = buffer, .Size = length - 4, .Position = 0, .Valid = TRUE };
+	uint32 deadlineChannels[CANNM_SLEEP_READY_WORDS] = { 0 };			//Bit per channel with a deadline
+	uint32 ticks;
+	uint32 clustersReady;
+	boolean clustersChanged;
+	uint32 deadlineCount;
+
+	if (CanNm_Internal_StateGet(&reader, 4) != CANNM_STATE_MAGIC || CanNm_Internal_StateGet(&reader, 2) != CANNM_STATE_VERSION ||
+	 CanNm_Internal_StateGet(&reader, 2) != CANNM_CHANNEL_COUNT || CanNm_Internal_StateGet(&reader, 2) != CANNM_CONTROLLER_COUNT ||
+	 CanNm_Internal_StateGet(&reader, 4) != length) {
+		return FALSE;
+	}
+	ticks = CanNm_Internal_StateGet(&reader, 4);
+	clustersReady = CanNm_Internal_StateGet(&reader, 4);
+	clustersChanged = (CanNm_Internal_StateGet(&reader, 1) != 0);
+	deadlineCount = CanNm_Internal_StateGet(&reader, 2);
+	if (deadlineCount > CANNM_CHANNEL_COUNT) {
+		return FALSE;
+	}
+	if (apply) {
+		CanNm_Internal.MainFunctionTicks = ticks;
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+		CanNm_Internal_TxDeadlinesInit();
+	}
+	for (uint32 index = 0; index < deadlineCount; index++) {				//Heap rebuilt entry by entry, not trusted
+		uint32 channel = CanNm_Internal_StateGet(&reader, 2);
+		uint32 deadline = CanNm_Internal_StateGet(&reader, 4);
+
+		if (channel >= CANNM_CHANNEL_COUNT || (deadlineChannels[channel / 32] & CANNM_SLEEP_READY_BIT(channel)) != 0) {
+			return FALSE;													//At most one deadline per channel
+		}
+		deadlineChannels[channel / 32] |= CANNM_SLEEP_READY_BIT(channel);
+		if (apply) {
+			CanNm_Internal_TxDeadlineInsert((NetworkHandleType)channel, deadline);
+		}
+	}
+	if (apply) {
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXSUPERVISION, 0);
+	}
+	for (uint8 controller = 0; controller < CANNM_CONTROLLER_COUNT; controller++) {
+		CanNm_Internal_TxLimiterType* limiter = &CanNm_Internal.TxLimiters[controller];
+		uint32 tokens = CanNm_Internal_StateGet(&reader, 4);
+		uint32 lastTick = CanNm_Internal_StateGet(&reader, 4);
+
+		if (apply) {
+			SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+			limiter->Tokens = (tokens < limiter->Capacity) ? tokens : limiter->Capacity;	//Bucket size may have changed
+			limiter->LastTick = lastTick;
+			SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXLIMITER, controller);
+		}
+	}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		if (!CanNm_Internal_RestoreChannel(&reader, channel, apply)) {
+			return FALSE;
+		}
 	}
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_NORMAL_OPERATION, NM_STATE_REPEAT_MESSAGE);
+	if (apply) {
+		CanNm_Internal.SleepReady.ClustersReady = clustersReady & CanNm_Internal.SleepReady.ClustersUsed;
+		CanNm_Internal.SleepReady.Changed = clustersChanged;
 	}
+	return reader.Valid && reader.Position == reader.Size;
 }
 
-static inline void CanNm_Internal_NormalOperation_to_NormalOperation( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+static boolean CanNm_Internal_ImageTableValid( const CanNm_ImageHeaderType* Header, const CanNm_ImageTableType* Table,
+ 												uint32 entrySize )
 {
-	CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);			//[SWS_CanNm_00117]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_NORMAL_OPERATION, NM_STATE_NORMAL_OPERATION);
+	if (Table->Count == 0) {
+		return TRUE;
 	}
+	return (Table->Offset % CANNM_IMAGE_ALIGNMENT) == 0 && Table->Offset >= sizeof(CanNm_ImageHeaderType) &&
+	 (uint64)Table->Offset + ((uint64)Table->Count * entrySize) <= Header->Length;
 }
 
-static inline void CanNm_Internal_NormalOperation_to_ReadySleep( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+static boolean CanNm_Internal_ImageChannelValid( const CanNm_ImageHeaderType* Header, const CanNm_ImageChannelType* Channel )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_READY_SLEEP;
-	ChannelInternal->TxEnabled = FALSE;																//[SWS_CanNm_00108]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_NORMAL_OPERATION, NM_STATE_READY_SLEEP);
+	const float32 times[] = {
+		Channel->ImmediateNmCycleTime, Channel->MsgCycleOffset, Channel->MsgCycleTime, Channel->MsgReducedTime,
+		Channel->MsgTimeoutTime, Channel->RemoteSleepIndTime, Channel->RepeatMessageTime, Channel->TimeoutTime,
+		Channel->TxRetryMaxTime, Channel->TxRetryTime, Channel->WaitBusSleepTime
+	};
+
+	for (uint32 index = 0; index < sizeof(times) / sizeof(times[0]); index++) {
+		if (!(times[index] >= 0.0f)) {																//NaN as well
+			return FALSE;
+		}
+	}
+	if (Channel->RxPduCount == 0 || Channel->RxPduCount > CANNM_RXPDU_MAX_COUNT ||
+	 (uint64)Channel->RxPduIndex + Channel->RxPduCount > Header->RxPduIds.Count) {
+		return FALSE;
 	}
+	if (Channel->PduLength == 0 || Channel->PduLength > CANNM_PDU_MAX_LENGTH ||
+	 (Channel->PduCbvPosition != CANNM_PDU_OFF && Channel->PduCbvPosition >= Channel->PduLength) ||
+	 (Channel->PduNidPosition != CANNM_PDU_OFF && Channel->PduNidPosition >= Channel->PduLength) ||
+	 (Channel->PduCbvPosition > CANNM_PDU_BYTE_1 && Channel->PduCbvPosition != CANNM_PDU_OFF) ||
+	 (Channel->PduNidPosition > CANNM_PDU_BYTE_1 && Channel->PduNidPosition != CANNM_PDU_OFF)) {
+		return FALSE;
+	}
+	return Channel->TxRetryPolicy <= CANNM_TX_RETRY_EXPONENTIAL &&
+	 (Channel->ControllerIndex < CANNM_CONTROLLER_COUNT || Channel->ControllerIndex == CANNM_CONTROLLER_NONE) &&
+	 (Channel->CoordClusterIndex < CANNM_COORD_CLUSTER_COUNT || Channel->CoordClusterIndex == CANNM_COORD_CLUSTER_NONE) &&
+	 Channel->ComMNetworkHandleRef <= (NetworkHandleType)~0U;
 }
 
-static inline void CanNm_Internal_ReadySleep_to_NormalOperation( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Everything CanNm_Internal_ImageBind and the module read from the image is checked here */
+static boolean CanNm_Internal_ImageValid( const uint8* image, uint32 length )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_NORMAL_OPERATION;
-	if (!CanNm_ConfigPtr->PassiveModeEnabled) {
-		ChannelInternal->TxEnabled = TRUE;
+	const CanNm_ImageHeaderType* Header = (const CanNm_ImageHeaderType*)image;
+
+	if (image == NULL || ((size_t)image % CANNM_IMAGE_ALIGNMENT) != 0 || length < sizeof(CanNm_ImageHeaderType)) {
+		return FALSE;
+	}
+	if (Header->Magic != CANNM_IMAGE_MAGIC || Header->Version != CANNM_IMAGE_VERSION ||
+	 Header->ByteOrder != CANNM_IMAGE_BYTE_ORDER || Header->HeaderSize != sizeof(CanNm_ImageHeaderType) ||
+	 Header->ChannelSize != sizeof(CanNm_ImageChannelType) || Header->HandleSize != sizeof(NetworkHandleType) ||
+	 Header->Length < sizeof(CanNm_ImageHeaderType) || Header->Length > length) {
+		return FALSE;
+	}
+	if (!CanNm_Internal_ImageTableValid(Header, &Header->Channels, sizeof(CanNm_ImageChannelType)) ||
+	 !CanNm_Internal_ImageTableValid(Header, &Header->RxPduIds, sizeof(PduIdType)) ||
+	 !CanNm_Internal_ImageTableValid(Header, &Header->RxPduChannelMap, sizeof(NetworkHandleType)) ||
+	 !CanNm_Internal_ImageTableValid(Header, &Header->Controllers, sizeof(CanNm_ControllerType)) ||
+	 !CanNm_Internal_ImageTableValid(Header, &Header->PnFilterMaskBytes, sizeof(CanNm_PnFilterMaskByte))) {
+		return FALSE;
+	}
+	if (Header->Channels.Count != CANNM_CHANNEL_COUNT || Header->RxPduChannelMap.Count > (PduIdType)~0U ||
+	 (Header->Controllers.Count != 0 && Header->Controllers.Count != CANNM_CONTROLLER_COUNT) ||
+	 !(Header->MainFunctionPeriod > 0.0f) || !(Header->PnResetTime >= 0.0f) || !(Header->WakeUpStaggerTime >= 0.0f) ||
+	 Header->WakeUpStagger > CANNM_WAKEUP_STAGGER_HASH || Header->PnInfoLength > 7 || Header->PnInfoOffset > 7) {
+		return FALSE;
 	}
-	if (ChannelConf->BusLoadReductionActive) {
-		ChannelInternal->BusLoadReduction = TRUE;													//[SWS_CanNm_00157]
+
+	const CanNm_ImageChannelType* Channels = (const CanNm_ImageChannelType*)&image[Header->Channels.Offset];
+	const NetworkHandleType* RxPduChannelMap = (const NetworkHandleType*)&image[Header->RxPduChannelMap.Offset];
+
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		if (!CanNm_Internal_ImageChannelValid(Header, &Channels[channel])) {
+			return FALSE;
+		}
 	}
-	CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgCycleOffset);	//[SWS_CanNm_00006][SWS_CanNm_00116]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_READY_SLEEP, NM_STATE_NORMAL_OPERATION);
+	for (uint32 id = 0; id < Header->RxPduChannelMap.Count; id++) {
+		if (RxPduChannelMap[id] >= CANNM_CHANNEL_COUNT && RxPduChannelMap[id] != CANNM_INVALID_CHANNEL) {
+			return FALSE;
+		}
 	}
+	return TRUE;
 }
 
-static inline void CanNm_Internal_ReadySleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+static void CanNm_Internal_ImageBind( const uint8* image )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_REPEAT_MESSAGE;
-	if (!CanNm_ConfigPtr->PassiveModeEnabled) {
-		ChannelInternal->TxEnabled = TRUE;
+	const CanNm_ImageHeaderType* Header = (const CanNm_ImageHeaderType*)image;
+	const CanNm_ImageChannelType* Channels = (const CanNm_ImageChannelType*)&image[Header->Channels.Offset];
+	const PduIdType* RxPduIds = (const PduIdType*)&image[Header->RxPduIds.Offset];
+	CanNm_Internal_ImageType* Image = &CanNm_Internal_Image;
+
+	for (PduLengthType length = 0; length <= CANNM_PDU_MAX_LENGTH; length++) {
+		Image->PduInfos[length].SduDataPtr = NULL;
+		Image->PduInfos[length].SduLength = length;
 	}
-	ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00156]
-	CanNm_Internal_TimerStart(&ChannelInternal->RepeatMessageTimer, ChannelConf->RepeatMessageTime);//[SWS_CanNm_00102]
-	CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgCycleOffset);	//[SWS_CanNm_00100]
-	if (ChannelInternal->RemoteSleepInd) {
-		ChannelInternal->RemoteSleepInd = FALSE;
-		Nm_RemoteSleepCancellation(ChannelInternal->Channel);										//[SWS_CanNm_00151]
+	Image->PnInfo.PnInfoLength = Header->PnInfoLength;
+	Image->PnInfo.PnInfoOffset = Header->PnInfoOffset;
+	Image->PnInfo.PnFilterMaskByte = (Header->PnFilterMaskBytes.Count != 0) ?
+	 (const CanNm_PnFilterMaskByte*)&image[Header->PnFilterMaskBytes.Offset] : NULL;
+	Image->Config = (CanNm_ConfigType){
+		.BusLoadReductionEnabled		= Header->BusLoadReductionEnabled,
+		.BusSynchronizationEnabled		= Header->BusSynchronizationEnabled,
+		.Callbacks						= NULL,
+		.ComControlEnabled				= Header->ComControlEnabled,
+		.ComUserDataSupport				= Header->ComUserDataSupport,
+		.CoordinationSyncSupport		= Header->CoordinationSyncSupport,
+		.DeferredNotificationsEnabled	= Header->DeferredNotificationsEnabled,
+		.DevErrorDetect					= Header->DevErrorDetect,
+		.GlobalPnSupport				= Header->GlobalPnSupport,
+		.ImmediateRestartEnabled		= Header->ImmediateRestartEnabled,
+		.ImmediateTxConfEnabled			= Header->ImmediateTxConfEnabled,
+		.LazyInitEnabled				= Header->LazyInitEnabled,
+		.MainFunctionPeriod				= Header->MainFunctionPeriod,
+		.PassiveModeEnabled				= Header->PassiveModeEnabled,
+		.PduRxIndicationEnabled			= Header->PduRxIndicationEnabled,
+		.PnEiraCalcEnabled				= Header->PnEiraCalcEnabled,
+		.PnInfo							= Header->PnInfoEnabled ? &Image->PnInfo : NULL,
+		.PnResetTime					= Header->PnResetTime,
+		.RemoteSleepIndEnabled			= Header->RemoteSleepIndEnabled,
+		.StateChangeIndEnabled			= Header->StateChangeIndEnabled,
+		.UserDataEnabled				= Header->UserDataEnabled,
+		.VersionInfoApi					= Header->VersionInfoApi,
+		.RxPduChannelMap				= (Header->RxPduChannelMap.Count != 0) ?
+		 (const NetworkHandleType*)&image[Header->RxPduChannelMap.Offset] : NULL,
+		.RxPduCount						= (PduIdType)Header->RxPduChannelMap.Count,
+		.WakeUpStaggerTime				= Header->WakeUpStaggerTime,
+		.WakeUpStagger					= (CanNm_WakeUpStaggerType)Header->WakeUpStagger,
+		.ControllerConfig				= (Header->Controllers.Count != 0) ?
+		 (const CanNm_ControllerType*)&image[Header->Controllers.Offset] : NULL
+	};
+
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		const CanNm_ImageChannelType* Source = &Channels[channel];
+		const PduInfoType* PduInfo = &Image->PduInfos[Source->PduLength];
+		CanNm_ChannelType* ChannelConf = &Image->Channels[channel];
+
+		Image->TxPdus[channel].TxConfirmationPduId = Source->TxConfirmationPduId;
+		Image->TxPdus[channel].TxPduRef = PduInfo;
+		Image->UserDataTxPdus[channel].TxUserDataPduId = Source->TxUserDataPduId;
+		Image->UserDataTxPdus[channel].TxUserDataPduRef = PduInfo;
+		for (uint8 index = 0; index < Source->RxPduCount; index++) {
+			Image->RxPdus[channel][index].RxPduId = RxPduIds[Source->RxPduIndex + index];
+			Image->RxPdus[channel][index].RxPduRef = PduInfo;
+		}
+		*ChannelConf = (CanNm_ChannelType){
+			.ActiveWakeupBitEnabled			= Source->ActiveWakeupBitEnabled,
+			.AllNmMessagesKeepAwake			= Source->AllNmMessagesKeepAwake,
+			.BusLoadReductionActive			= Source->BusLoadReductionActive,
+			.CarWakeUpBitPosition			= Source->CarWakeUpBitPosition,
+			.CarWakeUpFilterEnabled			= Source->CarWakeUpFilterEnabled,
+			.CarWakeUpFilterNodeId			= Source->CarWakeUpFilterNodeId,
+			.CarWakeUpRxEnabled				= Source->CarWakeUpRxEnabled,
+			.ControllerIndex				= Source->ControllerIndex,
+			.CoordClusterIndex				= Source->CoordClusterIndex,
+			.ImmediateNmCycleTime			= Source->ImmediateNmCycleTime,
+			.ImmediateNmTransmissions		= Source->ImmediateNmTransmissions,
+			.MsgCycleOffset					= Source->MsgCycleOffset,
+			.MsgCycleTime					= Source->MsgCycleTime,
+			.MsgReducedTime					= Source->MsgReducedTime,
+			.MsgTimeoutTime					= Source->MsgTimeoutTime,
+			.NodeDetectionEnabled			= Source->NodeDetectionEnabled,
+			.NodeId							= Source->NodeId,
+			.NodeIdEnabled					= Source->NodeIdEnabled,
+			.PduCbvPosition					= (CanNm_PduBytePositionType)Source->PduCbvPosition,
+			.PduNidPosition					= (CanNm_PduBytePositionType)Source->PduNidPosition,
+			.PnEnabled						= Source->PnEnabled,
+			.PnEraCalcEnabled				= Source->PnEraCalcEnabled,
+			.PnHandleMultipleNetworkRequests = Source->PnHandleMultipleNetworkRequests,
+			.RemoteSleepIndTime				= Source->RemoteSleepIndTime,
+			.RepeatMessageTime				= Source->RepeatMessageTime,
+			.RepeatMsgIndEnabled			= Source->RepeatMsgIndEnabled,
+			.TimeoutTime					= Source->TimeoutTime,
+			.TxPdu							= &Image->TxPdus[channel],
+			.TxRetryLimit					= Source->TxRetryLimit,
+			.TxRetryMaxTime					= Source->TxRetryMaxTime,
+			.TxRetryPolicy					= (CanNm_TxRetryPolicyType)Source->TxRetryPolicy,
+			.TxRetryTime					= Source->TxRetryTime,
+			.UserDataTxPdu					= &Image->UserDataTxPdus[channel],
+			.WaitBusSleepTime				= Source->WaitBusSleepTime,
+			.ComMNetworkHandleRef			= (NetworkHandleType)Source->ComMNetworkHandleRef
+		};
+		/* The RxPdu slots form the reception ring, channels with fewer Rx PDUs reuse them round robin */
+		for (uint32 slot = 0; slot < CANNM_RXPDU_MAX_COUNT; slot++) {
+			ChannelConf->RxPdu[slot] = &Image->RxPdus[channel][slot % Source->RxPduCount];
+		}
+		Image->Config.ChannelConfig[channel] = ChannelConf;
 	}
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_READY_SLEEP, NM_STATE_REPEAT_MESSAGE);
+}
+#endif
+
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+/* Only parameters can change online: feature switches, main function period, PDU ids, lengths and layout, controller and
+   cluster membership have to stay as they are, timing, node identifiers, token buckets, wake-up staggering and PN
+   information may differ */
+static boolean CanNm_Internal_ReconfigureValid( const CanNm_ConfigType* Current, const CanNm_ConfigType* Next )
+{
+	if (Next->Callbacks != Current->Callbacks || Next->MainFunctionPeriod != Current->MainFunctionPeriod ||
+	 Next->ComUserDataSupport != Current->ComUserDataSupport ||
+	 Next->CoordinationSyncSupport != Current->CoordinationSyncSupport ||
+	 Next->DeferredNotificationsEnabled != Current->DeferredNotificationsEnabled ||
+	 Next->GlobalPnSupport != Current->GlobalPnSupport || Next->ImmediateRestartEnabled != Current->ImmediateRestartEnabled ||
+	 Next->LazyInitEnabled != Current->LazyInitEnabled || Next->PassiveModeEnabled != Current->PassiveModeEnabled ||
+	 Next->PduRxIndicationEnabled != Current->PduRxIndicationEnabled ||
+	 Next->RemoteSleepIndEnabled != Current->RemoteSleepIndEnabled ||
+	 Next->StateChangeIndEnabled != Current->StateChangeIndEnabled || Next->UserDataEnabled != Current->UserDataEnabled ||
+	 (Next->RxPduChannelMap == NULL) != (Current->RxPduChannelMap == NULL) || Next->RxPduCount != Current->RxPduCount) {
+		return FALSE;
+	}
+	if (Next->RxPduChannelMap != NULL &&
+	 memcmp(Next->RxPduChannelMap, Current->RxPduChannelMap, Next->RxPduCount * sizeof(NetworkHandleType)) != 0) {
+		return FALSE;
+	}
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		const CanNm_ChannelType* CurrentConf = Current->ChannelConfig[channel];
+		const CanNm_ChannelType* NextConf = Next->ChannelConfig[channel];
+
+		if (NextConf == NULL || NextConf->TxPdu == NULL || NextConf->TxPdu->TxPduRef == NULL ||
+		 NextConf->TxPdu->TxConfirmationPduId != CurrentConf->TxPdu->TxConfirmationPduId ||
+		 NextConf->TxPdu->TxPduRef->SduLength != CurrentConf->TxPdu->TxPduRef->SduLength ||
+		 (NextConf->UserDataTxPdu == NULL) != (CurrentConf->UserDataTxPdu == NULL) ||
+		 NextConf->PduCbvPosition != CurrentConf->PduCbvPosition || NextConf->PduNidPosition != CurrentConf->PduNidPosition ||
+		 NextConf->NodeIdEnabled != CurrentConf->NodeIdEnabled || NextConf->ControllerIndex != CurrentConf->ControllerIndex ||
+		 NextConf->CoordClusterIndex != CurrentConf->CoordClusterIndex ||
+		 NextConf->ComMNetworkHandleRef != CurrentConf->ComMNetworkHandleRef) {
+			return FALSE;
+		}
+		if (NextConf->UserDataTxPdu != NULL &&
+		 NextConf->UserDataTxPdu->TxUserDataPduId != CurrentConf->UserDataTxPdu->TxUserDataPduId) {
+			return FALSE;
+		}
+		for (uint32 slot = 0; slot < CANNM_RXPDU_MAX_COUNT; slot++) {
+			const CanNm_RxPdu* CurrentRxPdu = CurrentConf->RxPdu[slot];
+			const CanNm_RxPdu* NextRxPdu = NextConf->RxPdu[slot];
+
+			if ((NextRxPdu == NULL) != (CurrentRxPdu == NULL) || (NextRxPdu != NULL && (NextRxPdu->RxPduId != CurrentRxPdu->RxPduId ||
+			 NextRxPdu->RxPduRef->SduLength != CurrentRxPdu->RxPduRef->SduLength))) {
+				return FALSE;
+			}
+		}
+	}
+	return TRUE;
+}
+
+/* An active channel switches between two NM PDUs: no immediate transmission left and none waiting for confirmation */
+static inline boolean CanNm_Internal_ReconfigureSafe( const CanNm_Internal_ChannelType* ChannelInternal,
+ 														NetworkHandleType channel )
+{
+	return ChannelInternal->Mode == NM_MODE_BUS_SLEEP || (ChannelInternal->ImmediateTransmissions == 0 &&
+	 __atomic_load_n(&CanNm_Internal.TxSupervision.Positions[channel], __ATOMIC_RELAXED) == CANNM_TX_DEADLINE_NONE);
+}
+
+/* Drop the retained configuration of a channel for the published one, under the channel exclusive area. Running timers
+   keep their expiry, the next restart uses the new times. */
+static inline void CanNm_Internal_AdoptConfig( CanNm_Internal_ChannelType* ChannelInternal, NetworkHandleType channel )
+{
+	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[channel];
+
+	ChannelInternal->ReducedCycleTicks = CanNm_Internal_GetReducedCycleTicks(ChannelConf, CanNm_ConfigPtr->MainFunctionPeriod);
+	if (ChannelConf->NodeIdEnabled && ChannelConf->PduNidPosition != CANNM_PDU_OFF) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
+		CanNm_Internal.Pdus[channel].Tx[ChannelConf->PduNidPosition] = ChannelConf->NodeId;		//[SWS_CanNm_00013]
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, channel);
 	}
+	__atomic_store_n(&ChannelInternal->RetainedConf, NULL, __ATOMIC_RELEASE);
+	__atomic_fetch_sub(&CanNm_Internal.ChannelsRetainingConfig, 1, __ATOMIC_RELEASE);
 }
+#endif
 
-static inline void CanNm_Internal_ReadySleep_to_PrepareBusSleep( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal ) {
-	ChannelInternal->Mode = NM_MODE_PREPARE_BUS_SLEEP;
-	ChannelInternal->State = NM_STATE_PREPARE_BUS_SLEEP;
-	CanNm_Internal_TimerStart(&ChannelInternal->WaitBusSleepTimer, ChannelConf->WaitBusSleepTime);	//[SWS_CanNm_00115]
-	Nm_PrepareBusSleepMode(ChannelInternal->Channel);												//[SWS_CanNm_00114]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_READY_SLEEP, NM_STATE_PREPARE_BUS_SLEEP);
+static inline void CanNm_Internal_StateChanged( const CanNm_Internal_ChannelType* ChannelInternal, Nm_StateType PreviousState, Nm_StateType NextState )
+{
+	CANNM_TRACE(ChannelInternal->Channel, CANNM_TRACE_EVENT_TRANSITION, PreviousState, NextState);
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+	CanNm_Internal_StatisticsType* statistics = &CanNm_Internal.Statistics[ChannelInternal->Channel];
+	uint32 now = CanNm_Internal.MainFunctionTicks;
+
+	if (PreviousState != NextState) {
+		__atomic_fetch_add(&statistics->StateTicks[PreviousState], now - statistics->StateEnteredTick, __ATOMIC_RELAXED);
+		__atomic_store_n(&statistics->StateEnteredTick, now, __ATOMIC_RELAXED);
 	}
+#else
+	(void)ChannelInternal;
+	(void)PreviousState;
+	(void)NextState;
+#endif
 }
 
-static inline void CanNm_Internal_PrepareBusSleep_to_RepeatMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Called under the channel exclusive area, immediate notifications are made as callouts once it is left. Deferred, a
+   state change directly following a queued one is merged into it (first previous state, last next state) and dropped
+   when it ends where it began, as are repeated PDU receptions. A network start or a state change staying in its state
+   is not queued twice, so that receptions in Bus-Sleep keep one set of records */
+static inline void CanNm_Internal_Notify( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind, uint8 arg0, uint8 arg1 )
 {
-	ChannelInternal->Mode = NM_MODE_NETWORK;
-	ChannelInternal->State = NM_STATE_REPEAT_MESSAGE;
-	ChannelInternal->BusLoadReduction = FALSE;														//[SWS_CanNm_00156]
-	CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);			//[SWS_CanNm_00096]
-	CanNm_Internal_TimerStart(&ChannelInternal->RepeatMessageTimer, ChannelConf->RepeatMessageTime);//[SWS_CanNm_00102]
-	CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, ChannelConf->MsgCycleOffset);	//[SWS_CanNm_00100]
-	Nm_NetworkMode(ChannelInternal->Channel);														//[SWS_CanNm_00097]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_PREPARE_BUS_SLEEP, NM_STATE_REPEAT_MESSAGE);
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+	if (CANNM_DEFERRED_NOTIFICATIONS()) {
+		CanNm_Internal_NotificationQueueType* queue = &CanNm_Internal.Notifications[channel];
+		uint8 count = queue->Count;
+
+		if (kind == CANNM_NOTIFICATION_NETWORK_START || (kind == CANNM_NOTIFICATION_STATE_CHANGE && arg0 == arg1)) {
+			for (uint8 record = 0; record < count; record++) {
+				if (queue->Records[record].Kind == kind && queue->Records[record].Arg0 == arg0 &&
+				 queue->Records[record].Arg1 == arg1) {
+					return;
+				}
+			}
+		}
+		if (count > 0 && queue->Records[count - 1].Kind == kind &&
+		 (kind == CANNM_NOTIFICATION_STATE_CHANGE || kind == CANNM_NOTIFICATION_PDU_RX)) {
+			CanNm_Internal_NotificationType* last = &queue->Records[count - 1];
+
+			if (kind == CANNM_NOTIFICATION_STATE_CHANGE && last->Arg0 != last->Arg1 && last->Arg0 == arg1) {
+				__atomic_store_n(&queue->Count, count - 1, __ATOMIC_RELAXED);		//There and back again
+			} else {
+				last->Arg1 = arg1;
+			}
+			return;
+		}
+		if (count == CANNM_NOTIFICATION_QUEUE_SIZE) {
+			CANNM_STATISTICS_COUNT(channel, NotificationOverflowCount);
+			count = CanNm_Internal_NotificationMakeRoom(queue->Records, count);
+		}
+		queue->Records[count].Kind = (uint8)kind;
+		queue->Records[count].Arg0 = arg0;
+		queue->Records[count].Arg1 = arg1;
+		__atomic_store_n(&queue->Count, count + 1, __ATOMIC_RELAXED);
+		return;
 	}
+#endif
+	CanNm_Internal_NotificationLatencyStop(channel, kind);
+	CanNm_Internal_Callout(channel, kind, arg0, arg1);
 }
 
-static inline void CanNm_Internal_PrepareBusSleep_to_BusSleep( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+/* Frees at least one record of a full queue without delivering anything under the exclusive area: the oldest state
+   change is merged into the next one (both go when that leads back to the first state), else the oldest PDU
+   reception or a remote sleep indication cancelled right after it is dropped, else the oldest record */
+static uint8 CanNm_Internal_NotificationMakeRoom( CanNm_Internal_NotificationType* records, uint8 count )
 {
-	ChannelInternal->Mode = NM_MODE_BUS_SLEEP;
-	ChannelInternal->State = NM_STATE_BUS_SLEEP;
-	Nm_BusSleepMode(ChannelInternal->Channel);														//[SWS_CanNm_00126]
-	if (CanNm_ConfigPtr->StateChangeIndEnabled) {
-		Nm_StateChangeNotification(ChannelInternal->Channel, NM_STATE_PREPARE_BUS_SLEEP, NM_STATE_BUS_SLEEP);
+	uint8 stateChange = count;
+	uint8 kept = 0;
+	boolean dropped = FALSE;
+
+	for (uint8 record = 0; record < count && !dropped; record++) {
+		if (records[record].Kind == CANNM_NOTIFICATION_STATE_CHANGE) {
+			if (stateChange < count) {
+				records[record].Arg0 = records[stateChange].Arg0;
+				records[stateChange].Kind = CANNM_NOTIFICATION_DROPPED;
+				if (records[record].Arg0 == records[record].Arg1) {
+					records[record].Kind = CANNM_NOTIFICATION_DROPPED;
+				}
+				dropped = TRUE;
+			}
+			stateChange = record;
+		}
+	}
+	for (uint8 record = 0; record < count && !dropped; record++) {
+		if (records[record].Kind == CANNM_NOTIFICATION_PDU_RX) {
+			records[record].Kind = CANNM_NOTIFICATION_DROPPED;
+			dropped = TRUE;
+		} else if (records[record].Kind == CANNM_NOTIFICATION_REMOTE_SLEEP_IND && (record + 1) < count &&
+		 records[record + 1].Kind == CANNM_NOTIFICATION_REMOTE_SLEEP_CANCELLATION) {
+			records[record].Kind = CANNM_NOTIFICATION_DROPPED;
+			records[record + 1].Kind = CANNM_NOTIFICATION_DROPPED;
+			dropped = TRUE;
+		}
+	}
+	if (!dropped) {
+		records[0].Kind = CANNM_NOTIFICATION_DROPPED;
+	}
+	for (uint8 record = 0; record < count; record++) {
+		if (records[record].Kind != CANNM_NOTIFICATION_DROPPED) {
+			records[kept++] = records[record];
+		}
 	}
+	return kept;
 }
+#endif
 
-static inline void CanNm_Internal_NetworkMode_to_NetworkMode( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Latency paths ending with the delivery of a notification, called under the channel exclusive area */
+static inline void CanNm_Internal_NotificationLatencyStop( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind )
 {
-	CanNm_Internal_TimerStart(&ChannelInternal->TimeoutTimer, ChannelConf->TimeoutTime);			//[SWS_CanNm_00098][SWS_CanNm_00099]
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+	if (kind == CANNM_NOTIFICATION_NETWORK_START) {
+		CANNM_LATENCY_STOP(channel, CANNM_LATENCY_RX_TO_NETWORK_START);
+	}
+#else
+	(void)channel;
+	(void)kind;
+#endif
 }
 
-/************************/
-/* Additional functions */
-/************************/
-static inline Std_ReturnType CanNm_Internal_TxDisable( CanNm_Internal_ChannelType* ChannelInternal )
+static inline void CanNm_Internal_DeliverNotification( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind, uint8 arg0, uint8 arg1 )
 {
-	ChannelInternal->TxEnabled = FALSE;
-	if (CanNm_ConfigPtr->RemoteSleepIndEnabled) {
-		ChannelInternal->RemoteSleepIndEnabled = FALSE;												//[SWS_CanNm_00175]
-		CanNm_Internal_TimerStop(&ChannelInternal->RemoteSleepIndTimer);
-	}								
-	CanNm_Internal_TimerStop(&ChannelInternal->MessageCycleTimer);									//[SWS_CanNm_00051][SWS_CanNm_00173]
-	CanNm_Internal_TimerStop(&ChannelInternal->TimeoutTimer);										//[SWS_CanNm_00174]
-	return E_OK;
+	switch (kind) {
+	case CANNM_NOTIFICATION_STATE_CHANGE:
+		CANNM_CALLBACK(NmStateChangeNotification, channel, (Nm_StateType)arg0, (Nm_StateType)arg1);
+		break;
+	case CANNM_NOTIFICATION_REMOTE_SLEEP_IND:
+		CANNM_CALLBACK(NmRemoteSleepInd, channel);
+		break;
+	case CANNM_NOTIFICATION_REMOTE_SLEEP_CANCELLATION:
+		CANNM_CALLBACK(NmRemoteSleepCancellation, channel);
+		break;
+	case CANNM_NOTIFICATION_NETWORK_START:
+		CANNM_CALLBACK(NmNetworkStartIndication, channel);
+		break;
+	case CANNM_NOTIFICATION_PDU_RX:
+		CANNM_CALLBACK(NmPduRxIndication, channel);
+		break;
+	case CANNM_NOTIFICATION_NETWORK_MODE:
+		CANNM_CALLBACK(NmNetworkMode, channel);
+		break;
+	case CANNM_NOTIFICATION_PREPARE_BUS_SLEEP_MODE:
+		CANNM_CALLBACK(NmPrepareBusSleepMode, channel);
+		break;
+	case CANNM_NOTIFICATION_BUS_SLEEP_MODE:
+		CANNM_CALLBACK(NmBusSleepMode, channel);
+		break;
+	case CANNM_NOTIFICATION_TX_TIMEOUT_EXCEPTION:
+		CANNM_CALLBACK(NmTxTimeoutException, channel);
+		break;
+	default:
+		break;
+	}
 }
 
-static inline Std_ReturnType CanNm_Internal_TxEnable( CanNm_Internal_ChannelType* ChannelInternal )
+/* Called under the channel exclusive area. The queue holds the callouts of one critical section, a record not fitting
+   is dropped and counted as a notification overflow */
+static inline void CanNm_Internal_Callout( NetworkHandleType channel, CanNm_Internal_NotificationKindType kind, uint8 arg0, uint8 arg1 )
 {
-	const CanNm_ChannelType* ChannelConf = CanNm_ConfigPtr->ChannelConfig[ChannelInternal->Channel];
+	CanNm_Internal_CalloutQueueType* queue = &CanNm_Internal.Callouts[channel];
+	uint8 count = queue->Count;
 
-	if (!CanNm_ConfigPtr->PassiveModeEnabled) {
-		ChannelInternal->TxEnabled = TRUE;															//[SWS_CanNm_00237]
-		if (CanNm_ConfigPtr->RemoteSleepIndEnabled) {
-			ChannelInternal->RemoteSleepIndEnabled = TRUE;											//[SWS_CanNm_00180]
-			CanNm_Internal_TimerStart(&ChannelInternal->RemoteSleepIndTimer, ChannelConf->RemoteSleepIndTime);
-		}											
-		CanNm_Internal_TimerStart(&ChannelInternal->MessageCycleTimer, 1);							//[SWS_CanNm_00178]
-		return E_OK;
-	} else {
-		return E_NOT_OK;
+	if (count == CANNM_CALLOUT_QUEUE_SIZE) {
+		CANNM_STATISTICS_COUNT(channel, NotificationOverflowCount);
+		return;
 	}
+	queue->Records[count].Kind = (uint8)kind;
+	queue->Records[count].Arg0 = arg0;
+	queue->Records[count].Arg1 = arg1;
+	__atomic_store_n(&queue->Count, count + 1, __ATOMIC_RELAXED);
 }
 
-static inline Std_ReturnType CanNm_Internal_TransmitMessage( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+/* Make the callouts collected for a channel in collection order, called after leaving its exclusive area */
+static void CanNm_Internal_FlushCallouts( NetworkHandleType channel )
 {
-	if (ChannelInternal->TxEnabled) {
-		return CanIf_Transmit(ChannelConf->TxPdu->TxConfirmationPduId, ChannelConf->TxPdu->TxPduRef);	//[SWS_CanNm_00032]
-	} else {
-		return E_OK;
+	CanNm_Internal_CalloutQueueType* queue = &CanNm_Internal.Callouts[channel];
+	CanNm_Internal_NotificationType records[CANNM_CALLOUT_QUEUE_SIZE];
+	uint8 count;
+
+	if (__atomic_load_n(&queue->Count, __ATOMIC_RELAXED) == 0) {
+		return;
+	}
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	count = queue->Count;
+	memcpy(records, queue->Records, count * sizeof(records[0]));
+	__atomic_store_n(&queue->Count, 0, __ATOMIC_RELAXED);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+
+	for (uint8 record = 0; record < count; record++) {
+		if (records[record].Kind == CANNM_NOTIFICATION_TRANSMIT) {
+			CanNm_Internal_TransmitCallout(channel, records[record].Arg0);
+		} else {
+			CanNm_Internal_DeliverNotification(channel, records[record].Kind, records[record].Arg0, records[record].Arg1);
+		}
 	}
 }
 
-static inline void CanNm_Internal_SetPduCbvBit( const CanNm_ChannelType* ChannelConf, const uint8 PduCbvBitPosition )
+#if (CANNM_DEFERRED_NOTIFICATIONS_ENABLED == STD_ON)
+/* Deliver the queued notifications of a channel outside its exclusive area */
+static void CanNm_Internal_FlushNotifications( NetworkHandleType channel )
 {
-	ChannelConf->TxPdu->TxPduRef->SduDataPtr[ChannelConf->PduCbvPosition] |= (1 << PduCbvBitPosition);
+	CanNm_Internal_NotificationQueueType* queue = &CanNm_Internal.Notifications[channel];
+	CanNm_Internal_NotificationType records[CANNM_NOTIFICATION_QUEUE_SIZE];
+	uint8 count;
+
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+	count = queue->Count;
+	memcpy(records, queue->Records, count * sizeof(records[0]));
+	__atomic_store_n(&queue->Count, 0, __ATOMIC_RELAXED);
+	for (uint8 record = 0; record < count; record++) {
+		CanNm_Internal_NotificationLatencyStop(channel, records[record].Kind);		//Stopped at delivery, not when queued
+	}
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, channel);
+
+	for (uint8 record = 0; record < count; record++) {
+		CanNm_Internal_DeliverNotification(channel, records[record].Kind, records[record].Arg0, records[record].Arg1);
+	}
 }
+#endif
 
-static inline void CanNm_Internal_ClearPduCbvBit( const CanNm_ChannelType* ChannelConf, const uint8 PduCbvBitPosition )
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+static inline void CanNm_Internal_ResetStatistics( NetworkHandleType channel )
 {
-	ChannelConf->TxPdu->TxPduRef->SduDataPtr[ChannelConf->PduCbvPosition] &= ~(1 << PduCbvBitPosition);
+	CanNm_Internal_StatisticsType* statistics = &CanNm_Internal.Statistics[channel];
+
+	__atomic_store_n(&statistics->RxCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxFailedCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->ImmediateTxCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxRetryCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxRetryGiveUpCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxDeferredCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxTimeoutCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->TxConfirmationTimeoutCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->RemoteSleepIndCount, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&statistics->NotificationOverflowCount, 0, __ATOMIC_RELAXED);
+	for (uint8 state = 0; state <= NM_STATE_SYNCHRONIZE; state++) {
+		__atomic_store_n(&statistics->StateTicks[state], 0, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&statistics->StateEnteredTick, CanNm_Internal.MainFunctionTicks, __ATOMIC_RELAXED);
 }
+#endif
 
-static inline void CanNm_Internal_ClearPduCbv( const CanNm_ChannelType* ChannelConf, CanNm_Internal_ChannelType* ChannelInternal )
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+static inline void CanNm_Internal_LatencyStart( NetworkHandleType channel, CanNm_LatencyPathType path )
 {
-	if (ChannelConf->PduCbvPosition != CANNM_PDU_OFF) {
-		ChannelConf->TxPdu->TxPduRef->SduDataPtr[ChannelConf->PduCbvPosition] = 0x00;
+	CanNm_Internal_LatencyType* latency = &CanNm_Internal.Latency[channel];
+
+	if (!(latency->Pending & (1U << path))) {
+		latency->Start[path] = CANNM_LATENCY_NOW();
+		latency->Pending |= (uint8)(1U << path);
 	}
 }
 
-static inline uint8 CanNm_Internal_GetUserDataOffset( const CanNm_ChannelType* ChannelConf )
+static inline void CanNm_Internal_LatencyStop( NetworkHandleType channel, CanNm_LatencyPathType path )
 {
-	uint8 userDataPos = 0;
-	userDataPos += (ChannelConf->PduNidPosition == CANNM_PDU_OFF) ? 0 : 1;
-	userDataPos += (ChannelConf->PduCbvPosition == CANNM_PDU_OFF) ? 0 : 1;
-	return userDataPos;
+	CanNm_Internal_LatencyType* latency = &CanNm_Internal.Latency[channel];
+	CanNm_LatencyHistogramType* histogram = &latency->Histograms[path];
+	uint64 value;
+	uint8 bucket;
+
+	if (!(latency->Pending & (1U << path))) {
+		return;
+	}
+	latency->Pending &= (uint8)~(1U << path);
+	value = CANNM_LATENCY_NOW() - latency->Start[path];
+	bucket = (value == 0) ? 0 : (uint8)(64 - __builtin_clzll(value));
+	if (bucket >= CANNM_LATENCY_BUCKET_COUNT) {
+		bucket = CANNM_LATENCY_BUCKET_COUNT - 1;
+	}
+
+	/* Single writer per channel (channel exclusive area), atomic stores only keep readers tear-free */
+	__atomic_store_n(&histogram->Buckets[bucket], histogram->Buckets[bucket] + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&histogram->Sum, histogram->Sum + value, __ATOMIC_RELAXED);
+	if (histogram->Count == 0 || value < histogram->Min) {
+		__atomic_store_n(&histogram->Min, value, __ATOMIC_RELAXED);
+	}
+	if (value > histogram->Max) {
+		__atomic_store_n(&histogram->Max, value, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&histogram->Count, histogram->Count + 1, __ATOMIC_RELEASE);
 }
 
-static inline uint8* CanNm_Internal_GetUserDataPtr( const CanNm_ChannelType* ChannelConf, uint8* MessageSduPtr )
+static inline void CanNm_Internal_ResetLatency( NetworkHandleType channel )
 {
-	uint8 userDataOffset = CanNm_Internal_GetUserDataOffset(ChannelConf);
-	return &MessageSduPtr[userDataOffset];
+	memset(&CanNm_Internal.Latency[channel], 0, sizeof(CanNm_Internal.Latency[channel]));
 }
+#endif
 
-static inline uint8 CanNm_Internal_GetUserDataLength( const CanNm_ChannelType* ChannelConf )
+#ifdef CANNM_LATENCY_HOST_CLOCK
+static inline uint64 CanNm_Internal_GetTimeNs( void )
 {
-	uint8 userDataOffset = CanNm_Internal_GetUserDataOffset(ChannelConf);
-	return ChannelConf->UserDataTxPdu->TxUserDataPduRef->SduLength - userDataOffset;
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
 }
+#endif
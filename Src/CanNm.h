@@ -45,7 +45,12 @@ SOFTWARE.
 /* [SWS_CanNm_00309] */
 #include "NmStack_Types.h"
 
-//#include "CanNm_Cfg.h
+/* Pre-compile configuration, generated by Tools/CanNm_Generate.c; without it every feature is decided at runtime */
+#if defined(__has_include)
+#if __has_include("CanNm_Cfg.h")
+#include "CanNm_Cfg.h"
+#endif
+#endif
 
 /*====================================================================================================================*\
     Local macros Makra globalne
@@ -58,22 +63,184 @@ SOFTWARE.
 #define CANNM_RXPDU_MAX_COUNT 128
 #endif
 
+/* Longest NM PDU of all channels, size of the Tx and Rx PDU buffers CanNm keeps per channel */
+#ifndef CANNM_PDU_MAX_LENGTH
+#define CANNM_PDU_MAX_LENGTH 8
+#endif
+
+/* Coordination clusters of CanNm_GetCoordinatorSleepReady, up to 32 */
+#ifndef CANNM_COORD_CLUSTER_COUNT
+#define CANNM_COORD_CLUSTER_COUNT 1
+#endif
+
+/* CAN controllers with a transmit token bucket, at most one per channel */
+#ifndef CANNM_CONTROLLER_COUNT
+#define CANNM_CONTROLLER_COUNT 1
+#endif
+
+/* Configuration variants */
+#define CANNM_VARIANT_POST_BUILD	0	/* Feature flags are read from the configuration passed to CanNm_Init */
+#define CANNM_VARIANT_PRE_COMPILE	1	/* Feature flags are the compile-time switches below */
+
+#ifndef CANNM_CONFIG_VARIANT
+#define CANNM_CONFIG_VARIANT CANNM_VARIANT_POST_BUILD
+#endif
+
+/* Optional features. STD_OFF removes a feature from the code, STD_ON enables it in the pre-compile variant and leaves
+   it to the configuration flag in the post-build variant */
+#ifndef CANNM_BUS_LOAD_REDUCTION_ENABLED
+#define CANNM_BUS_LOAD_REDUCTION_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_COM_USER_DATA_SUPPORT
+#define CANNM_COM_USER_DATA_SUPPORT STD_ON
+#endif
+
+#ifndef CANNM_COORDINATOR_SYNC_SUPPORT
+#define CANNM_COORDINATOR_SYNC_SUPPORT STD_ON
+#endif
+
+#ifndef CANNM_GLOBAL_PN_SUPPORT
+#define CANNM_GLOBAL_PN_SUPPORT STD_ON
+#endif
+
+#ifndef CANNM_IMMEDIATE_RESTART_ENABLED
+#define CANNM_IMMEDIATE_RESTART_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_PASSIVE_MODE_ENABLED
+#define CANNM_PASSIVE_MODE_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_PDU_RX_INDICATION_ENABLED
+#define CANNM_PDU_RX_INDICATION_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_REMOTE_SLEEP_IND_ENABLED
+#define CANNM_REMOTE_SLEEP_IND_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_STATE_CHANGE_IND_ENABLED
+#define CANNM_STATE_CHANGE_IND_ENABLED STD_ON
+#endif
+
+#ifndef CANNM_USER_DATA_ENABLED
+#define CANNM_USER_DATA_ENABLED STD_ON
+#endif
+
+/* Queue Nm_StateChangeNotification, Nm_RemoteSleepInd, Nm_RemoteSleepCancellation, Nm_NetworkStartIndication and
+   Nm_PduRxIndication per channel and deliver them at the end of CanNm_MainFunction */
+#ifndef CANNM_DEFERRED_NOTIFICATIONS_ENABLED
+#define CANNM_DEFERRED_NOTIFICATIONS_ENABLED STD_OFF
+#endif
+
+/* Set channels up on their first API call or reception instead of in CanNm_Init */
+#ifndef CANNM_LAZY_INIT_ENABLED
+#define CANNM_LAZY_INIT_ENABLED STD_OFF
+#endif
+
+/* CanNm_LoadConfigImage for configuration sets in the binary image format of CanNm_ImageHeaderType */
+#ifndef CANNM_CONFIG_IMAGE_ENABLED
+#define CANNM_CONFIG_IMAGE_ENABLED STD_OFF
+#endif
+
+/* CanNm_Reconfigure, switching the running module to another configuration set without CanNm_Init */
+#ifndef CANNM_RECONFIGURE_ENABLED
+#define CANNM_RECONFIGURE_ENABLED STD_OFF
+#endif
+
+/* Queued notifications per channel, a full queue merges or drops its oldest records */
+#ifndef CANNM_NOTIFICATION_QUEUE_SIZE
+#define CANNM_NOTIFICATION_QUEUE_SIZE 8
+#endif
+
+/* Callouts (upper layer callbacks, CanIf_Transmit) collected per channel under its exclusive area and made once the
+   area is left, enough for the transitions of one main function period */
+#ifndef CANNM_CALLOUT_QUEUE_SIZE
+#define CANNM_CALLOUT_QUEUE_SIZE 16
+#endif
+
+/* Binary event tracer of state transitions, timer expiries and PDUs */
+#ifndef CANNM_TRACE_ENABLED
+#define CANNM_TRACE_ENABLED STD_OFF
+#endif
+
+/* Records kept per channel, power of two */
+#ifndef CANNM_TRACE_RING_SIZE
+#define CANNM_TRACE_RING_SIZE 256
+#endif
+
+/* Trace time stamp source, main function ticks unless a faster clock (e.g. a cycle counter) is mapped */
+#ifndef CANNM_TRACE_TIMESTAMP
+#define CANNM_TRACE_TIMESTAMP() CanNm_GetMainFunctionTicks()
+#endif
+
+/* Per channel frame, transmission and state time counters */
+#ifndef CANNM_STATISTICS_ENABLED
+#define CANNM_STATISTICS_ENABLED STD_OFF
+#endif
+
+/* Latency histograms of the network request, wake-up and sleep paths */
+#ifndef CANNM_LATENCY_ENABLED
+#define CANNM_LATENCY_ENABLED STD_OFF
+#endif
+
+/* Latency clock sources */
+#define CANNM_LATENCY_CLOCK_TICKS		0	/* Main function ticks */
+#define CANNM_LATENCY_CLOCK_MONOTONIC	1	/* CANNM_LATENCY_GET_TIME_NS(), host CLOCK_MONOTONIC unless mapped */
+
+#ifndef CANNM_LATENCY_CLOCK
+#define CANNM_LATENCY_CLOCK CANNM_LATENCY_CLOCK_TICKS
+#endif
+
+/* Bucket b counts latencies in [2^(b-1), 2^b) clock units, bucket 0 zero latencies, the last one everything above */
+#ifndef CANNM_LATENCY_BUCKET_COUNT
+#define CANNM_LATENCY_BUCKET_COUNT 40
+#endif
+
+/* Discrete-event time source: skip main function periods without timer expiries */
+#ifndef CANNM_VIRTUAL_CLOCK_ENABLED
+#define CANNM_VIRTUAL_CLOCK_ENABLED STD_OFF
+#endif
+
+#define CANNM_NO_TIMER_EXPIRY 0xFFFFFFFFUL
+
+/* Entry of the RxPduId map for PDU ids that belong to no channel */
+#define CANNM_INVALID_CHANNEL ((NetworkHandleType)~0U)
+
+/* CoordClusterIndex of a channel outside every coordination cluster */
+#define CANNM_COORD_CLUSTER_NONE 0xFF
+
+/* ControllerIndex of a channel whose NM PDUs are not rate limited */
+#define CANNM_CONTROLLER_NONE 0xFF
+
+#define CANNM_TRACE_FILE_MAGIC		0x544D4E43UL	/* "CNMT" */
+#define CANNM_TRACE_FILE_VERSION	1
+
+#define CANNM_STATE_MAGIC			0x534D4E43UL	/* "CNMS" */
+#define CANNM_STATE_VERSION			2
+
+#define CANNM_IMAGE_MAGIC			0x494D4E43UL	/* "CNMI" */
+#define CANNM_IMAGE_VERSION			1
+#define CANNM_IMAGE_BYTE_ORDER		0x0102U			/* Reads 0x0201 on a host of the other byte order */
+#define CANNM_IMAGE_ALIGNMENT		4				/* Of the image start and of every table offset */
+
 /*====================================================================================================================*\
     Global types
 \*====================================================================================================================*/
 typedef struct {
-	PduIdType	 RxPduId;
-	PduInfoType* RxPduRef;
+	PduIdType			RxPduId;
+	const PduInfoType*	RxPduRef;
 } CanNm_RxPdu;
 
 typedef struct {
-	PduIdType	 TxConfirmationPduId;
-	PduInfoType* TxPduRef;
+	PduIdType			TxConfirmationPduId;
+	const PduInfoType*	TxPduRef;
 } CanNm_TxPdu;
 
 typedef struct {
-	PduIdType	 TxUserDataPduId;
-	PduInfoType* TxUserDataPduRef;
+	PduIdType			TxUserDataPduId;
+	const PduInfoType*	TxUserDataPduRef;
 } CanNm_UserDataTxPdu;
 
 typedef enum {
@@ -82,6 +249,23 @@ typedef enum {
 	CANNM_PDU_OFF = 0xFF
 } CanNm_PduBytePositionType;	//[SWS_CanNm_00074][SWS_CanNm_00075]
 
+typedef enum {
+	CANNM_TX_RETRY_NEXT_MAIN_FUNCTION,	/* One retry with the next main function [SWS_CanNm_00335] */
+	CANNM_TX_RETRY_FIXED,				/* Retry every TxRetryTime */
+	CANNM_TX_RETRY_EXPONENTIAL			/* Retry after TxRetryTime, doubled per failure up to TxRetryMaxTime */
+} CanNm_TxRetryPolicyType;
+
+typedef enum {
+	CANNM_WAKEUP_STAGGER_CHANNEL_INDEX,	/* Slot of a channel is its index modulo the window */
+	CANNM_WAKEUP_STAGGER_HASH			/* Slot of a channel is a hash of its index and node identifier */
+} CanNm_WakeUpStaggerType;
+
+/* Transmit token bucket of a CAN controller shared by the NM PDUs of all its channels */
+typedef struct {
+	uint16						TxBucketSize;			/* NM PDUs the controller may send back to back, 0 unlimited */
+	float32						TxTokenTime;			/* Time one NM PDU is refilled after, 0 refills every main function */
+} CanNm_ControllerType;
+
 typedef struct {
 	uint8 PnFilterMaskByteIndex;
 	uint8 PnFilterMaskByteValue;
@@ -95,6 +279,8 @@ typedef struct {
 	boolean						CarWakeUpFilterEnabled;
 	uint8						CarWakeUpFilterNodeId;
 	boolean						CarWakeUpRxEnabled;
+	uint8						ControllerIndex;		/* Token bucket in ControllerConfig, CANNM_CONTROLLER_NONE for none */
+	uint8						CoordClusterIndex;		/* Coordination cluster, CANNM_COORD_CLUSTER_NONE for none */
 	float32						ImmediateNmCycleTime;
 	uint8						ImmediateNmTransmissions;
 	float32						MsgCycleOffset;
@@ -112,21 +298,149 @@ typedef struct {
 	float32						RemoteSleepIndTime;
 	float32						RepeatMessageTime;
 	boolean						RepeatMsgIndEnabled;
-	CanNm_RxPdu*				RxPdu[CANNM_RXPDU_MAX_COUNT];
+	const CanNm_RxPdu*			RxPdu[CANNM_RXPDU_MAX_COUNT];
 	float32						TimeoutTime;
-	CanNm_TxPdu*				TxPdu;
-	CanNm_UserDataTxPdu*		UserDataTxPdu;
+	const CanNm_TxPdu*			TxPdu;
+	uint8						TxRetryLimit;			/* Failed retries before the immediate transmissions are dropped */
+	float32						TxRetryMaxTime;			/* Exponential backoff cap, 0 caps at MsgCycleTime */
+	CanNm_TxRetryPolicyType		TxRetryPolicy;
+	float32						TxRetryTime;
+	const CanNm_UserDataTxPdu*	UserDataTxPdu;
 	float32						WaitBusSleepTime;
 	NetworkHandleType			ComMNetworkHandleRef;
 	PduInfoType					PnEraRxNSduRef;
 } CanNm_ChannelType;
 
 typedef struct {
-	const uint8 					PnInfoLength;
-	const uint8 					PnInfoOffset;
+	uint8 						PnInfoLength;
+	uint8 						PnInfoOffset;
 	const CanNm_PnFilterMaskByte* 	PnFilterMaskByte;
 } CanNm_PnInfo;
 
+typedef enum {
+	CANNM_TRACE_EVENT_TRANSITION,		/* Arg0: previous state, Arg1: next state */
+	CANNM_TRACE_EVENT_TIMER_EXPIRED,	/* Arg0: CanNm_TraceTimerType */
+	CANNM_TRACE_EVENT_TX,				/* Arg0: CanIf_Transmit result, Arg1: TxPduId */
+	CANNM_TRACE_EVENT_RX				/* Arg0: received CBV, Arg1: RxPduId */
+} CanNm_TraceEventType;
+
+typedef enum {
+	CANNM_TRACE_TIMER_TIMEOUT,
+	CANNM_TRACE_TIMER_MESSAGE_CYCLE,
+	CANNM_TRACE_TIMER_REPEAT_MESSAGE,
+	CANNM_TRACE_TIMER_WAIT_BUS_SLEEP,
+	CANNM_TRACE_TIMER_REMOTE_SLEEP_IND
+} CanNm_TraceTimerType;
+
+/** @brief CanNm_TraceRecordType
+ *
+ * Fixed size binary trace record, 16 bytes.
+ */
+typedef struct {
+	uint32	Timestamp;
+	uint32	Sequence;		/* Per channel record number, gaps show overwritten records */
+	uint16	Channel;
+	uint8	Event;			/* CanNm_TraceEventType */
+	uint8	Arg0;
+	uint32	Arg1;
+} CanNm_TraceRecordType;
+
+/** @brief CanNm_TraceFileHeaderType
+ *
+ * Header of a trace dump file, followed by the records of all channels.
+ */
+typedef struct {
+	uint32	Magic;				/* CANNM_TRACE_FILE_MAGIC */
+	uint16	Version;			/* CANNM_TRACE_FILE_VERSION */
+	uint16	RecordSize;			/* sizeof(CanNm_TraceRecordType) */
+	uint32	TimestampUnitNs;	/* Duration of one time stamp unit */
+	uint32	RecordCount;		/* 0 when the writer did not know it, e.g. a streamed dump */
+} CanNm_TraceFileHeaderType;
+
+/** @brief CanNm_StatisticsType
+ *
+ * Runtime counters of a channel since initialization or the last CanNm_ResetStatistics call.
+ */
+typedef struct {
+	uint32	RxCount;					/* NM PDUs received */
+	uint32	TxCount;					/* NM PDUs accepted by CanIf_Transmit */
+	uint32	TxFailedCount;				/* CanIf_Transmit calls returning E_NOT_OK */
+	uint32	ImmediateTxCount;			/* Immediate NM transmissions sent */
+	uint32	TxRetryCount;				/* Retries scheduled after a failed immediate transmission */
+	uint32	TxRetryGiveUpCount;			/* Immediate transmissions dropped after TxRetryLimit failed retries */
+	uint32	TxDeferredCount;			/* Transmissions deferred to the next main function by the controller token bucket */
+	uint32	TxTimeoutCount;				/* Nm_TxTimeoutException indications */
+	uint32	TxConfirmationTimeoutCount;	/* CanSM_TxTimeoutException indications, no confirmation within MsgTimeoutTime */
+	uint32	RemoteSleepIndCount;		/* Nm_RemoteSleepInd indications */
+	uint32	NotificationOverflowCount;	/* Deferred notifications delivered early because the queue was full */
+	float32	StateTime[NM_STATE_SYNCHRONIZE + 1];	/* Time spent per Nm_StateType [ms] */
+} CanNm_StatisticsType;
+
+/** @brief CanNm_BusLoadType
+ *
+ * NM frame rate on a bus and the bits it takes at the nominal bit rate with worst case bit stuffing.
+ */
+typedef struct {
+	float32	FramesPerSecond;
+	float32	BitsPerSecond;
+} CanNm_BusLoadType;
+
+/** @brief CanNm_BusLoadEstimateType
+ *
+ * Expected NM bus load of a channel configuration for a number of nodes.
+ */
+typedef struct {
+	CanNm_BusLoadType	Startup;		/* All nodes waking up at once, immediate transmissions */
+	CanNm_BusLoadType	Steady;			/* All nodes in Normal Operation State */
+} CanNm_BusLoadEstimateType;
+
+/** @brief CanNm_LatencyPathType
+ *
+ * Measured end-to-end paths.
+ */
+typedef enum {
+	CANNM_LATENCY_NETWORK_REQUEST_TO_TX,		/* CanNm_NetworkRequest to the first accepted CanIf_Transmit */
+	CANNM_LATENCY_RX_TO_NETWORK_START,			/* First CanNm_RxIndication in bus-sleep to Nm_NetworkStartIndication */
+	CANNM_LATENCY_NETWORK_RELEASE_TO_BUS_SLEEP,	/* CanNm_NetworkRelease to Nm_BusSleepMode */
+	CANNM_LATENCY_PATH_COUNT
+} CanNm_LatencyPathType;
+
+/** @brief CanNm_LatencyHistogramType
+ *
+ * Log2 bucketed latency histogram of one path, in units of TimeUnitNs.
+ */
+typedef struct {
+	uint32	TimeUnitNs;							/* Clock unit, the main function period for the tick clock */
+	uint32	Count;
+	uint64	Sum;
+	uint64	Min;
+	uint64	Max;
+	uint32	Buckets[CANNM_LATENCY_BUCKET_COUNT];
+} CanNm_LatencyHistogramType;
+
+/** @brief CanNm_CallbacksType
+ *
+ * Lower and upper layer interfaces called by CanNm. NULL entries are not called, without CanIfTransmit every NM PDU
+ * counts as accepted.
+ */
+typedef struct {
+	Std_ReturnType	(*CanIfTransmit)(PduIdType TxPduId, const PduInfoType* PduInfoPtr);
+	void			(*CanSmTxTimeoutException)(NetworkHandleType Channel);
+	void			(*CoordSleepReadyCancellation)(uint8 coordClusterIndex);
+	void			(*CoordSleepReadyIndication)(uint8 coordClusterIndex);
+	void			(*NmBusSleepMode)(NetworkHandleType nmNetworkHandle);
+	void			(*NmNetworkMode)(NetworkHandleType nmNetworkHandle);
+	void			(*NmNetworkStartIndication)(NetworkHandleType nmNetworkHandle);
+	void			(*NmPduRxIndication)(NetworkHandleType nmNetworkHandle);
+	void			(*NmPrepareBusSleepMode)(NetworkHandleType nmNetworkHandle);
+	void			(*NmRemoteSleepCancellation)(NetworkHandleType nmNetworkHandle);
+	void			(*NmRemoteSleepInd)(NetworkHandleType nmNetworkHandle);
+	void			(*NmStateChangeNotification)(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState,
+					 Nm_StateType nmCurrentState);
+	void			(*NmTxTimeoutException)(NetworkHandleType nmNetworkHandle);
+	void			(*PduRRxIndication)(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
+} CanNm_CallbacksType;
+
 /** @brief CanNm_ConfigType [SWS_CanNm_00447]
  * 
  * This type shall contain at least all parameters that are post-build able according to chapter 10.
@@ -134,30 +448,144 @@ typedef struct {
 typedef struct {
 	boolean				BusLoadReductionEnabled;
 	boolean				BusSynchronizationEnabled;
-	CanNm_ChannelType*	ChannelConfig[CANNM_CHANNEL_COUNT];
+	const CanNm_CallbacksType*	Callbacks;				/* NULL for CanNm_DefaultCallbacks */
+	const CanNm_ChannelType*	ChannelConfig[CANNM_CHANNEL_COUNT];
 	boolean				ComControlEnabled;
 	boolean				ComUserDataSupport;
 	boolean				CoordinationSyncSupport;
+	boolean				DeferredNotificationsEnabled;
 	boolean				DevErrorDetect;
 	boolean				GlobalPnSupport;
 	boolean				ImmediateRestartEnabled;
 	boolean				ImmediateTxConfEnabled;				//[SWS_CanNm_00071]
+	boolean				LazyInitEnabled;
 	float32				MainFunctionPeriod;
 	boolean				PassiveModeEnabled;
 	boolean				PduRxIndicationEnabled;
 	boolean				PnEiraCalcEnabled;
-	CanNm_PnInfo*		PnInfo;
+	const CanNm_PnInfo*	PnInfo;
 	float32				PnResetTime;
 	boolean				RemoteSleepIndEnabled;
 	boolean				StateChangeIndEnabled;
 	boolean				UserDataEnabled;
 	boolean				VersionInfoApi;
 	PduInfoType*		PnEiraRxNSduRef;
+	const NetworkHandleType*	RxPduChannelMap;		/* Channel of every RxPduId, NULL when RxPduId is the channel */
+	PduIdType			RxPduCount;						/* Entries of RxPduChannelMap */
+	float32				WakeUpStaggerTime;				/* Window the first transmissions after a network start spread over, 0 off */
+	CanNm_WakeUpStaggerType	WakeUpStagger;
+	const CanNm_ControllerType*	ControllerConfig;		/* CANNM_CONTROLLER_COUNT token buckets, NULL without rate limit */
 } CanNm_ConfigType;
 
+/** @brief CanNm_ImageTableType
+ *
+ * Table of a configuration image, located by its offset from the start of the image instead of a pointer.
+ */
+typedef struct {
+	uint32	Offset;			/* Multiple of CANNM_IMAGE_ALIGNMENT, 0 for an empty table */
+	uint32	Count;			/* Entries */
+} CanNm_ImageTableType;
+
+/** @brief CanNm_ImageChannelType
+ *
+ * Channel of a configuration image, the members of CanNm_ChannelType without pointers. The Tx PDU, the user data
+ * PDU and the Rx PDUs are given by their ids and the common PDU length.
+ */
+typedef struct {
+	float32		ImmediateNmCycleTime;
+	float32		MsgCycleOffset;
+	float32		MsgCycleTime;
+	float32		MsgReducedTime;
+	float32		MsgTimeoutTime;
+	float32		RemoteSleepIndTime;
+	float32		RepeatMessageTime;
+	float32		TimeoutTime;
+	float32		TxRetryMaxTime;
+	float32		TxRetryTime;
+	float32		WaitBusSleepTime;
+	uint32		RxPduIndex;				/* First Rx PDU of the channel in the RxPduIds table */
+	PduIdType	TxConfirmationPduId;
+	PduIdType	TxUserDataPduId;
+	uint16		ComMNetworkHandleRef;
+	uint8		RxPduCount;				/* Rx PDUs of the channel, 1 to CANNM_RXPDU_MAX_COUNT */
+	uint8		PduLength;				/* Tx and Rx PDU length, up to CANNM_PDU_MAX_LENGTH */
+	uint8		CarWakeUpBitPosition;
+	uint8		CarWakeUpFilterNodeId;
+	uint8		ControllerIndex;
+	uint8		CoordClusterIndex;
+	uint8		ImmediateNmTransmissions;
+	uint8		NodeId;
+	uint8		PduCbvPosition;			/* CanNm_PduBytePositionType */
+	uint8		PduNidPosition;			/* CanNm_PduBytePositionType */
+	uint8		TxRetryLimit;
+	uint8		TxRetryPolicy;			/* CanNm_TxRetryPolicyType */
+	boolean		ActiveWakeupBitEnabled;
+	boolean		AllNmMessagesKeepAwake;
+	boolean		BusLoadReductionActive;
+	boolean		CarWakeUpFilterEnabled;
+	boolean		CarWakeUpRxEnabled;
+	boolean		NodeDetectionEnabled;
+	boolean		NodeIdEnabled;
+	boolean		PnEnabled;
+	boolean		PnEraCalcEnabled;
+	boolean		PnHandleMultipleNetworkRequests;
+	boolean		RepeatMsgIndEnabled;
+} CanNm_ImageChannelType;
+
+/** @brief CanNm_ImageHeaderType
+ *
+ * Start of a configuration image: a position-independent CanNm_ConfigType in the byte order and float format of the
+ * host, followed by its tables. Written by Tools/CanNm_Generate as CanNm_Cfg.bin and checked in place by
+ * CanNm_LoadConfigImage, e.g. straight from a read-only mmap of the file.
+ */
+typedef struct {
+	uint32					Magic;					/* CANNM_IMAGE_MAGIC */
+	uint16					Version;				/* CANNM_IMAGE_VERSION */
+	uint16					ByteOrder;				/* CANNM_IMAGE_BYTE_ORDER */
+	uint32					Length;					/* Whole image including this header */
+	uint16					HeaderSize;				/* sizeof(CanNm_ImageHeaderType) */
+	uint16					ChannelSize;			/* sizeof(CanNm_ImageChannelType) */
+	uint8					HandleSize;				/* sizeof(NetworkHandleType) of the RxPduChannelMap entries */
+	uint8					WakeUpStagger;			/* CanNm_WakeUpStaggerType */
+	uint8					PnInfoLength;
+	uint8					PnInfoOffset;
+	CanNm_ImageTableType	Channels;				/* CanNm_ImageChannelType, CANNM_CHANNEL_COUNT entries */
+	CanNm_ImageTableType	RxPduIds;				/* PduIdType, the Rx PDUs of all channels */
+	CanNm_ImageTableType	RxPduChannelMap;		/* NetworkHandleType per RxPduId, empty when RxPduId is the channel */
+	CanNm_ImageTableType	Controllers;			/* CanNm_ControllerType, CANNM_CONTROLLER_COUNT entries or empty */
+	CanNm_ImageTableType	PnFilterMaskBytes;		/* CanNm_PnFilterMaskByte, empty without PnInfo */
+	float32					MainFunctionPeriod;
+	float32					PnResetTime;
+	float32					WakeUpStaggerTime;
+	boolean					BusLoadReductionEnabled;
+	boolean					BusSynchronizationEnabled;
+	boolean					ComControlEnabled;
+	boolean					ComUserDataSupport;
+	boolean					CoordinationSyncSupport;
+	boolean					DeferredNotificationsEnabled;
+	boolean					DevErrorDetect;
+	boolean					GlobalPnSupport;
+	boolean					ImmediateRestartEnabled;
+	boolean					ImmediateTxConfEnabled;
+	boolean					LazyInitEnabled;
+	boolean					PassiveModeEnabled;
+	boolean					PduRxIndicationEnabled;
+	boolean					PnEiraCalcEnabled;
+	boolean					PnInfoEnabled;			/* PnInfoLength, PnInfoOffset and PnFilterMaskBytes are given */
+	boolean					RemoteSleepIndEnabled;
+	boolean					StateChangeIndEnabled;
+	boolean					UserDataEnabled;
+	boolean					VersionInfoApi;
+} CanNm_ImageHeaderType;
+
 /*====================================================================================================================*\
     Global variables export
 \*====================================================================================================================*/
+extern const CanNm_CallbacksType CanNm_DefaultCallbacks;	/* The global Nm, CanIf and PduR functions */
+
+#ifdef CANNM_CONFIG_SET
+extern const CanNm_ConfigType CANNM_CONFIG_SET;	/* Generated configuration set, see CanNm_Cfg.h */
+#endif
 
 /*====================================================================================================================*\
     Global functions declarations
@@ -185,10 +613,41 @@ void CanNm_GetVersionInfo(Std_VersionInfoType* versioninfo);
 Std_ReturnType CanNm_RequestBusSynchronization(NetworkHandleType nmChannelHandle);
 Std_ReturnType CanNm_CheckRemoteSleepIndication(NetworkHandleType nmChannelHandle, boolean* nmRemoteSleepIndPtr);
 Std_ReturnType CanNm_SetSleepReadyBit(NetworkHandleType nmChannelHandle,boolean nmSleepReadyBit);
+Std_ReturnType CanNm_GetCoordinatorSleepReady(uint8 coordClusterIndex, boolean* sleepReadyPtr);
 
 void CanNm_TxConfirmation(PduIdType TxPduId, Std_ReturnType result);
 void CanNm_RxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
 void CanNm_ConfirmPnAvailability(NetworkHandleType nmChannelHandle);
 Std_ReturnType CanNm_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr);
 
+uint32 CanNm_GetMainFunctionTicks(void);
+Std_ReturnType CanNm_SaveState(uint8* stateBufferPtr, uint32* stateLengthPtr);
+Std_ReturnType CanNm_RestoreState(const uint8* stateBufferPtr, uint32 stateLength);
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+Std_ReturnType CanNm_LoadConfigImage(const uint8* imagePtr, uint32 imageLength, const CanNm_ConfigType** configPtrPtr);
+#endif
+#if (CANNM_RECONFIGURE_ENABLED == STD_ON)
+Std_ReturnType CanNm_Reconfigure(const CanNm_ConfigType* cannmConfigPtr);
+boolean CanNm_ReconfigurePending(void);
+#endif
+#if (CANNM_VIRTUAL_CLOCK_ENABLED == STD_ON)
+uint32 CanNm_GetTicksToNextExpiry(void);
+void CanNm_FastForward(uint32 ticks);
+#endif
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+Std_ReturnType CanNm_GetStatistics(NetworkHandleType nmChannelHandle, CanNm_StatisticsType* statisticsPtr);
+Std_ReturnType CanNm_ResetStatistics(NetworkHandleType nmChannelHandle);
+Std_ReturnType CanNm_GetObservedBusLoad(NetworkHandleType nmChannelHandle, CanNm_BusLoadType* busLoadPtr);
+#endif
+Std_ReturnType CanNm_EstimateBusLoad(const CanNm_ConfigType* cannmConfigPtr, NetworkHandleType nmChannelHandle,
+ uint16 nodeCount, CanNm_BusLoadEstimateType* estimatePtr);
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+Std_ReturnType CanNm_GetLatencyHistogram(NetworkHandleType nmChannelHandle, CanNm_LatencyPathType path,
+ CanNm_LatencyHistogramType* histogramPtr);
+Std_ReturnType CanNm_ResetLatencyHistograms(NetworkHandleType nmChannelHandle);
+#endif
+#if (CANNM_TRACE_ENABLED == STD_ON)
+uint32 CanNm_TraceRead(NetworkHandleType nmChannelHandle, uint32* cursorPtr, CanNm_TraceRecordType* recordsPtr, uint32 maxRecords);
+#endif
+
 #endif /* CANNM_H */
@@ -0,0 +1,15 @@
+#ifndef CANSM_TXTIMEOUTEXCEPTION_H
+#define CANSM_TXTIMEOUTEXCEPTION_H
+
+/**===================================================================================================================*\
+  @file CanSM_TxTimeoutException.h
+
+  @brief CAN State Manager notification of a transmit confirmation timeout [SWS_CanNm_00325]
+\*====================================================================================================================*/
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+
+void CanSM_TxTimeoutException(NetworkHandleType Channel);
+
+#endif /* CANSM_TXTIMEOUTEXCEPTION_H */
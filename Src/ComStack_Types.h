@@ -113,6 +113,12 @@ typedef uint8 BusTrcvErrorType;
 #define COMSTACKTYPE_AR_MAJOR_VERSION		0
 #define COMSTACKTYPE_AR_PATCH_VERSION		0
 
+// Like PduIdType, the network handle has to be uint16 as soon as one
+// module handles more than 255 networks.
+#ifndef COMSTACK_NETWORK_HANDLE_16BIT
 typedef uint8 NetworkHandleType;
+#else
+typedef uint16 NetworkHandleType;
+#endif
 
 #endif /*COMSTACK_TYPES_H_*/
@@ -90,6 +90,7 @@ void Det_Init( void ); /** @req DET008 */
 void Det_DeInit( void );
 #endif
 void Det_ReportError( uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 ErrorId); /** @req DET009 */
+Std_ReturnType Det_ReportRuntimeError( uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 ErrorId);
 void Det_Start( void ); /** @req DET010 */
 #define Det_GetVersionInfo(_vi) STD_GET_VERSION_INFO(_vi,DET) /** @req DET011 */ /** @req DET012 */
 
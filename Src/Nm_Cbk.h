@@ -0,0 +1,29 @@
+#ifndef NM_CBK_H
+#define NM_CBK_H
+
+/**===================================================================================================================*\
+  @file Nm_Cbk.h
+
+  @brief Call-back notifications of the Nm Interface used by CanNm [SWS_CanNm_00307]
+\*====================================================================================================================*/
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+
+void Nm_NetworkStartIndication(NetworkHandleType nmNetworkHandle);
+void Nm_NetworkMode(NetworkHandleType nmNetworkHandle);
+void Nm_BusSleepMode(NetworkHandleType nmNetworkHandle);
+void Nm_PrepareBusSleepMode(NetworkHandleType nmNetworkHandle);
+void Nm_RemoteSleepIndication(NetworkHandleType nmNetworkHandle);
+void Nm_RemoteSleepInd(NetworkHandleType nmNetworkHandle);
+void Nm_RemoteSleepCancellation(NetworkHandleType nmNetworkHandle);
+void Nm_PduRxIndication(NetworkHandleType nmNetworkHandle);
+void Nm_StateChangeNotification(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState, Nm_StateType nmCurrentState);
+void Nm_RepeatMessageIndication(NetworkHandleType nmNetworkHandle);
+void Nm_TxTimeoutException(NetworkHandleType nmNetworkHandle);
+void Nm_CarWakeUpIndication(NetworkHandleType nmChannelHandle);
+void Nm_CoordReadyToSleepIndication(NetworkHandleType nmChannelHandle);
+void Nm_CoordReadyToSleepCancellation(NetworkHandleType nmChannelHandle);
+
+#endif /* NM_CBK_H */
@@ -0,0 +1,17 @@
+#ifndef PDUR_CANNM_H
+#define PDUR_CANNM_H
+
+/**===================================================================================================================*\
+  @file PduR_CanNm.h
+
+  @brief PDU Router services used by CanNm [SWS_CanNm_00326]
+\*====================================================================================================================*/
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+
+void PduR_CanNmRxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
+void PduR_CanNmTxConfirmation(PduIdType TxPduId, Std_ReturnType result);
+Std_ReturnType PduR_CanNmTriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr);
+
+#endif /* PDUR_CANNM_H */
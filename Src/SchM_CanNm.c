@@ -0,0 +1,257 @@
+/** ==================================================================================================================*\
+  @file SchM_CanNm.c
+
+  @brief BSW Scheduler exclusive areas of the Can Network Management Module
+
+  Lock backends selected by SCHM_CANNM_BACKEND. Spinlock and pthread backends are recursive, so an upper layer
+  callback may re-enter the CanNm API of the same channel from within an exclusive area. The spinlock backend holds
+  the local interrupt lock of the core while inside an area, so an ISR calling CanNm_RxIndication or
+  CanNm_TxConfirmation cannot pass for the owner; the pthread backend is for threads only.
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include "string.h"
+#include "Std_Types.h"
+#include "CanNm.h"
+#include "SchM_CanNm.h"
+
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+#include <pthread.h>
+#endif
+
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON) && !defined(SCHM_CANNM_GET_TIME_NS)
+#include <time.h>
+#define SCHM_CANNM_HOST_CLOCK
+#endif
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#ifdef SCHM_CANNM_HOST_CLOCK
+#define SCHM_CANNM_GET_TIME_NS() SchM_CanNm_GetTimeNs()
+#endif
+
+#ifndef SCHM_CANNM_CPU_RELAX
+#if defined(__x86_64__) || defined(__i386__)
+#define SCHM_CANNM_CPU_RELAX() __builtin_ia32_pause()
+#else
+#define SCHM_CANNM_CPU_RELAX() __asm__ volatile ("" ::: "memory")
+#endif
+#endif
+
+/*====================================================================================================================*\
+    Local types
+\*====================================================================================================================*/
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_SPINLOCK)
+typedef struct {
+	uint32		Lock;
+	const void*	Owner;
+	uint32		Depth;
+} SchM_CanNm_SpinlockType;
+#endif
+
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+typedef struct {
+	pthread_mutex_t	Mutex;
+	uint32			Depth;
+} SchM_CanNm_MutexType;
+#endif
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_IRQLOCK)
+static uint32 SchM_CanNm_IrqLockDepth;
+#endif
+
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_SPINLOCK)
+static SchM_CanNm_SpinlockType SchM_CanNm_Spinlocks[CANNM_EXCLUSIVE_AREA_COUNT][CANNM_CHANNEL_COUNT];
+static __thread uint8 SchM_CanNm_ThreadToken;
+static __thread uint32 SchM_CanNm_LocalLockDepth;		//Areas held by this core, interrupts locked while non-zero
+#endif
+
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+static SchM_CanNm_MutexType SchM_CanNm_Mutexes[CANNM_EXCLUSIVE_AREA_COUNT][CANNM_CHANNEL_COUNT];
+static pthread_once_t SchM_CanNm_MutexesOnce = PTHREAD_ONCE_INIT;
+#endif
+
+static SchM_CanNm_ContentionStatsType SchM_CanNm_Stats[CANNM_EXCLUSIVE_AREA_COUNT];
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+#ifdef SCHM_CANNM_HOST_CLOCK
+static inline uint64 SchM_CanNm_GetTimeNs( void )
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+#endif
+
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+static inline void SchM_CanNm_CountEntry( SchM_CanNm_ExclusiveAreaType area )
+{
+	__atomic_fetch_add(&SchM_CanNm_Stats[area].Entries, 1, __ATOMIC_RELAXED);
+}
+
+static inline void SchM_CanNm_CountContention( SchM_CanNm_ExclusiveAreaType area, uint64 waitTimeNs )
+{
+	SchM_CanNm_ContentionStatsType* stats = &SchM_CanNm_Stats[area];
+	uint64 maxWaitTimeNs = __atomic_load_n(&stats->MaxWaitTimeNs, __ATOMIC_RELAXED);
+
+	__atomic_fetch_add(&stats->Contentions, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&stats->WaitTimeNs, waitTimeNs, __ATOMIC_RELAXED);
+	while (waitTimeNs > maxWaitTimeNs &&
+	 !__atomic_compare_exchange_n(&stats->MaxWaitTimeNs, &maxWaitTimeNs, waitTimeNs, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		//Retry with the updated maximum
+	}
+}
+#endif
+
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+static void SchM_CanNm_MutexesInit( void )
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	for (uint8 area = 0; area < CANNM_EXCLUSIVE_AREA_COUNT; area++) {
+		for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+			pthread_mutex_init(&SchM_CanNm_Mutexes[area][channel].Mutex, &attr);
+		}
+	}
+	pthread_mutexattr_destroy(&attr);
+}
+#endif
+
+/*====================================================================================================================*\
+    Global functions code
+\*====================================================================================================================*/
+#if (SCHM_CANNM_BACKEND != SCHM_CANNM_BACKEND_NONE) || (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+
+/** @brief SchM_Enter_CanNm
+ *
+ * Enter the exclusive area of a channel. Nested entries by the same context are allowed.
+ */
+void SchM_Enter_CanNm(SchM_CanNm_ExclusiveAreaType area, NetworkHandleType channel)
+{
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_IRQLOCK)
+	(void)area;
+	(void)channel;
+	SCHM_CANNM_DISABLE_INTERRUPTS();
+	if (SchM_CanNm_IrqLockDepth++ == 0) {
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+		SchM_CanNm_CountEntry(area);
+#endif
+	}
+#elif (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_SPINLOCK)
+	SchM_CanNm_SpinlockType* spinlock = &SchM_CanNm_Spinlocks[area][channel];
+	const void* self = &SchM_CanNm_ThreadToken;
+
+	SCHM_CANNM_DISABLE_INTERRUPTS();					//SuspendAllInterrupts before GetSpinlock, no ISR of this core gets in
+	SchM_CanNm_LocalLockDepth++;
+	if (__atomic_load_n(&spinlock->Owner, __ATOMIC_RELAXED) == self) {
+		spinlock->Depth++;
+		return;
+	}
+	if (__atomic_exchange_n(&spinlock->Lock, 1, __ATOMIC_ACQUIRE) != 0) {
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+		uint64 waitStart = SCHM_CANNM_GET_TIME_NS();
+#endif
+		do {
+			while (__atomic_load_n(&spinlock->Lock, __ATOMIC_RELAXED) != 0) {
+				SCHM_CANNM_CPU_RELAX();
+			}
+		} while (__atomic_exchange_n(&spinlock->Lock, 1, __ATOMIC_ACQUIRE) != 0);
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+		SchM_CanNm_CountContention(area, SCHM_CANNM_GET_TIME_NS() - waitStart);
+#endif
+	}
+	__atomic_store_n(&spinlock->Owner, self, __ATOMIC_RELAXED);
+	spinlock->Depth = 1;
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+	SchM_CanNm_CountEntry(area);
+#endif
+#elif (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+	SchM_CanNm_MutexType* mutex = &SchM_CanNm_Mutexes[area][channel];
+
+	pthread_once(&SchM_CanNm_MutexesOnce, SchM_CanNm_MutexesInit);
+	if (pthread_mutex_trylock(&mutex->Mutex) != 0) {
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+		uint64 waitStart = SCHM_CANNM_GET_TIME_NS();
+		pthread_mutex_lock(&mutex->Mutex);
+		SchM_CanNm_CountContention(area, SCHM_CANNM_GET_TIME_NS() - waitStart);
+#else
+		pthread_mutex_lock(&mutex->Mutex);
+#endif
+	}
+	if (mutex->Depth++ == 0) {
+#if (SCHM_CANNM_CONTENTION_STATS == STD_ON)
+		SchM_CanNm_CountEntry(area);
+#endif
+	}
+#else
+	(void)channel;
+	SchM_CanNm_CountEntry(area);
+#endif
+}
+
+/** @brief SchM_Exit_CanNm
+ *
+ * Leave the exclusive area of a channel entered by SchM_Enter_CanNm.
+ */
+void SchM_Exit_CanNm(SchM_CanNm_ExclusiveAreaType area, NetworkHandleType channel)
+{
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_IRQLOCK)
+	(void)area;
+	(void)channel;
+	if (--SchM_CanNm_IrqLockDepth == 0) {
+		SCHM_CANNM_ENABLE_INTERRUPTS();
+	}
+#elif (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_SPINLOCK)
+	SchM_CanNm_SpinlockType* spinlock = &SchM_CanNm_Spinlocks[area][channel];
+
+	if (--spinlock->Depth == 0) {
+		__atomic_store_n(&spinlock->Owner, NULL, __ATOMIC_RELAXED);
+		__atomic_store_n(&spinlock->Lock, 0, __ATOMIC_RELEASE);
+	}
+	if (--SchM_CanNm_LocalLockDepth == 0) {
+		SCHM_CANNM_ENABLE_INTERRUPTS();
+	}
+#elif (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_PTHREAD)
+	SchM_CanNm_MutexType* mutex = &SchM_CanNm_Mutexes[area][channel];
+
+	mutex->Depth--;
+	pthread_mutex_unlock(&mutex->Mutex);
+#else
+	(void)area;
+	(void)channel;
+#endif
+}
+
+#endif
+
+/** @brief SchM_CanNm_GetContentionStats
+ *
+ * Copy the entry and contention counters of an exclusive area. All zero when SCHM_CANNM_CONTENTION_STATS is off.
+ */
+void SchM_CanNm_GetContentionStats(SchM_CanNm_ExclusiveAreaType area, SchM_CanNm_ContentionStatsType* stats)
+{
+	stats->Entries = __atomic_load_n(&SchM_CanNm_Stats[area].Entries, __ATOMIC_RELAXED);
+	stats->Contentions = __atomic_load_n(&SchM_CanNm_Stats[area].Contentions, __ATOMIC_RELAXED);
+	stats->WaitTimeNs = __atomic_load_n(&SchM_CanNm_Stats[area].WaitTimeNs, __ATOMIC_RELAXED);
+	stats->MaxWaitTimeNs = __atomic_load_n(&SchM_CanNm_Stats[area].MaxWaitTimeNs, __ATOMIC_RELAXED);
+}
+
+/** @brief SchM_CanNm_ResetContentionStats
+ *
+ * Clear the counters of all exclusive areas.
+ */
+void SchM_CanNm_ResetContentionStats(void)
+{
+	memset(SchM_CanNm_Stats, 0, sizeof(SchM_CanNm_Stats));
+}
@@ -1,6 +1,90 @@
 #ifndef SCHM_CANNM_H
 #define SCHM_CANNM_H
 
+/**===================================================================================================================*\
+  @file SchM_CanNm.h
+
+  @brief BSW Scheduler interface of the Can Network Management Module
+
+  Main function declaration and exclusive areas protecting CanNm read-modify-write sequences. Every exclusive area
+  is instantiated once per channel, so concurrent activity on different channels never serializes.
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+
+/*====================================================================================================================*\
+    Global macros
+\*====================================================================================================================*/
+/* Exclusive area backends */
+#define SCHM_CANNM_BACKEND_NONE			0	/* Single context build, exclusive areas compile to nothing */
+#define SCHM_CANNM_BACKEND_IRQLOCK		1	/* Single core, interrupt lock around the area */
+#define SCHM_CANNM_BACKEND_SPINLOCK		2	/* Multi core, local interrupt lock and recursive spinlock per channel and area */
+#define SCHM_CANNM_BACKEND_PTHREAD		3	/* Host build, recursive pthread mutex per channel and area */
+
+#ifndef SCHM_CANNM_BACKEND
+#define SCHM_CANNM_BACKEND SCHM_CANNM_BACKEND_NONE
+#endif
+
+/* Entry and contention time counters per exclusive area */
+#ifndef SCHM_CANNM_CONTENTION_STATS
+#define SCHM_CANNM_CONTENTION_STATS STD_OFF
+#endif
+
+/* Interrupt lock primitives, to be mapped on the OS services (e.g. SuspendAllInterrupts). Used by the IRQLOCK and
+   SPINLOCK backends; left as compiler barriers, CanNm must not be called from an ISR or signal handler */
+#ifndef SCHM_CANNM_DISABLE_INTERRUPTS
+#define SCHM_CANNM_DISABLE_INTERRUPTS()	__asm__ volatile ("" ::: "memory")
+#endif
+
+#ifndef SCHM_CANNM_ENABLE_INTERRUPTS
+#define SCHM_CANNM_ENABLE_INTERRUPTS()	__asm__ volatile ("" ::: "memory")
+#endif
+
+/*====================================================================================================================*\
+    Global types
+\*====================================================================================================================*/
+/** @brief Exclusive areas of the CanNm
+ *
+ * Areas have to be nested in declaration order only: CHANNEL may enclose TXPDU, TXSUPERVISION and TXLIMITER, never
+ * the other way round.
+ *
+ * No callout (Nm, CanSM and PduR call-backs, CanIf_Transmit) is made while any area is held: callouts are collected
+ * under the area and made after the outermost SchM_Exit_CanNm, so a caller holding its own lock across a CanNm API
+ * and taking it again in a call-back cannot deadlock against CanNm.
+ */
+typedef enum {
+	CANNM_EXCLUSIVE_AREA_CHANNEL,	/* Mode, state, timers, flags and receive buffer of a channel */
+	CANNM_EXCLUSIVE_AREA_TXPDU,		/* Transmit PDU buffer of a channel: NID, CBV and user data */
+	CANNM_EXCLUSIVE_AREA_TXSUPERVISION,	/* Transmit confirmation deadlines of all channels, entered with channel 0 */
+	CANNM_EXCLUSIVE_AREA_TXLIMITER,	/* Transmit token bucket of a controller, entered with the controller index */
+	CANNM_EXCLUSIVE_AREA_COUNT
+} SchM_CanNm_ExclusiveAreaType;
+
+typedef struct {
+	uint32	Entries;		/* Number of outermost entries */
+	uint32	Contentions;	/* Number of entries which had to wait for another context */
+	uint64	WaitTimeNs;		/* Accumulated waiting time */
+	uint64	MaxWaitTimeNs;	/* Longest single wait */
+} SchM_CanNm_ContentionStatsType;
+
+/*====================================================================================================================*\
+    Global functions declarations
+\*====================================================================================================================*/
 void CanNm_MainFunction(void);
 
+#if (SCHM_CANNM_BACKEND == SCHM_CANNM_BACKEND_NONE) && (SCHM_CANNM_CONTENTION_STATS == STD_OFF)
+#define SchM_Enter_CanNm(area, channel)	((void)(area), (void)(channel))
+#define SchM_Exit_CanNm(area, channel)	((void)(area), (void)(channel))
+#else
+void SchM_Enter_CanNm(SchM_CanNm_ExclusiveAreaType area, NetworkHandleType channel);
+void SchM_Exit_CanNm(SchM_CanNm_ExclusiveAreaType area, NetworkHandleType channel);
+#endif
+
+void SchM_CanNm_GetContentionStats(SchM_CanNm_ExclusiveAreaType area, SchM_CanNm_ContentionStatsType* stats);
+void SchM_CanNm_ResetContentionStats(void);
+
 #endif /* SCHM_CANNM_H */
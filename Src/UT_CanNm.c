@@ -4,6 +4,18 @@
   @brief Unit tests for Can Network Management Module
 \*====================================================================================================================*/
 #define UNIT_TEST
+#define SCHM_CANNM_BACKEND SCHM_CANNM_BACKEND_SPINLOCK
+#define SCHM_CANNM_CONTENTION_STATS STD_ON
+#define CANNM_TRACE_ENABLED STD_ON
+#define CANNM_TRACE_RING_SIZE 4
+#define CANNM_STATISTICS_ENABLED STD_ON
+#define CANNM_LATENCY_ENABLED STD_ON
+#define CANNM_VIRTUAL_CLOCK_ENABLED STD_ON
+#define CANNM_DEFERRED_NOTIFICATIONS_ENABLED STD_ON
+#define CANNM_NOTIFICATION_QUEUE_SIZE 4
+#define CANNM_LAZY_INIT_ENABLED STD_ON
+#define CANNM_CONFIG_IMAGE_ENABLED STD_ON
+#define CANNM_RECONFIGURE_ENABLED STD_ON
 
 /*====================================================================================================================*\
     Include headers
@@ -13,6 +25,9 @@
 #include "fff.h"
 #include "CanNm.h"
 #include "CanNm.c"
+#include "SchM_CanNm.c"
+#include <pthread.h>
+#include <math.h>
 
 /*====================================================================================================================*\
     Local macros
@@ -188,18 +203,18 @@ void Test_Of_CanNm_Init(void)
 	TEST_CHECK(CanNm_ConfigPtr == &canNmConfig);                        //[SWS_CanNm_00060]
 
 	if (canNmConfig.GlobalPnSupport) {
-		TEST_CHECK(CanNm_Internal.Channels[0].TimeoutTimer.State == CANNM_TIMER_STOPPED);   //[SWS_CanNm_00061]
+		TEST_CHECK(!CanNm_Internal_TimerIsStarted(&CanNm_Internal.Channels[0], CANNM_TIMER_TIMEOUT));   //[SWS_CanNm_00061]
 	}
 	TEST_CHECK(CanNm_Internal.Channels[0].BusLoadReduction == 0);                           //[SWS_CanNm_00023]
-	TEST_CHECK(CanNm_Internal.Channels[0].MessageCycleTimer.State == CANNM_TIMER_STOPPED);  //[SWS_CanNm_00033]
+	TEST_CHECK(!CanNm_Internal_TimerIsStarted(&CanNm_Internal.Channels[0], CANNM_TIMER_MESSAGE_CYCLE));  //[SWS_CanNm_00033]
 
-	uint8* destUserData = CanNm_Internal_GetUserDataPtr(canNmChannel, canNmChannel->TxPdu->TxPduRef->SduDataPtr);
+	uint8* destUserData = CanNm_Internal_GetUserDataPtr(canNmChannel, CanNm_Internal.Pdus[0].Tx);
 	uint8 userDataLength = CanNm_Internal_GetUserDataLength(canNmChannel);
 	for (uint8* ptr = destUserData; ptr < (destUserData + userDataLength); ptr++) {
 		TEST_CHECK(*destUserData == 0xFF);  //[SWS_CanNm_00025]
 	}
 
-	uint8 pduCbv = canNmChannel->TxPdu->TxPduRef->SduDataPtr[canNmChannel[0].PduCbvPosition];
+	uint8 pduCbv = CanNm_Internal.Pdus[0].Tx[canNmChannel[0].PduCbvPosition];
 	TEST_CHECK(pduCbv == 0x00); //[SWS_CanNm_00085]
 }
 
@@ -238,6 +253,7 @@ void Test_Of_CanNm_NetworkRequest(void)
 	TEST_CHECK(ChannelInternal->TxEnabled == TRUE);
 
 	ChannelInternal->Mode = NM_MODE_PREPARE_BUS_SLEEP;
+	ChannelInternal->State = NM_STATE_PREPARE_BUS_SLEEP;
 	status = CanNm_NetworkRequest(nmChannelHandle);
 	TEST_CHECK(status == E_OK);
 	TEST_CHECK(ChannelInternal->Mode == NM_MODE_NETWORK);
@@ -320,7 +336,7 @@ void Test_Of_CanNm_EnableCommunication(void)
 
 	canNmConfig.PassiveModeEnabled = 1;
 	CanNm_Init(&canNmConfig);
-	ChannelInternal->MessageCycleTimer.State = CANNM_TIMER_STARTED;
+	CanNm_Internal_TimerStart(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE, 1);
 	status = CanNm_EnableCommunication(nmChannelHandle);
 	TEST_CHECK(status == E_NOT_OK);
 }
@@ -403,7 +419,7 @@ void Test_Of_CanNm_RepeatMessageRequest(void)
 	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
 	Std_ReturnType status;
 
-	canNmConfig.ChannelConfig[0]->NodeDetectionEnabled = 1;
+	canNmChannel[0].NodeDetectionEnabled = 1;
 	CanNm_Init(&canNmConfig);
 	ChannelInternal->State = NM_STATE_READY_SLEEP;
 	status = CanNm_RepeatMessageRequest(nmChannelHandle);
@@ -423,7 +439,7 @@ void Test_Of_CanNm_GetPduData(void)
 	TEST_CHECK(status == NM_E_NOT_OK);
 	CanNm_DeInit();
 
-	canNmConfig.ChannelConfig[0]->NodeDetectionEnabled = 1;
+	canNmChannel[0].NodeDetectionEnabled = 1;
 	CanNm_Init(&canNmConfig);
 	ChannelInternal->RxLastPdu = 1;
 	status = CanNm_GetPduData(nmChannelHandle, &nmPduDataPtr);
@@ -556,141 +572,1248 @@ void Test_Of_CanNm_TriggerTransmit(void)
 	TEST_CHECK(status == E_OK);
 }
 
+static uint32 StateMachineTicks;
+
+/* Run the main function until it has been called ticks times since CanNm_Init */
+static void StateMachineRunTo(uint32 ticks)
+{
+	CanNm_FastForward(ticks - StateMachineTicks);
+	StateMachineTicks = ticks;
+}
+
 void Test_Of_State_Machine(void)
 {
 	Std_ReturnType status;
-	uint32 tick;
 
-	for (tick = 0; tick < 10000000UL; tick++){
-		if (tick ==0){
-			CanNm_Init(&canNmConfig);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-		}
+	StateMachineTicks = 0;
 
-		else if (tick ==50000){
-			TEST_CHECK(status == E_OK);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			TEST_CHECK(status == E_OK);
-		}
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
 
-		else if (tick ==70000){
-			status = CanNm_NetworkRequest(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(50000);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==90000){
-			status = CanNm_CheckRemoteSleepInd(nmChannelHandle, &nmRemoteSleepIndPtr);
-			status = CanNm_RepeatMessageRequest(nmChannelHandle);
-			status = CanNm_RequestBusSynchronization(nmChannelHandle);
-			status = CanNm_RepeatMessageRequest(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(70000);
+	status = CanNm_NetworkRequest(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(status == E_OK);
 
+	StateMachineRunTo(90000);
+	status = CanNm_CheckRemoteSleepInd(nmChannelHandle, &nmRemoteSleepIndPtr);
+	status = CanNm_RepeatMessageRequest(nmChannelHandle);
+	status = CanNm_RequestBusSynchronization(nmChannelHandle);
+	status = CanNm_RepeatMessageRequest(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==220000){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_NORMAL_OPERATION);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(220000);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_NORMAL_OPERATION);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==490000){
+	StateMachineRunTo(490000);
+	status = CanNm_CheckRemoteSleepInd(nmChannelHandle, &nmRemoteSleepIndPtr);
+	status = CanNm_RepeatMessageRequest(nmChannelHandle);
+	status = CanNm_RequestBusSynchronization(nmChannelHandle);
+	status = CanNm_RepeatMessageRequest(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(status == E_OK);
 
-			status = CanNm_CheckRemoteSleepInd(nmChannelHandle, &nmRemoteSleepIndPtr);
-			status = CanNm_RepeatMessageRequest(nmChannelHandle);
-			status = CanNm_RequestBusSynchronization(nmChannelHandle);
-			status = CanNm_RepeatMessageRequest(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(1400000);
+	status = CanNm_NetworkRelease(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_READY_SLEEP);
+	status = CanNm_PassiveStartUp(nmChannelHandle);
+	status = CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(status == E_OK);
+	status = CanNm_NetworkRelease(nmChannelHandle);
 
-		else if (tick ==1400000){
-			status = CanNm_NetworkRelease(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_READY_SLEEP);
-			status = CanNm_PassiveStartUp(nmChannelHandle);
-			status = CanNm_NetworkRequest(nmChannelHandle);
-			TEST_CHECK(status == E_OK);
-			status = CanNm_NetworkRelease(nmChannelHandle);
-		}
+	StateMachineRunTo(1400101);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_PREPARE_BUS_SLEEP);
+	status = CanNm_NetworkRelease(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_PREPARE_BUS_SLEEP);
+	TEST_CHECK(status == E_OK);
+
+	StateMachineRunTo(1401180);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	status = CanNm_NetworkRelease(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(status == E_OK);
 
+	StateMachineRunTo(1800000);
+	status = CanNm_NetworkRequest(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(status == E_OK);
+	status = CanNm_NetworkRelease(nmChannelHandle);
 
-		else if (tick ==1400101){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_PREPARE_BUS_SLEEP);
-			status = CanNm_NetworkRelease(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_PREPARE_BUS_SLEEP);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(1900000);
+	status = CanNm_DisableCommunication(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(status == E_OK);
+	status = CanNm_NetworkRequest(nmChannelHandle);
 
-		else if (tick ==1401180){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			status = CanNm_NetworkRelease(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			TEST_CHECK(status == E_OK);
-		}
+	StateMachineRunTo(2500000);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_NORMAL_OPERATION);
+	TEST_CHECK(status == E_OK);
+	status = CanNm_RepeatMessageRequest(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
 
+	StateMachineRunTo(2601050);
+	status = CanNm_NetworkRelease(nmChannelHandle);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_READY_SLEEP);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==1800000){
-			status = CanNm_NetworkRequest(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
-			TEST_CHECK(status == E_OK);
-			status = CanNm_NetworkRelease(nmChannelHandle);
-		}
+	StateMachineRunTo(2605050);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	CanNm_DeInit();
+	TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==1900000){
-			status = CanNm_DisableCommunication(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			TEST_CHECK(status == E_OK);
-			status = CanNm_NetworkRequest(nmChannelHandle);
-		}
+	StateMachineRunTo(2809050);
+	status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
+	TEST_CHECK(nmStatePtr == NM_STATE_UNINIT);
+	TEST_CHECK(status == E_OK);
 
-		else if (tick ==2500000){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_NORMAL_OPERATION);
-			TEST_CHECK(status == E_OK);
-			status = CanNm_RepeatMessageRequest(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_REPEAT_MESSAGE);
-		}
+	StateMachineRunTo(10000000UL);
+	TEST_CHECK(status == E_OK);
+}
 
-		else if (tick ==2601050){
-			status = CanNm_NetworkRelease(nmChannelHandle);
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_READY_SLEEP);
-			TEST_CHECK(status == E_OK);
-		}
+static uint32 SchMTestSharedCounter;
 
-		else if (tick ==2605050){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			CanNm_DeInit();
-			TEST_CHECK(nmStatePtr == NM_STATE_BUS_SLEEP);
-			TEST_CHECK(status == E_OK);
-		}
+static void* SchMTestWorker(void* arg)
+{
+	for (uint32 i = 0; i < 100000UL; i++) {
+		SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);
+		SchMTestSharedCounter++;
+		SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);
+	}
+	return arg;
+}
 
-		else if (tick ==2809050){
-			status = CanNm_GetState(nmChannelHandle, &nmStatePtr, &nmModePtr);
-			TEST_CHECK(nmStatePtr == NM_STATE_UNINIT);
-			TEST_CHECK(status == E_OK);
-		}
+void Test_Of_SchM_CanNm_ExclusiveAreas(void)
+{
+	SchM_CanNm_ContentionStatsType stats;
+	pthread_t worker;
+
+	SchM_CanNm_ResetContentionStats();
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);	//Nested entry by the same context
+	SchM_Enter_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, 0);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_TXPDU, 0);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);
+	SchM_Exit_CanNm(CANNM_EXCLUSIVE_AREA_CHANNEL, 0);
+	SchM_CanNm_GetContentionStats(CANNM_EXCLUSIVE_AREA_CHANNEL, &stats);
+	TEST_CHECK(stats.Entries == 1);
+	TEST_CHECK(stats.Contentions == 0);
+
+	SchMTestSharedCounter = 0;
+	pthread_create(&worker, NULL, SchMTestWorker, NULL);
+	SchMTestWorker(NULL);
+	pthread_join(worker, NULL);
+	TEST_CHECK(SchMTestSharedCounter == 200000UL);
+	SchM_CanNm_GetContentionStats(CANNM_EXCLUSIVE_AREA_CHANNEL, &stats);
+	TEST_CHECK(stats.Entries == 200001UL);
+	TEST_CHECK(stats.WaitTimeNs >= stats.MaxWaitTimeNs);
+
+	/* Channel APIs leave every area they enter */
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_MainFunction();
+	CanNm_NetworkRelease(nmChannelHandle);
+	TEST_CHECK(SchM_CanNm_Spinlocks[CANNM_EXCLUSIVE_AREA_CHANNEL][0].Lock == 0);
+	TEST_CHECK(SchM_CanNm_Spinlocks[CANNM_EXCLUSIVE_AREA_TXPDU][0].Lock == 0);
+}
 
+void Test_Of_CanNm_TraceRead(void)
+{
+	CanNm_TraceRecordType records[CANNM_TRACE_RING_SIZE];
+	uint32 cursor = 0;
+	uint32 count;
+
+	CanNm_Init(&canNmConfig);
+	while (CanNm_TraceRead(nmChannelHandle, &cursor, records, CANNM_TRACE_RING_SIZE) != 0) {
+		//Drop records of earlier tests
+	}
+
+	CanNm_NetworkRequest(nmChannelHandle);
+	count = CanNm_TraceRead(nmChannelHandle, &cursor, records, CANNM_TRACE_RING_SIZE);
+	TEST_CHECK(count == 1);
+	TEST_CHECK(records[0].Event == CANNM_TRACE_EVENT_TRANSITION);
+	TEST_CHECK(records[0].Arg0 == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(records[0].Arg1 == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(records[0].Timestamp == CanNm_GetMainFunctionTicks());
+
+	canNmRxPduInfo.SduDataPtr[canNmChannel[0].PduCbvPosition] = 0x00;
+	CanNm_RxIndication(RxPduId, &canNmRxPduInfo);
+	count = CanNm_TraceRead(nmChannelHandle, &cursor, records, CANNM_TRACE_RING_SIZE);
+	TEST_CHECK(count == 2);
+	TEST_CHECK(records[0].Event == CANNM_TRACE_EVENT_RX);
+	TEST_CHECK(records[1].Event == CANNM_TRACE_EVENT_TRANSITION);
+	TEST_CHECK(records[1].Sequence == records[0].Sequence + 1);
+
+	/* Overrun: only the newest records survive, the gap shows in the sequence numbers */
+	uint32 lastSequence = records[1].Sequence;
+	for (uint8 i = 0; i < 3; i++) {	//Two records per reception
+		CanNm_RxIndication(RxPduId, &canNmRxPduInfo);
+	}
+	count = CanNm_TraceRead(nmChannelHandle, &cursor, records, CANNM_TRACE_RING_SIZE);
+	TEST_CHECK(count == CANNM_TRACE_RING_SIZE - 1);
+	TEST_CHECK(records[0].Sequence > lastSequence + 1);
+	TEST_CHECK(records[CANNM_TRACE_RING_SIZE - 2].Sequence == cursor - 1);
+	TEST_CHECK(CanNm_TraceRead(nmChannelHandle, &cursor, records, CANNM_TRACE_RING_SIZE) == 0);
+}
+
+void Test_Of_CanNm_GetStatistics(void)
+{
+	CanNm_StatisticsType statistics;
+
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_GetStatistics(nmChannelHandle, &statistics) == E_OK);
+	TEST_CHECK(statistics.RxCount == 0);
+	TEST_CHECK(statistics.TxCount == 0);
+
+	for (uint8 i = 0; i < 3; i++) {
 		CanNm_MainFunction();
 	}
+	CanNm_NetworkRequest(nmChannelHandle);
+	for (uint8 i = 0; i < 10; i++) {
+		CanNm_MainFunction();
+	}
+	CanNm_RxIndication(RxPduId, &canNmRxPduInfo);
+	CanIf_Transmit_fake.return_val = E_NOT_OK;
+	CanNm_Internal_TransmitMessage(canNmChannel, &CanNm_Internal.Channels[nmChannelHandle], FALSE);
+	CanNm_Internal_FlushCallouts(nmChannelHandle);
+	CanIf_Transmit_fake.return_val = E_OK;
+
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.RxCount == 1);
+	TEST_CHECK(statistics.TxCount == 1);			//First message after MsgCycleOffset
+	TEST_CHECK(statistics.TxFailedCount == 1);
+	TEST_CHECK(statistics.StateTime[NM_STATE_BUS_SLEEP] == 3.0f);
+	TEST_CHECK(statistics.StateTime[NM_STATE_REPEAT_MESSAGE] == 10.0f);
+
+	TEST_CHECK(CanNm_ResetStatistics(nmChannelHandle) == E_OK);
+	CanNm_MainFunction();
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.RxCount == 0);
+	TEST_CHECK(statistics.TxFailedCount == 0);
+	TEST_CHECK(statistics.StateTime[NM_STATE_BUS_SLEEP] == 0.0f);
+	TEST_CHECK(statistics.StateTime[NM_STATE_REPEAT_MESSAGE] == 1.0f);
+}
 
-	TEST_CHECK(status == E_OK);
+void Test_Of_CanNm_GetLatencyHistogram(void)
+{
+	CanNm_LatencyHistogramType histogram;
+	uint32 bucketTotal = 0;
+
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_NetworkRequest(nmChannelHandle);	//Repeated request keeps the first start time
+	for (uint8 i = 0; i < 10; i++) {
+		CanNm_MainFunction();
+	}
+	TEST_CHECK(CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_NETWORK_REQUEST_TO_TX, &histogram) == E_OK);
+	TEST_CHECK(histogram.TimeUnitNs == 1000000UL);
+	TEST_CHECK(histogram.Count == 1);
+	TEST_CHECK(histogram.Min == histogram.Max);
+	TEST_CHECK(histogram.Max >= 5 && histogram.Max <= 6);		//MsgCycleOffset
+	TEST_CHECK(histogram.Buckets[3] == 1);						//[4, 8) ticks
+
+	CanNm_NetworkRelease(nmChannelHandle);
+	for (uint16 i = 0; i < 3000; i++) {
+		CanNm_MainFunction();
+	}
+	CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_NETWORK_RELEASE_TO_BUS_SLEEP, &histogram);
+	TEST_CHECK(CanNm_Internal.Channels[nmChannelHandle].Mode == NM_MODE_BUS_SLEEP);
+	TEST_CHECK(histogram.Count == 1);
+	TEST_CHECK(histogram.Sum >= 1000);							//At least WaitBusSleepTime
+	for (uint8 bucket = 0; bucket < CANNM_LATENCY_BUCKET_COUNT; bucket++) {
+		bucketTotal += histogram.Buckets[bucket];
+	}
+	TEST_CHECK(bucketTotal == histogram.Count);
+
+	CanNm_RxIndication(RxPduId, &canNmRxPduInfo);
+	CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_RX_TO_NETWORK_START, &histogram);
+	TEST_CHECK(histogram.Count == 1);
+	TEST_CHECK(histogram.Buckets[0] == 1);						//Indicated within the same tick
+
+	TEST_CHECK(CanNm_ResetLatencyHistograms(nmChannelHandle) == E_OK);
+	CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_RX_TO_NETWORK_START, &histogram);
+	TEST_CHECK(histogram.Count == 0);
+	TEST_CHECK(CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_PATH_COUNT, &histogram) == E_NOT_OK);
+}
+
+#define VIRTUAL_CLOCK_MAX_TRANSITIONS 256
 
+typedef struct {
+	uint32			Tick;
+	Nm_StateType	PreviousState;
+	Nm_StateType	CurrentState;
+} VirtualClockTransitionType;
+
+static VirtualClockTransitionType VirtualClockTransitions[VIRTUAL_CLOCK_MAX_TRANSITIONS];
+static uint32 VirtualClockTransitionCount;
+
+static void VirtualClockRecordTransition(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState, Nm_StateType nmCurrentState)
+{
+	(void)nmNetworkHandle;
+	if (VirtualClockTransitionCount < VIRTUAL_CLOCK_MAX_TRANSITIONS) {
+		VirtualClockTransitions[VirtualClockTransitionCount].Tick = CanNm_GetMainFunctionTicks();
+		VirtualClockTransitions[VirtualClockTransitionCount].PreviousState = nmPreviousState;
+		VirtualClockTransitions[VirtualClockTransitionCount].CurrentState = nmCurrentState;
+	}
+	VirtualClockTransitionCount++;
+}
+
+/* Wake-up, repeat message, remote reception, release and sleep; returns the main function ticks at the end */
+static uint32 VirtualClockScenario(boolean fastForward)
+{
+	static const uint32 actionTicks[] = { 100, 3000, 5000, 20000, 40000, 41000, 60000, 61000, 62000, 200000 };
+	uint32 start = CanNm_GetMainFunctionTicks();
+	uint32 ticks = 0;
+
+	CanNm_Init(&canNmConfig);
+	VirtualClockTransitionCount = 0;
+	for (uint8 action = 0; action < (sizeof(actionTicks) / sizeof(actionTicks[0])); action++) {
+		if (fastForward) {
+			CanNm_FastForward(actionTicks[action] - ticks);
+		} else {
+			for (uint32 tick = ticks; tick < actionTicks[action]; tick++) {
+				CanNm_MainFunction();
+			}
+		}
+		ticks = actionTicks[action];
+
+		switch (action) {
+		case 0: CanNm_NetworkRequest(nmChannelHandle); break;
+		case 1: CanNm_RepeatMessageRequest(nmChannelHandle); break;
+		case 2: CanNm_RxIndication(RxPduId, &canNmRxPduInfo); break;
+		case 3: CanNm_NetworkRelease(nmChannelHandle); break;
+		case 4: CanNm_RxIndication(RxPduId, &canNmRxPduInfo); break;
+		case 5: CanNm_PassiveStartUp(nmChannelHandle); break;
+		case 6: CanNm_NetworkRequest(nmChannelHandle); break;
+		case 7: CanNm_NetworkRelease(nmChannelHandle); break;
+		case 8: CanNm_RxIndication(RxPduId, &canNmRxPduInfo); break;
+		default: break;
+		}
+	}
+	return CanNm_GetMainFunctionTicks() - start;
 }
+
+void Test_Of_CanNm_FastForward(void)
+{
+	VirtualClockTransitionType fixedStep[VIRTUAL_CLOCK_MAX_TRANSITIONS];
+	uint32 fixedStepCount;
+	uint32 fixedStepTicks;
+	uint32 fastForwardTicks;
+	uint32 origin;
+
+	canNmConfig.StateChangeIndEnabled = TRUE;
+	Nm_StateChangeNotification_fake.custom_fake = VirtualClockRecordTransition;
+	canNmRxPduInfo.SduDataPtr[canNmChannel[0].PduCbvPosition] = 0x00;
+
+	/* Ticks are recorded relative to the start of each run */
+	origin = CanNm_GetMainFunctionTicks();
+	fixedStepTicks = VirtualClockScenario(FALSE);
+	fixedStepCount = VirtualClockTransitionCount;
+	for (uint32 transition = 0; transition < fixedStepCount; transition++) {
+		fixedStep[transition] = VirtualClockTransitions[transition];
+		fixedStep[transition].Tick -= origin;
+	}
+	origin = CanNm_GetMainFunctionTicks();
+	fastForwardTicks = VirtualClockScenario(TRUE);
+
+	TEST_CHECK(fixedStepTicks == fastForwardTicks);
+	TEST_CHECK(fixedStepCount > 5);
+	TEST_CHECK(fixedStepCount <= VIRTUAL_CLOCK_MAX_TRANSITIONS);
+	TEST_CHECK(VirtualClockTransitionCount == fixedStepCount);
+	for (uint32 transition = 0; transition < fixedStepCount && transition < VirtualClockTransitionCount; transition++) {
+		TEST_CHECK(VirtualClockTransitions[transition].Tick - origin == fixedStep[transition].Tick);
+		TEST_CHECK(VirtualClockTransitions[transition].PreviousState == fixedStep[transition].PreviousState);
+		TEST_CHECK(VirtualClockTransitions[transition].CurrentState == fixedStep[transition].CurrentState);
+	}
+
+	/* Nothing expires in bus-sleep, so hours of network time cost a single step */
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_GetTicksToNextExpiry() == CANNM_NO_TIMER_EXPIRY);
+	origin = CanNm_GetMainFunctionTicks();
+	CanNm_FastForward(10UL * 3600UL * 1000UL);
+	TEST_CHECK(CanNm_GetMainFunctionTicks() - origin == 10UL * 3600UL * 1000UL);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_GetTicksToNextExpiry() == (uint32)canNmChannel[0].MsgCycleOffset);
+
+	Nm_StateChangeNotification_fake.custom_fake = NULL;
+	canNmConfig.StateChangeIndEnabled = FALSE;
+}
+
+void Test_Of_CanNm_RxPduChannelMap(void)
+{
+	static const NetworkHandleType rxPduChannelMap[] = { CANNM_INVALID_CHANNEL, 0 };
+	CanNm_StatisticsType statistics;
+
+	canNmConfig.RxPduChannelMap = rxPduChannelMap;
+	canNmConfig.RxPduCount = 2;
+	CanNm_Init(&canNmConfig);
+
+	/* Unmapped and out of range ids are dropped */
+	CanNm_RxIndication(0, &PduInfoPtr);
+	CanNm_RxIndication(2, &PduInfoPtr);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.RxCount == 0);
+
+	CanNm_RxIndication(1, &PduInfoPtr);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.RxCount == 1);
+	TEST_CHECK(Nm_NetworkStartIndication_fake.call_count == 1);
+	TEST_CHECK(Nm_NetworkStartIndication_fake.arg0_val == nmChannelHandle);
+
+	canNmConfig.RxPduChannelMap = NULL;
+	canNmConfig.RxPduCount = 0;
+}
+
+void Test_Of_CanNm_DeferredNotifications(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	CanNm_StatisticsType statistics;
+	CanNm_LatencyHistogramType histogram;
+
+	canNmConfig.DeferredNotificationsEnabled = TRUE;
+	canNmConfig.StateChangeIndEnabled = TRUE;
+	canNmConfig.PduRxIndicationEnabled = TRUE;
+	CanNm_Init(&canNmConfig);
+
+	/* Nothing reaches the upper layer before the main function, repeated receptions in Bus-Sleep share one record */
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(Nm_NetworkStartIndication_fake.call_count == 0);
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 0);
+	TEST_CHECK(Nm_PduRxIndication_fake.call_count == 0);
+	CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_RX_TO_NETWORK_START, &histogram);
+	TEST_CHECK(histogram.Count == 0);
+	CanNm_MainFunction();
+	TEST_CHECK(Nm_NetworkStartIndication_fake.call_count == 1);
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 1);
+	TEST_CHECK(Nm_PduRxIndication_fake.call_count == 1);
+	CanNm_GetLatencyHistogram(nmChannelHandle, CANNM_LATENCY_RX_TO_NETWORK_START, &histogram);
+	TEST_CHECK(histogram.Count == 1);
+	TEST_CHECK(histogram.Sum == 1);								//Measured to the delivery by the main function
+
+	/* Consecutive state changes are merged, dropped when they end in the state they began */
+	ChannelInternal->Mode = NM_MODE_NETWORK;
+	ChannelInternal->State = NM_STATE_NORMAL_OPERATION;
+	CanNm_NetworkRelease(nmChannelHandle);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal.Notifications[nmChannelHandle].Count == 0);
+	CanNm_MainFunction();
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 1);
+
+	/* A fifth record makes room in the queue of four without delivering in the caller's context, here the state
+	   changes to Ready Sleep and back cancel out */
+	CanNm_NetworkRelease(nmChannelHandle);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_Internal.Notifications[nmChannelHandle].Count == 4);
+	CanNm_NetworkRelease(nmChannelHandle);
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 1);
+	TEST_CHECK(Nm_PduRxIndication_fake.call_count == 1);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.NotificationOverflowCount == 1);
+	TEST_CHECK(CanNm_Internal.Notifications[nmChannelHandle].Count == 3);
+	CanNm_MainFunction();
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 2);
+	TEST_CHECK(Nm_StateChangeNotification_fake.arg1_history[1] == NM_STATE_NORMAL_OPERATION);
+	TEST_CHECK(Nm_StateChangeNotification_fake.arg2_history[1] == NM_STATE_READY_SLEEP);
+	TEST_CHECK(Nm_PduRxIndication_fake.call_count == 3);
+	TEST_CHECK(CanNm_Internal.Notifications[nmChannelHandle].Count == 0);
+	CanNm_DeInit();
+
+	/* Without PDU reception indications, every second reception in Bus-Sleep must not cancel the state change */
+	canNmConfig.PduRxIndicationEnabled = FALSE;
+	CanNm_Init(&canNmConfig);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_Internal.Notifications[nmChannelHandle].Count == 2);
+	CanNm_MainFunction();
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 3);
+	TEST_CHECK(Nm_StateChangeNotification_fake.arg1_val == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(Nm_StateChangeNotification_fake.arg2_val == NM_STATE_BUS_SLEEP);
+}
+
+static uint32 networkModeCalls;
+static uint32 calloutLockDepth;			//Areas held by the test thread during any callout
+
+static void CountNetworkMode(NetworkHandleType nmNetworkHandle)
+{
+	(void)nmNetworkHandle;
+	networkModeCalls++;
+	calloutLockDepth |= SchM_CanNm_LocalLockDepth;
+}
+
+static Std_ReturnType TransmitTriggered(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
+{
+	uint8 sdu[CANNM_PDU_MAX_LENGTH];
+	PduInfoType triggerPduInfo = { .SduDataPtr = sdu, .SduLength = PduInfoPtr->SduLength };
+
+	calloutLockDepth |= SchM_CanNm_LocalLockDepth;
+	return CanNm_TriggerTransmit(TxPduId, &triggerPduInfo);		//Takes the Tx PDU area again
+}
+
+void Test_Of_CanNm_Callbacks(void)
+{
+	static const CanNm_CallbacksType callbacks = {
+		.NmNetworkMode = CountNetworkMode
+	};
+	CanNm_StatisticsType statistics;
+
+	canNmConfig.Callbacks = &callbacks;
+	canNmConfig.StateChangeIndEnabled = TRUE;
+	canNmChannel[0].ImmediateNmTransmissions = 1;
+	canNmChannel[0].ActiveWakeupBitEnabled = 1;
+	CanNm_Init(&canNmConfig);
+
+	/* Only the registered entry is called, without CanIfTransmit the NM PDU counts as sent */
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(networkModeCalls == 1);
+	TEST_CHECK(Nm_NetworkMode_fake.call_count == 0);
+	TEST_CHECK(Nm_StateChangeNotification_fake.call_count == 0);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 0);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxCount == 1);
+	CanNm_DeInit();
+
+	/* Without a table the global functions are called */
+	canNmConfig.Callbacks = NULL;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(Nm_NetworkMode_fake.call_count == 1);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	CanNm_DeInit();
+
+	/* Callouts are made with no exclusive area held, CanIf may trigger the transmission from within */
+	static const CanNm_CallbacksType triggeringCallbacks = {
+		.CanIfTransmit = TransmitTriggered,
+		.NmNetworkMode = CountNetworkMode
+	};
+	canNmConfig.Callbacks = &triggeringCallbacks;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(networkModeCalls == 2);
+	TEST_CHECK(calloutLockDepth == 0);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxCount == 1);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(&CanNm_Internal.Channels[nmChannelHandle], CANNM_TIMER_MESSAGE_CYCLE) ==
+	 CanNm_Internal_TimeToTicks(canNmChannel[0].ImmediateNmCycleTime));		//Restarted with the CanIf result
+}
+
+/**
+ * @brief Bus load reduction test
+ * 
+ * Function testing the node specific reduced cycle of the bus load reduction (7.9)
+*/
+void Test_Of_CanNm_BusLoadReduction(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+
+	canNmChannel[0].BusLoadReductionActive = TRUE;
+	canNmChannel[0].NodeId = 7;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(CanNm_GetTicksToNextExpiry());
+	while (ChannelInternal->State == NM_STATE_REPEAT_MESSAGE) {
+		CanNm_FastForward(CanNm_GetTicksToNextExpiry());
+	}
+	TEST_CHECK(ChannelInternal->State == NM_STATE_NORMAL_OPERATION);
+	TEST_CHECK(ChannelInternal->BusLoadReduction == TRUE);							//[SWS_CanNm_00157]
+
+	/* Derived from the node identifier between half and full MsgCycleTime of 500 ticks */
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 251 + 7);	//[SWS_CanNm_00069]
+
+	/* Own transmission restarts the full cycle */
+	CanNm_FastForward(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE));
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 500);		//[SWS_CanNm_00040]
+
+	/* Repeat Message State stops the reduction */
+	CanNm_RepeatMessageRequest(nmChannelHandle);
+	TEST_CHECK(ChannelInternal->BusLoadReduction == FALSE);							//[SWS_CanNm_00156]
+	CanNm_NetworkRelease(nmChannelHandle);
+	CanNm_DeInit();
+
+	/* A configured MsgReducedTime takes precedence */
+	canNmChannel[0].MsgReducedTime = 300;
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(ChannelInternal->ReducedCycleTicks == 300);
+}
+
+/**
+ * @brief Transmission retry test
+ * 
+ * Function testing the retry policies of failed immediate transmissions
+*/
+void Test_Of_CanNm_TxRetry(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	CanNm_StatisticsType statistics;
+
+	canNmChannel[0].ImmediateNmTransmissions = 3;
+	canNmChannel[0].ImmediateNmCycleTime = 20;
+	canNmChannel[0].ActiveWakeupBitEnabled = TRUE;
+	CanIf_Transmit_fake.return_val = E_NOT_OK;
+
+	/* Default policy retries once with the next main function, then falls back to MsgCycleTime */
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 1);		//[SWS_CanNm_00335]
+	CanNm_MainFunction();
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 0);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 500);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxFailedCount == 2);
+	TEST_CHECK(statistics.TxRetryCount == 1);
+	TEST_CHECK(statistics.TxRetryGiveUpCount == 1);
+	CanNm_DeInit();
+
+	/* Exponential backoff up to TxRetryMaxTime, a success resumes the immediate transmissions */
+	canNmChannel[0].TxRetryPolicy = CANNM_TX_RETRY_EXPONENTIAL;
+	canNmChannel[0].TxRetryTime = 10;
+	canNmChannel[0].TxRetryMaxTime = 30;
+	canNmChannel[0].TxRetryLimit = 4;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 10);
+	CanNm_FastForward(10);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 20);
+	CanNm_FastForward(20);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 30);
+	CanIf_Transmit_fake.return_val = E_OK;
+	CanNm_FastForward(30);
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 2);
+	TEST_CHECK(ChannelInternal->TxRetries == 0);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 20);		//[SWS_CanNm_00334]
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxRetryCount == 3);
+	TEST_CHECK(statistics.TxRetryGiveUpCount == 0);
+	CanNm_DeInit();
+
+	/* Fixed policy gives up after TxRetryLimit failed retries */
+	canNmChannel[0].TxRetryPolicy = CANNM_TX_RETRY_FIXED;
+	canNmChannel[0].TxRetryLimit = 2;
+	CanIf_Transmit_fake.return_val = E_NOT_OK;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(10);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 10);
+	CanNm_FastForward(10);
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 0);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 500);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxRetryCount == 2);
+	TEST_CHECK(statistics.TxRetryGiveUpCount == 1);
+}
+
+/**
+ * @brief Transmit supervision test
+ * 
+ * Function testing the transmit confirmation timeout of MsgTimeoutTime
+*/
+void Test_Of_CanNm_TxSupervision(void)
+{
+	CanNm_StatisticsType statistics;
+
+	canNmChannel[0].MsgTimeoutTime = 20;
+	CanNm_Init(&canNmConfig);
+
+	/* Confirmed in time */
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(5);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	TEST_CHECK(CanNm_GetTicksToNextExpiry() == 20);
+	CanNm_TxConfirmation(nmChannelHandle, E_OK);
+	CanNm_FastForward(100);
+	TEST_CHECK(CanSM_TxTimeoutException_fake.call_count == 0);
+
+	/* A missing confirmation is reported once, MsgTimeoutTime after the first unconfirmed transmission */
+	CanNm_FastForward(400);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 2);
+	CanNm_FastForward(19);
+	TEST_CHECK(CanSM_TxTimeoutException_fake.call_count == 0);
+	CanNm_MainFunction();
+	TEST_CHECK(CanSM_TxTimeoutException_fake.call_count == 1);
+	TEST_CHECK(CanSM_TxTimeoutException_fake.arg0_val == nmChannelHandle);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxConfirmationTimeoutCount == 1);
+
+	/* Without MsgTimeoutTime nothing is supervised */
+	canNmChannel[0].MsgTimeoutTime = 0;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(1000);
+	TEST_CHECK(CanSM_TxTimeoutException_fake.call_count == 1);
+}
+
+static uint8 clusterReadyCalls;
+static uint8 clusterCancellationCalls;
+
+static void CountClusterReady(uint8 coordClusterIndex)
+{
+	(void)coordClusterIndex;
+	clusterReadyCalls++;
+}
+
+static void CountClusterCancellation(uint8 coordClusterIndex)
+{
+	(void)coordClusterIndex;
+	clusterCancellationCalls++;
+}
+
+/**
+ * @brief Coordinated sleep test
+ * 
+ * Function testing the sleep readiness of a coordination cluster and its events
+*/
+void Test_Of_CanNm_CoordinatorSleepReady(void)
+{
+	static const CanNm_CallbacksType callbacks = {
+		.CoordSleepReadyIndication = CountClusterReady,
+		.CoordSleepReadyCancellation = CountClusterCancellation
+	};
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	boolean sleepReady = FALSE;
+
+	canNmConfig.Callbacks = &callbacks;
+	canNmConfig.CoordinationSyncSupport = TRUE;
+	canNmConfig.RemoteSleepIndEnabled = TRUE;
+	TEST_CHECK(CanNm_GetCoordinatorSleepReady(0, &sleepReady) == E_NOT_OK);
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_GetCoordinatorSleepReady(1, &sleepReady) == E_NOT_OK);
+	TEST_CHECK(CanNm_GetCoordinatorSleepReady(0, &sleepReady) == E_OK);
+	TEST_CHECK(sleepReady == TRUE);
+
+	/* The requested channel keeps the cluster awake */
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_GetCoordinatorSleepReady(0, &sleepReady);
+	TEST_CHECK(sleepReady == FALSE);
+	CanNm_MainFunction();
+	TEST_CHECK(clusterCancellationCalls == 1);
+	TEST_CHECK(clusterReadyCalls == 0);
+
+	/* Remote sleep indicated in Normal Operation makes it ready again, reported once */
+	CanNm_FastForward(1000);
+	TEST_CHECK(ChannelInternal->State == NM_STATE_NORMAL_OPERATION);
+	CanNm_FastForward(2000);
+	TEST_CHECK(ChannelInternal->RemoteSleepInd == TRUE);
+	CanNm_GetCoordinatorSleepReady(0, &sleepReady);
+	TEST_CHECK(sleepReady == TRUE);
+	CanNm_MainFunction();
+	CanNm_NetworkRelease(nmChannelHandle);
+	CanNm_MainFunction();
+	TEST_CHECK(clusterReadyCalls == 1);
+	TEST_CHECK(clusterCancellationCalls == 1);
+
+	/* The sleep ready bit follows the argument */
+	CanNm_SetSleepReadyBit(nmChannelHandle, TRUE);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_1] & (1 << NM_COORDINATOR_SLEEP_READY_BIT));
+	CanNm_SetSleepReadyBit(nmChannelHandle, FALSE);
+	TEST_CHECK(!(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_1] & (1 << NM_COORDINATOR_SLEEP_READY_BIT)));
+
+	/* Channels outside every cluster are not tracked */
+	canNmChannel[0].CoordClusterIndex = CANNM_COORD_CLUSTER_NONE;
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_GetCoordinatorSleepReady(0, &sleepReady) == E_NOT_OK);
+}
+
+/**
+ * @brief Transmit rate limit test
+ * 
+ * Function testing the deferral of NM PDUs by the token bucket of the CAN controller
+*/
+void Test_Of_CanNm_TxRateLimit(void)
+{
+	static const CanNm_ControllerType controller = { .TxBucketSize = 1, .TxTokenTime = 10 };
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	CanNm_StatisticsType statistics;
+	uint32 callCount;
+	uint32 cycleTicksLeft;
+
+	canNmChannel[0].ImmediateNmTransmissions = 3;
+	canNmChannel[0].ImmediateNmCycleTime = 1;
+	canNmConfig.ControllerConfig = &controller;
+
+	/* The first immediate transmission empties the bucket, the next one waits for the refill after TxTokenTime */
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	CanNm_MainFunction();
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 2);
+	TEST_CHECK(ChannelInternal->TxRetries == 0);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 1);
+	CanNm_FastForward(9);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 2);
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 1);
+	CanNm_GetStatistics(nmChannelHandle, &statistics);
+	TEST_CHECK(statistics.TxDeferredCount == 9);
+	TEST_CHECK(statistics.TxFailedCount == 0);
+	TEST_CHECK(statistics.TxRetryCount == 0);
+	CanNm_DeInit();
+
+	/* A deferred bus synchronization stays pending without restarting the Message Cycle Timer */
+	canNmChannel[0].ImmediateNmTransmissions = 0;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_RequestBusSynchronization(nmChannelHandle) == E_OK);
+	callCount = CanIf_Transmit_fake.call_count;
+	cycleTicksLeft = CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE);
+	TEST_CHECK(CanNm_RequestBusSynchronization(nmChannelHandle) == E_OK);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == callCount);
+	TEST_CHECK(ChannelInternal->TxPending);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == cycleTicksLeft);
+	TEST_CHECK(CanNm_GetTicksToNextExpiry() == 1);
+	CanNm_FastForward(10);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == callCount + 1);
+	TEST_CHECK(!ChannelInternal->TxPending);
+	CanNm_DeInit();
+
+	/* Channels outside every controller are not limited */
+	canNmChannel[0].ImmediateNmTransmissions = 3;
+	canNmChannel[0].ControllerIndex = CANNM_CONTROLLER_NONE;
+	CanNm_Init(&canNmConfig);
+	callCount = CanIf_Transmit_fake.call_count;
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_MainFunction();
+	TEST_CHECK(CanIf_Transmit_fake.call_count == callCount + 2);
+}
+
+/**
+ * @brief Wake-up staggering test
+ * 
+ * Function testing the delay of the first transmissions after a network start
+*/
+void Test_Of_CanNm_WakeUpStagger(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+
+	canNmChannel[0].ActiveWakeupBitEnabled = FALSE;
+	canNmConfig.WakeUpStaggerTime = 10;
+
+	/* Channel 0 takes the first slot of the window, MsgCycleOffset is kept */
+	canNmConfig.WakeUpStagger = CANNM_WAKEUP_STAGGER_CHANNEL_INDEX;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 5);
+	CanNm_DeInit();
+
+	/* Node identifier 1 on channel 0 hashes to slot 3, added to MsgCycleOffset */
+	canNmConfig.WakeUpStagger = CANNM_WAKEUP_STAGGER_HASH;
+	canNmChannel[0].NodeId = 1;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 8);
+	CanNm_DeInit();
+
+	/* Immediate transmissions of an active wakeup start with the slot instead of the request */
+	canNmChannel[0].ActiveWakeupBitEnabled = TRUE;
+	canNmChannel[0].ImmediateNmTransmissions = 2;
+	canNmChannel[0].ImmediateNmCycleTime = 20;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 0);
+	TEST_CHECK(ChannelInternal->ImmediateTransmissions == 2);
+	CanNm_FastForward(3);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 20);		//[SWS_CanNm_00334]
+
+	/* Leaving and reentering Repeat Message State is no network start */
+	CanNm_FastForward(20);
+	CanNm_FastForward(1000);
+	CanNm_RepeatMessageRequest(nmChannelHandle);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 5);
+}
+
+/**
+ * @brief State save and restore test
+ * 
+ * Function testing CanNm_SaveState and CanNm_RestoreState
+*/
+void Test_Of_CanNm_SaveRestoreState(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	CanNm_Internal_ChannelType savedChannel;
+	uint8 state[256];
+	uint8 restored[256];
+	uint32 stateLength = 0;
+	uint32 restoredLength = sizeof(restored);
+	uint8 userData[6] = { 11, 12, 13, 14, 15, 16 };
+	uint8 txPdu[CANNM_SDU_LENGTH];
+	uint32 transmitCount;
+
+	/* Repeat Message State with running timers, user data and a received PDU */
+	canNmConfig.UserDataEnabled = 1;
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_SetUserData(nmChannelHandle, userData);
+	CanNm_FastForward(7);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_SaveState(NULL, &stateLength) == E_NOT_OK);
+	TEST_CHECK(stateLength > 0 && stateLength <= sizeof(state));
+	stateLength -= 1;
+	TEST_CHECK(CanNm_SaveState(state, &stateLength) == E_NOT_OK);
+	TEST_CHECK(CanNm_SaveState(state, &stateLength) == E_OK);
+	savedChannel = *ChannelInternal;
+	memcpy(txPdu, CanNm_Internal.Pdus[nmChannelHandle].Tx, sizeof(txPdu));
+	transmitCount = CanIf_Transmit_fake.call_count;
+	CanNm_DeInit();
+
+	/* A fresh module takes over the state, saving again gives the same blob */
+	CanNm_Init(&canNmConfig);
+	memset(CanNm_Internal.Pdus[nmChannelHandle].Tx, 0, sizeof(txPdu));
+	TEST_CHECK(CanNm_RestoreState(state, stateLength) == E_OK);
+	TEST_CHECK(CanNm_SaveState(restored, &restoredLength) == E_OK);
+	TEST_CHECK(restoredLength == stateLength);
+	TEST_CHECK(memcmp(state, restored, stateLength) == 0);
+	TEST_CHECK(CanNm_GetMainFunctionTicks() == 7);
+	TEST_CHECK(CanNm_Internal.Statistics[nmChannelHandle].StateEnteredTick == 7);
+	TEST_CHECK(CanNm_Internal.Latency[nmChannelHandle].Pending == 0);
+	TEST_CHECK(CanNm_Internal.TxSupervision.Count == 0 || CanNm_Internal.TxSupervision.Positions[nmChannelHandle] == 0);
+	TEST_CHECK(ChannelInternal->State == NM_STATE_REPEAT_MESSAGE);
+	TEST_CHECK(ChannelInternal->Mode == NM_MODE_NETWORK);
+	TEST_CHECK(ChannelInternal->Requested == savedChannel.Requested);
+	TEST_CHECK(ChannelInternal->RxLastPdu == savedChannel.RxLastPdu);
+	TEST_CHECK(ChannelInternal->TimersStarted == savedChannel.TimersStarted);
+	TEST_CHECK(memcmp(ChannelInternal->Deadlines, savedChannel.Deadlines, sizeof(savedChannel.Deadlines)) == 0);
+	TEST_CHECK(memcmp(CanNm_Internal.Pdus[nmChannelHandle].Tx, txPdu, sizeof(txPdu)) == 0);
+	TEST_CHECK(memcmp(&CanNm_Internal.Pdus[nmChannelHandle].Tx[2], userData, sizeof(userData)) == 0);
+
+	/* The message cycle goes on where it stopped */
+	CanNm_FastForward(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE));
+	TEST_CHECK(CanIf_Transmit_fake.call_count == transmitCount + 1);
+	TEST_CHECK(CanNm_GetMainFunctionTicks() == 505);
+
+	/* Corrupted, truncated or foreign blobs are rejected without changes */
+	restored[20] ^= 0x01;
+	TEST_CHECK(CanNm_RestoreState(restored, stateLength) == E_NOT_OK);
+	TEST_CHECK(CanNm_GetMainFunctionTicks() == 505);
+	TEST_CHECK(CanNm_RestoreState(state, stateLength - 1) == E_NOT_OK);
+	state[6] = 2;
+	TEST_CHECK(CanNm_RestoreState(state, stateLength) == E_NOT_OK);
+	CanNm_DeInit();
+	TEST_CHECK(CanNm_RestoreState(restored, stateLength) == E_NOT_OK);
+}
+
+/**
+ * @brief Lazy initialization test
+ * 
+ * Function testing channels set up on their first use instead of in CanNm_Init
+*/
+void Test_Of_CanNm_LazyInit(void)
+{
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	Nm_StateType state;
+	Nm_ModeType mode;
+
+	canNmConfig.LazyInitEnabled = TRUE;
+	canNmChannel[0].NodeId = 0x17;
+
+	/* CanNm_Init leaves the channel and its Tx PDU untouched, the main function has nothing to do */
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(ChannelInternal->State == NM_STATE_UNINIT);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0);
+	CanNm_FastForward(10);
+	TEST_CHECK(ChannelInternal->TimersStarted == 0);
+	TEST_CHECK(CanNm_Internal.SleepReady.ReadyToSleep[0] & 1);
+
+	/* An uninitialized channel does not keep CanNm_DeInit from completing */
+	CanNm_DeInit();
+	TEST_CHECK(CanNm_Internal.InitStatus == CANNM_UNINIT);
+
+	/* The first API call sets the channel up */
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_GetState(nmChannelHandle, &state, &mode) == E_OK);
+	TEST_CHECK(state == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(mode == NM_MODE_BUS_SLEEP);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x17);												//[SWS_CanNm_00013]
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_1] == 0x00);												//[SWS_CanNm_00085]
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_SDU_LENGTH - 1] == 0xFF);											//[SWS_CanNm_00025]
+	CanNm_DeInit();
+
+	/* So does a received NM PDU, the channel works as usual afterwards */
+	CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] = 1;
+	CanNm_Init(&canNmConfig);
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(ChannelInternal->State == NM_STATE_BUS_SLEEP);
+	TEST_CHECK(ChannelInternal->RxLastPdu == 0);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x17);
+	CanNm_NetworkRequest(nmChannelHandle);
+	TEST_CHECK(ChannelInternal->State == NM_STATE_REPEAT_MESSAGE);
+}
+
+/**
+ * @brief Read-only configuration test
+ * 
+ * Function testing that the PDU buffers referenced by the configuration are never written
+*/
+void Test_Of_CanNm_ReadOnlyConfig(void)
+{
+	static const uint8 configSdu[CANNM_SDU_LENGTH] = {1, 2, 3, 4, 5, 6, 7, 8};
+	uint8 userData[CANNM_SDU_LENGTH - 2] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+	uint8 pduData[CANNM_SDU_LENGTH];
+
+	canNmConfig.UserDataEnabled = TRUE;
+	canNmChannel[0].NodeId = 0x17;
+	CanNm_Init(&canNmConfig);
+	CanNm_SetUserData(nmChannelHandle, userData);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(10);
+	memset(SduDataPtr, 0x55, sizeof(SduDataPtr));
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	CanNm_TxConfirmation(TxPduId, E_OK);
+	TEST_CHECK(CanNm_GetPduData(nmChannelHandle, pduData) == E_OK);
+	TEST_CHECK(pduData[CANNM_SDU_LENGTH - 1] == 0x55);
+	CanNm_DeInit();
+	CanNm_Init(&canNmConfig);
+
+	/* The configuration stays as generated, CanNm keeps the PDUs in its own RAM */
+	TEST_CHECK(memcmp(TestTxMessageSdu, configSdu, sizeof(configSdu)) == 0);
+	TEST_CHECK(memcmp(TestRxMessageSdu, configSdu, sizeof(configSdu)) == 0);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x17);
+
+	/* A received PDU shorter than configured is copied only as far as it goes */
+	memset(SduDataPtr, 0x66, sizeof(SduDataPtr));
+	PduInfoPtr.SduLength = 2;
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_GetPduData(nmChannelHandle, pduData) == E_OK);
+	TEST_CHECK(pduData[1] == 0x66 && pduData[2] != 0x66);
+
+	/* Nor is the CBV read past the end of a short frame */
+	memset(SduDataPtr, 0xFF, sizeof(SduDataPtr));
+	PduInfoPtr.SduLength = CANNM_PDU_BYTE_1;
+	CanNm_Internal.Channels[nmChannelHandle].Mode = NM_MODE_NETWORK;
+	CanNm_Internal.Channels[nmChannelHandle].State = NM_STATE_READY_SLEEP;
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_Internal.Channels[nmChannelHandle].State == NM_STATE_READY_SLEEP);
+	PduInfoPtr.SduLength = CANNM_SDU_LENGTH;
+	CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	TEST_CHECK(CanNm_Internal.Channels[nmChannelHandle].State == NM_STATE_REPEAT_MESSAGE);
+	CanNm_Internal.Channels[nmChannelHandle].Mode = NM_MODE_BUS_SLEEP;
+	CanNm_Internal.Channels[nmChannelHandle].State = NM_STATE_BUS_SLEEP;
+	CanNm_DeInit();
+
+	/* PDUs longer than the buffers in CanNm RAM are refused by CanNm_Init */
+	canNmRxPduInfo.SduLength = CANNM_PDU_MAX_LENGTH + 1;
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_Internal.InitStatus == CANNM_UNINIT);
+}
+
+/**
+ * @brief Configuration image test
+ * 
+ * Function testing the binary configuration image checked and bound by CanNm_LoadConfigImage
+*/
+void Test_Of_CanNm_LoadConfigImage(void)
+{
+	static union {
+		uint32 Align;
+		uint8 Bytes[256];
+	} image;
+	CanNm_ImageHeaderType* header = (CanNm_ImageHeaderType*)image.Bytes;
+	CanNm_ImageChannelType* channel = (CanNm_ImageChannelType*)&image.Bytes[sizeof(CanNm_ImageHeaderType)];
+	uint32 rxPduIdsOffset = sizeof(CanNm_ImageHeaderType) + sizeof(CanNm_ImageChannelType);
+	uint32 length = rxPduIdsOffset + 4;
+	const CanNm_ConfigType* config = NULL;
+	const CanNm_ChannelType* channelConf;
+
+	*header = (CanNm_ImageHeaderType){
+		.Magic = CANNM_IMAGE_MAGIC,
+		.Version = CANNM_IMAGE_VERSION,
+		.ByteOrder = CANNM_IMAGE_BYTE_ORDER,
+		.Length = length,
+		.HeaderSize = sizeof(CanNm_ImageHeaderType),
+		.ChannelSize = sizeof(CanNm_ImageChannelType),
+		.HandleSize = sizeof(NetworkHandleType),
+		.Channels = { sizeof(CanNm_ImageHeaderType), 1 },
+		.RxPduIds = { rxPduIdsOffset, 1 },
+		.MainFunctionPeriod = 1.0f,
+		.UserDataEnabled = TRUE
+	};
+	*channel = (CanNm_ImageChannelType){
+		.MsgCycleOffset = 5, .MsgCycleTime = 500, .TimeoutTime = 100, .RepeatMessageTime = 1000,
+		.WaitBusSleepTime = 1000, .RemoteSleepIndTime = 2000, .RxPduIndex = 0, .RxPduCount = 1,
+		.PduLength = CANNM_SDU_LENGTH, .PduCbvPosition = CANNM_PDU_BYTE_1, .PduNidPosition = CANNM_PDU_BYTE_0,
+		.NodeId = 0x17, .NodeIdEnabled = TRUE, .ControllerIndex = CANNM_CONTROLLER_NONE
+	};
+	*(PduIdType*)&image.Bytes[rxPduIdsOffset] = 3;
+
+	/* The image is bound without being changed, the channel is usable as usual */
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_OK);
+	channelConf = config->ChannelConfig[nmChannelHandle];
+	TEST_CHECK(config->MainFunctionPeriod == 1.0f && config->UserDataEnabled && config->RxPduChannelMap == NULL);
+	TEST_CHECK(channelConf->MsgCycleTime == 500 && channelConf->NodeId == 0x17);
+	TEST_CHECK(channelConf->TxPdu->TxPduRef->SduLength == CANNM_SDU_LENGTH);
+	TEST_CHECK(channelConf->RxPdu[0]->RxPduId == 3 && channelConf->RxPdu[CANNM_RXPDU_MAX_COUNT - 1]->RxPduId == 3);
+	CanNm_Init(config);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(5);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x17);
+	TEST_CHECK(header->Magic == CANNM_IMAGE_MAGIC && channel->NodeId == 0x17);
+
+	/* Not while the module runs on it */
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	CanNm_Internal.InitStatus = CANNM_UNINIT;
+
+	/* Images not matching the build or pointing outside themselves are rejected */
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length - 1, &config) == E_NOT_OK);
+	TEST_CHECK(CanNm_LoadConfigImage(&image.Bytes[1], length, &config) == E_NOT_OK);
+	header->RxPduIds.Offset = length;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	header->RxPduIds.Offset = rxPduIdsOffset;
+	header->Channels.Count = 2;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	header->Channels.Count = 1;
+	channel->RxPduCount = 2;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	channel->RxPduCount = 1;
+	channel->PduLength = CANNM_PDU_MAX_LENGTH + 1;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	channel->PduLength = CANNM_SDU_LENGTH;
+	channel->MsgCycleTime = NAN;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	channel->MsgCycleTime = 500;
+	header->ByteOrder = 0x0201;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_NOT_OK);
+	header->ByteOrder = CANNM_IMAGE_BYTE_ORDER;
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, NULL) == E_NOT_OK);
+	TEST_CHECK(CanNm_LoadConfigImage(image.Bytes, length, &config) == E_OK);
+}
+
+/**
+ * @brief Bus load estimator test
+ * 
+ * Function testing the expected and the observed NM bus load
+*/
+void Test_Of_CanNm_BusLoad(void)
+{
+	CanNm_BusLoadEstimateType estimate;
+	CanNm_BusLoadType observed;
+
+	/* 8 byte classic CAN frames take 135 bits, MsgCycleTime is 500 ticks of 1 ms */
+	TEST_CHECK(CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 0, &estimate) == E_NOT_OK);
+	TEST_CHECK(CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 10, &estimate) == E_OK);
+	TEST_CHECK(estimate.Startup.FramesPerSecond == 20.0f);
+	TEST_CHECK(estimate.Steady.FramesPerSecond == 20.0f);
+	TEST_CHECK(estimate.Steady.BitsPerSecond == 20.0f * 135);
+
+	canNmChannel[0].ImmediateNmTransmissions = 3;
+	canNmChannel[0].ImmediateNmCycleTime = 20;
+	CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 10, &estimate);
+	TEST_CHECK(estimate.Startup.FramesPerSecond == 500.0f);
+
+	/* Derived reduced cycles start at 251 ticks, 249 slots */
+	canNmChannel[0].BusLoadReductionActive = TRUE;
+	CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 10, &estimate);
+	TEST_CHECK(fabsf(estimate.Steady.FramesPerSecond - (1000.0f / 251)) < 0.001f);
+	CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 300, &estimate);
+	TEST_CHECK(fabsf(estimate.Steady.FramesPerSecond - (2000.0f / 251)) < 0.001f);
+	CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 1, &estimate);
+	TEST_CHECK(estimate.Steady.FramesPerSecond == 2.0f);
+	canNmChannel[0].MsgReducedTime = 250;
+	CanNm_EstimateBusLoad(&canNmConfig, nmChannelHandle, 300, &estimate);
+	TEST_CHECK(estimate.Steady.FramesPerSecond == 4.0f);
+
+	/* Observed over the time since initialization */
+	CanNm_Init(&canNmConfig);
+	for (uint8 frame = 0; frame < 4; frame++) {
+		CanNm_RxIndication(RxPduId, &PduInfoPtr);
+	}
+	CanNm_FastForward(1000);
+	TEST_CHECK(CanNm_GetObservedBusLoad(nmChannelHandle, &observed) == E_OK);
+	TEST_CHECK(observed.FramesPerSecond == 4.0f);
+	TEST_CHECK(observed.BitsPerSecond == 4.0f * 135);
+}
+
+/**
+ * @brief Reconfiguration test
+ * 
+ * Function testing a configuration set published by CanNm_Reconfigure and taken over by sleeping and active channels
+*/
+void Test_Of_CanNm_Reconfigure(void)
+{
+	static CanNm_ChannelType tunedChannel;
+	static CanNm_ConfigType tunedConfig;
+	CanNm_Internal_ChannelType* ChannelInternal = &CanNm_Internal.Channels[nmChannelHandle];
+	uint32 ticks;
+
+	canNmChannel[0].MsgTimeoutTime = 20;
+	canNmChannel[0].NodeId = 0x17;
+	tunedChannel = canNmChannel[0];
+	tunedChannel.MsgCycleTime = 200;
+	tunedChannel.NodeId = 0x21;
+	tunedConfig = canNmConfig;
+	tunedConfig.ChannelConfig[0] = &tunedChannel;
+	TEST_CHECK(CanNm_Reconfigure(&tunedConfig) == E_NOT_OK);
+
+	/* A channel in Bus-Sleep Mode takes the new set over at once */
+	CanNm_Init(&canNmConfig);
+	TEST_CHECK(CanNm_Reconfigure(&tunedConfig) == E_OK);
+	TEST_CHECK(CanNm_ConfigPtr == &tunedConfig);
+	TEST_CHECK(!CanNm_ReconfigurePending());
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x21);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(5);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 1);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 200);
+	CanNm_DeInit();
+
+	/* An active channel keeps its set while an NM PDU waits for confirmation */
+	CanNm_Init(&canNmConfig);
+	CanNm_NetworkRequest(nmChannelHandle);
+	CanNm_FastForward(5);
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 2);
+	ticks = CanNm_GetMainFunctionTicks();
+	TEST_CHECK(CanNm_Reconfigure(&tunedConfig) == E_OK);
+	TEST_CHECK(CanNm_ReconfigurePending());
+	TEST_CHECK(CanNm_Internal_GetChannelConf(nmChannelHandle) == &canNmChannel[0]);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x17);
+	CanNm_MainFunction();
+	TEST_CHECK(CanNm_ReconfigurePending());
+	CanNm_TxConfirmation(nmChannelHandle, E_OK);
+	CanNm_MainFunction();
+	TEST_CHECK(!CanNm_ReconfigurePending());
+	TEST_CHECK(CanNm_Internal_GetChannelConf(nmChannelHandle) == &tunedChannel);
+	TEST_CHECK(CanNm_Internal.Pdus[nmChannelHandle].Tx[CANNM_PDU_BYTE_0] == 0x21);
+
+	/* The running Message Cycle Timer expires as started, its restart uses the new cycle */
+	CanNm_FastForward(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE));
+	TEST_CHECK(CanIf_Transmit_fake.call_count == 3);
+	TEST_CHECK(CanNm_GetMainFunctionTicks() == ticks + 500);
+	TEST_CHECK(CanNm_Internal_TimerTicksLeft(ChannelInternal, CANNM_TIMER_MESSAGE_CYCLE) == 200);
+
+	/* Sets differing in more than parameters are rejected without changes */
+	canNmChannel[0].PduNidPosition = CANNM_PDU_OFF;
+	TEST_CHECK(CanNm_Reconfigure(&canNmConfig) == E_NOT_OK);
+	canNmChannel[0].PduNidPosition = CANNM_PDU_BYTE_0;
+	canNmConfig.MainFunctionPeriod = 10.0;
+	TEST_CHECK(CanNm_Reconfigure(&canNmConfig) == E_NOT_OK);
+	TEST_CHECK(CanNm_Reconfigure(NULL) == E_NOT_OK);
+	TEST_CHECK(CanNm_ConfigPtr == &tunedConfig && !CanNm_ReconfigurePending());
+}
+
 /*
   Test list - write down here all functions which should be executed as tests.
 */
@@ -719,6 +1842,26 @@ TEST_LIST = {
   { "Test_Of_CanNm_ConfirmPnAvailability", Test_Of_CanNm_ConfirmPnAvailability },
   { "Test_Of_CanNm_TriggerTransmit", Test_Of_CanNm_TriggerTransmit },
   { "Test_Of_State_Machine", Test_Of_State_Machine },
+  { "Test_Of_SchM_CanNm_ExclusiveAreas", Test_Of_SchM_CanNm_ExclusiveAreas },
+  { "Test_Of_CanNm_TraceRead", Test_Of_CanNm_TraceRead },
+  { "Test_Of_CanNm_GetStatistics", Test_Of_CanNm_GetStatistics },
+  { "Test_Of_CanNm_GetLatencyHistogram", Test_Of_CanNm_GetLatencyHistogram },
+  { "Test_Of_CanNm_FastForward", Test_Of_CanNm_FastForward },
+  { "Test_Of_CanNm_RxPduChannelMap", Test_Of_CanNm_RxPduChannelMap },
+  { "Test_Of_CanNm_DeferredNotifications", Test_Of_CanNm_DeferredNotifications },
+  { "Test_Of_CanNm_Callbacks", Test_Of_CanNm_Callbacks },
+  { "Test_Of_CanNm_BusLoadReduction", Test_Of_CanNm_BusLoadReduction },
+  { "Test_Of_CanNm_BusLoad", Test_Of_CanNm_BusLoad },
+  { "Test_Of_CanNm_TxRetry", Test_Of_CanNm_TxRetry },
+  { "Test_Of_CanNm_TxSupervision", Test_Of_CanNm_TxSupervision },
+  { "Test_Of_CanNm_CoordinatorSleepReady", Test_Of_CanNm_CoordinatorSleepReady },
+  { "Test_Of_CanNm_TxRateLimit", Test_Of_CanNm_TxRateLimit },
+  { "Test_Of_CanNm_WakeUpStagger", Test_Of_CanNm_WakeUpStagger },
+  { "Test_Of_CanNm_SaveRestoreState", Test_Of_CanNm_SaveRestoreState },
+  { "Test_Of_CanNm_LazyInit", Test_Of_CanNm_LazyInit },
+  { "Test_Of_CanNm_ReadOnlyConfig", Test_Of_CanNm_ReadOnlyConfig },
+  { "Test_Of_CanNm_LoadConfigImage", Test_Of_CanNm_LoadConfigImage },
+  { "Test_Of_CanNm_Reconfigure", Test_Of_CanNm_Reconfigure },
   { NULL, NULL }	// Must be at the end
 };
 
@@ -0,0 +1,192 @@
+/** ==================================================================================================================*\
+  @file CanNm_BusLoad.c
+
+  @brief Offline NM bus load estimator for the Can Network Management Module
+
+  Prints the NM frame and bit rate CanNm_EstimateBusLoad expects for every channel of the generated configuration set
+  (CanNm_Cfg.h/.c written by CanNm_Generate) and a list of node counts, at the startup burst and in steady state,
+  together with the share of the bus bit rate. One JSON object per line. With --image the configuration set is taken
+  from a mapped CanNm_Cfg.bin instead.
+
+  Build: CanNm_Generate network.json cfg
+         gcc -O2 -Icfg -I../Src CanNm_BusLoad.c cfg/CanNm_Cfg.c ../Src/CanNm.c ../Src/SchM_CanNm.c -o CanNm_BusLoad
+         (add -DCANNM_CONFIG_IMAGE_ENABLED=STD_ON for the --image option)
+  Usage: CanNm_BusLoad [--nodes N[,N...]] [--bitrate BITS_PER_SECOND] [--image CanNm_Cfg.bin]
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+#include "CanNm.h"
+
+#ifndef CANNM_CONFIG_SET
+#error "CanNm_BusLoad needs the generated CanNm_Cfg.h on the include path"
+#endif
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#define BUSLOAD_MAX_NODE_COUNTS		32
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+static uint16 BusLoad_NodeCounts[BUSLOAD_MAX_NODE_COUNTS] = { 2, 5, 10, 20, 40, 64 };
+static uint32 BusLoad_NodeCountCount = 6;
+
+/*====================================================================================================================*\
+    Global functions code (CanNm lower and upper layer, never called without CanNm_Init)
+\*====================================================================================================================*/
+Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
+{
+	(void)TxPduId;
+	(void)PduInfoPtr;
+	return E_OK;
+}
+
+void Nm_StateChangeNotification(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState, Nm_StateType nmCurrentState)
+{
+	(void)nmNetworkHandle;
+	(void)nmPreviousState;
+	(void)nmCurrentState;
+}
+
+void Nm_NetworkStartIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_NetworkMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_BusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PrepareBusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepInd(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepCancellation(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PduRxIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_TxTimeoutException(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void CanSM_TxTimeoutException(NetworkHandleType Channel) { (void)Channel; }
+void PduR_CanNmRxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr) { (void)RxPduId; (void)PduInfoPtr; }
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+static boolean BusLoad_ParseNodeCounts( const char* text )
+{
+	char* end;
+
+	BusLoad_NodeCountCount = 0;
+	do {
+		unsigned long nodes = strtoul(text, &end, 0);
+		if (end == text || nodes == 0 || nodes > 65535 || BusLoad_NodeCountCount == BUSLOAD_MAX_NODE_COUNTS) {
+			return FALSE;
+		}
+		BusLoad_NodeCounts[BusLoad_NodeCountCount++] = (uint16)nodes;
+		text = end + 1;
+	} while (*end == ',');
+	return *end == '\0';
+}
+
+static void BusLoad_Usage( const char* program )
+{
+	fprintf(stderr, "usage: %s [options]\n"
+	 "  -n, --nodes N[,N...]             node counts to estimate (default 2,5,10,20,40,64)\n"
+	 "  -b, --bitrate BITS_PER_SECOND    nominal bus bit rate for the load share (default 500000)\n"
+	 "  -i, --image FILE                 configuration image written by CanNm_Generate (needs CANNM_CONFIG_IMAGE_ENABLED)\n",
+	 program);
+}
+
+/* Read-only shared mapping of a configuration image, checked in place */
+static const CanNm_ConfigType* BusLoad_MapImage( const char* path )
+{
+#if (CANNM_CONFIG_IMAGE_ENABLED == STD_ON)
+	const CanNm_ConfigType* config = NULL;
+	struct stat status;
+	const uint8* image;
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0 || fstat(fd, &status) != 0 || status.st_size == 0) {
+		perror(path);
+		return NULL;
+	}
+	image = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (image == MAP_FAILED) {
+		perror(path);
+		return NULL;
+	}
+	if (CanNm_LoadConfigImage(image, (uint32)status.st_size, &config) != E_OK) {
+		fprintf(stderr, "%s: not a configuration image of this build\n", path);
+		return NULL;
+	}
+	return config;
+#else
+	fprintf(stderr, "%s: built without CANNM_CONFIG_IMAGE_ENABLED\n", path);
+	return NULL;
+#endif
+}
+
+/*====================================================================================================================*\
+    Main
+\*====================================================================================================================*/
+int main(int argc, char** argv)
+{
+	static const struct option longOptions[] = {
+		{ "nodes", required_argument, NULL, 'n' },
+		{ "bitrate", required_argument, NULL, 'b' },
+		{ "image", required_argument, NULL, 'i' },
+		{ NULL, 0, NULL, 0 }
+	};
+	const CanNm_ConfigType* config = &CANNM_CONFIG_SET;
+	float32 bitRate = 500000.0f;
+	int option;
+
+	while ((option = getopt_long(argc, argv, "n:b:i:", longOptions, NULL)) != -1) {
+		switch (option) {
+		case 'n':
+			if (!BusLoad_ParseNodeCounts(optarg)) {
+				fprintf(stderr, "invalid node counts '%s'\n", optarg);
+				return 1;
+			}
+			break;
+		case 'b': bitRate = strtof(optarg, NULL); break;
+		case 'i':
+			config = BusLoad_MapImage(optarg);
+			if (config == NULL) {
+				return 1;
+			}
+			break;
+		default:
+			BusLoad_Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (optind != argc || bitRate <= 0) {
+		BusLoad_Usage(argv[0]);
+		return 1;
+	}
+
+	for (NetworkHandleType channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		for (uint32 count = 0; count < BusLoad_NodeCountCount; count++) {
+			CanNm_BusLoadEstimateType estimate;
+
+			if (CanNm_EstimateBusLoad(config, channel, BusLoad_NodeCounts[count], &estimate) != E_OK) {
+				fprintf(stderr, "channel %u: incomplete configuration\n", (unsigned)channel);
+				return 1;
+			}
+			printf("{\"channel\":%u,\"nodes\":%u,\"startup_frames_per_s\":%.2f,\"startup_bits_per_s\":%.0f,"
+			 "\"startup_load_percent\":%.2f,\"steady_frames_per_s\":%.2f,\"steady_bits_per_s\":%.0f,"
+			 "\"steady_load_percent\":%.2f}\n", (unsigned)channel, (unsigned)BusLoad_NodeCounts[count],
+			 estimate.Startup.FramesPerSecond, estimate.Startup.BitsPerSecond,
+			 estimate.Startup.BitsPerSecond * 100.0f / bitRate, estimate.Steady.FramesPerSecond,
+			 estimate.Steady.BitsPerSecond, estimate.Steady.BitsPerSecond * 100.0f / bitRate);
+		}
+	}
+	return 0;
+}
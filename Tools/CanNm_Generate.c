@@ -0,0 +1,1062 @@
+/** ==================================================================================================================*\
+  @file CanNm_Generate.c
+
+  @brief Configuration generator for the Can Network Management Module
+
+  Reads a JSON network description, whose keys follow the CanNm ECUC container and parameter names (see
+  CanNm_Example.json), checks it and emits:
+  - CanNm_Cfg.h: channel count, Rx PDU ring size, configuration variant, one STD_ON/STD_OFF switch per optional
+    feature, symbolic channel and PDU handles. Features switched off are removed from CanNm.c at compile time, in the
+    pre-compile variant the features switched on are constants as well.
+  - CanNm_Cfg.c: the constant configuration set (CanNm_Config) and the RxPduId to channel map.
+  - CanNm_Cfg.bin: the same configuration set as a position-independent image for CanNm_LoadConfigImage, in the
+    byte order and structure layout of the host running the generator.
+
+  Build: gcc -O2 -I../Src CanNm_Generate.c -o CanNm_Generate
+  Usage: CanNm_Generate <description.json> <output directory>
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <ctype.h>
+
+#include "Std_Types.h"
+#include "CanNm.h"
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#define GENERATE_MAX_NAME_LENGTH	64
+#define GENERATE_MAX_PDU_LENGTH		64
+#define GENERATE_MAX_CHANNELS		65535
+#define GENERATE_PDU_OFF			0xFF
+#define GENERATE_MAX_COORD_CLUSTERS	32
+#define GENERATE_IMAGE_ALIGN(offset)	((uint32)(((offset) + CANNM_IMAGE_ALIGNMENT - 1) & ~(CANNM_IMAGE_ALIGNMENT - 1)))
+
+/*====================================================================================================================*\
+    Local types
+\*====================================================================================================================*/
+typedef enum {
+	JSON_NULL,
+	JSON_BOOLEAN,
+	JSON_NUMBER,
+	JSON_STRING,
+	JSON_ARRAY,
+	JSON_OBJECT
+} Json_KindType;
+
+typedef struct Json_ValueTag {
+	Json_KindType			Kind;
+	char*					Key;			/* Member name inside an object */
+	char*					String;
+	float64					Number;
+	boolean					Boolean;
+	struct Json_ValueTag*	Child;			/* First element or member */
+	struct Json_ValueTag*	Next;
+	uint32					Line;
+} Json_ValueType;
+
+typedef struct {
+	const char*	Text;
+	const char*	Position;
+	uint32		Line;
+} Json_ParserType;
+
+typedef enum {
+	PARAMETER_BOOLEAN,
+	PARAMETER_TIME,			/* float32, same unit as MainFunctionPeriod */
+	PARAMETER_UINT8,
+	PARAMETER_POSITION,		/* CanNm_PduBytePositionType, 0, 1 or "OFF" */
+	PARAMETER_HANDLE,		/* NetworkHandleType */
+	PARAMETER_RETRY_POLICY	/* CanNm_TxRetryPolicyType, "NextMainFunction", "Fixed" or "Exponential" */
+} Generate_ParameterKindType;
+
+typedef struct {
+	const char*					Name;
+	Generate_ParameterKindType	Kind;
+	size_t						ImageOffset;	/* Member of CanNm_ImageChannelType */
+} Generate_ParameterType;
+
+typedef struct {
+	const char*	Name;		/* CanNm_ConfigType member and JSON key */
+	const char*	Switch;		/* CanNm_Cfg.h define, NULL for flags without code switch */
+	size_t		ImageOffset;	/* Member of CanNm_ImageHeaderType */
+} Generate_FeatureType;
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+/* Members of CanNm_ChannelType set from the channel description */
+static const Generate_ParameterType Generate_ChannelParameters[] = {
+	{ "ActiveWakeupBitEnabled",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, ActiveWakeupBitEnabled) },
+	{ "AllNmMessagesKeepAwake",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, AllNmMessagesKeepAwake) },
+	{ "BusLoadReductionActive",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, BusLoadReductionActive) },
+	{ "CarWakeUpBitPosition",				PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, CarWakeUpBitPosition) },
+	{ "CarWakeUpFilterEnabled",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, CarWakeUpFilterEnabled) },
+	{ "CarWakeUpFilterNodeId",				PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, CarWakeUpFilterNodeId) },
+	{ "CarWakeUpRxEnabled",					PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, CarWakeUpRxEnabled) },
+	{ "ControllerIndex",					PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, ControllerIndex) },
+	{ "CoordClusterIndex",					PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, CoordClusterIndex) },
+	{ "ImmediateNmCycleTime",				PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, ImmediateNmCycleTime) },
+	{ "ImmediateNmTransmissions",			PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, ImmediateNmTransmissions) },
+	{ "MsgCycleOffset",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, MsgCycleOffset) },
+	{ "MsgCycleTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, MsgCycleTime) },
+	{ "MsgReducedTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, MsgReducedTime) },
+	{ "MsgTimeoutTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, MsgTimeoutTime) },
+	{ "NodeDetectionEnabled",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, NodeDetectionEnabled) },
+	{ "NodeId",								PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, NodeId) },
+	{ "NodeIdEnabled",						PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, NodeIdEnabled) },
+	{ "PduCbvPosition",						PARAMETER_POSITION,		offsetof(CanNm_ImageChannelType, PduCbvPosition) },
+	{ "PduNidPosition",						PARAMETER_POSITION,		offsetof(CanNm_ImageChannelType, PduNidPosition) },
+	{ "PnEnabled",							PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, PnEnabled) },
+	{ "PnEraCalcEnabled",					PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, PnEraCalcEnabled) },
+	{ "PnHandleMultipleNetworkRequests",	PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, PnHandleMultipleNetworkRequests) },
+	{ "RemoteSleepIndTime",					PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, RemoteSleepIndTime) },
+	{ "RepeatMessageTime",					PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, RepeatMessageTime) },
+	{ "RepeatMsgIndEnabled",				PARAMETER_BOOLEAN,		offsetof(CanNm_ImageChannelType, RepeatMsgIndEnabled) },
+	{ "TimeoutTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, TimeoutTime) },
+	{ "TxRetryLimit",						PARAMETER_UINT8,		offsetof(CanNm_ImageChannelType, TxRetryLimit) },
+	{ "TxRetryMaxTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, TxRetryMaxTime) },
+	{ "TxRetryPolicy",						PARAMETER_RETRY_POLICY,	offsetof(CanNm_ImageChannelType, TxRetryPolicy) },
+	{ "TxRetryTime",						PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, TxRetryTime) },
+	{ "WaitBusSleepTime",					PARAMETER_TIME,			offsetof(CanNm_ImageChannelType, WaitBusSleepTime) },
+	{ "ComMNetworkHandleRef",				PARAMETER_HANDLE,		offsetof(CanNm_ImageChannelType, ComMNetworkHandleRef) }
+};
+
+/* Boolean members of CanNm_ConfigType, taken from the "Features" object */
+static const Generate_FeatureType Generate_Features[] = {
+	{ "BusLoadReductionEnabled",	"CANNM_BUS_LOAD_REDUCTION_ENABLED",	offsetof(CanNm_ImageHeaderType, BusLoadReductionEnabled) },
+	{ "BusSynchronizationEnabled",	NULL,								offsetof(CanNm_ImageHeaderType, BusSynchronizationEnabled) },
+	{ "ComControlEnabled",			NULL,								offsetof(CanNm_ImageHeaderType, ComControlEnabled) },
+	{ "ComUserDataSupport",			"CANNM_COM_USER_DATA_SUPPORT",		offsetof(CanNm_ImageHeaderType, ComUserDataSupport) },
+	{ "CoordinationSyncSupport",	"CANNM_COORDINATOR_SYNC_SUPPORT",	offsetof(CanNm_ImageHeaderType, CoordinationSyncSupport) },
+	{ "DeferredNotificationsEnabled", "CANNM_DEFERRED_NOTIFICATIONS_ENABLED",	offsetof(CanNm_ImageHeaderType, DeferredNotificationsEnabled) },
+	{ "DevErrorDetect",				NULL,								offsetof(CanNm_ImageHeaderType, DevErrorDetect) },
+	{ "GlobalPnSupport",			"CANNM_GLOBAL_PN_SUPPORT",			offsetof(CanNm_ImageHeaderType, GlobalPnSupport) },
+	{ "ImmediateRestartEnabled",	"CANNM_IMMEDIATE_RESTART_ENABLED",	offsetof(CanNm_ImageHeaderType, ImmediateRestartEnabled) },
+	{ "ImmediateTxConfEnabled",		NULL,								offsetof(CanNm_ImageHeaderType, ImmediateTxConfEnabled) },
+	{ "LazyInitEnabled",			"CANNM_LAZY_INIT_ENABLED",			offsetof(CanNm_ImageHeaderType, LazyInitEnabled) },
+	{ "PassiveModeEnabled",			"CANNM_PASSIVE_MODE_ENABLED",		offsetof(CanNm_ImageHeaderType, PassiveModeEnabled) },
+	{ "PduRxIndicationEnabled",		"CANNM_PDU_RX_INDICATION_ENABLED",	offsetof(CanNm_ImageHeaderType, PduRxIndicationEnabled) },
+	{ "PnEiraCalcEnabled",			NULL,								offsetof(CanNm_ImageHeaderType, PnEiraCalcEnabled) },
+	{ "RemoteSleepIndEnabled",		"CANNM_REMOTE_SLEEP_IND_ENABLED",	offsetof(CanNm_ImageHeaderType, RemoteSleepIndEnabled) },
+	{ "StateChangeIndEnabled",		"CANNM_STATE_CHANGE_IND_ENABLED",	offsetof(CanNm_ImageHeaderType, StateChangeIndEnabled) },
+	{ "UserDataEnabled",			"CANNM_USER_DATA_ENABLED",			offsetof(CanNm_ImageHeaderType, UserDataEnabled) },
+	{ "VersionInfoApi",				NULL,								offsetof(CanNm_ImageHeaderType, VersionInfoApi) }
+};
+
+/* JSON names of CanNm_TxRetryPolicyType, indexed by value */
+static const char* const Generate_RetryPolicyNames[] = { "NextMainFunction", "Fixed", "Exponential" };
+static const char* const Generate_RetryPolicyValues[] = {
+	"CANNM_TX_RETRY_NEXT_MAIN_FUNCTION", "CANNM_TX_RETRY_FIXED", "CANNM_TX_RETRY_EXPONENTIAL"
+};
+
+/* JSON names of CanNm_WakeUpStaggerType, indexed by value */
+static const char* const Generate_WakeUpStaggerNames[] = { "ChannelIndex", "Hash" };
+static const char* const Generate_WakeUpStaggerValues[] = { "CANNM_WAKEUP_STAGGER_CHANNEL_INDEX", "CANNM_WAKEUP_STAGGER_HASH" };
+
+static const char* const Generate_ChannelKeys[] = { "Name", "PduLength", "RxPdus" };
+static const char* const Generate_GlobalKeys[] = { "ConfigVariant", "MainFunctionPeriod", "PnResetTime", "WakeUpStaggerTime", "WakeUpStagger",
+ "Features", "PnInfo", "Controllers", "Channels" };
+static const char* const Generate_ControllerKeys[] = { "TxBucketSize", "TxTokenTime" };
+
+static const char* Generate_InputName;
+static uint32 Generate_Errors;
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+static void Generate_Error( uint32 line, const char* format, ... )
+{
+	va_list args;
+
+	fprintf(stderr, "%s:%u: error: ", Generate_InputName, (unsigned)line);
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fprintf(stderr, "\n");
+	Generate_Errors++;
+}
+
+static void* Generate_Allocate( size_t size )
+{
+	void* memory = calloc(1, size);
+
+	if (memory == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	return memory;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+    JSON reader
+\*--------------------------------------------------------------------------------------------------------------------*/
+static void Json_SkipSpace( Json_ParserType* parser )
+{
+	while (*parser->Position != '\0' && isspace((unsigned char)*parser->Position)) {
+		if (*parser->Position == '\n') {
+			parser->Line++;
+		}
+		parser->Position++;
+	}
+}
+
+static char* Json_ParseString( Json_ParserType* parser )
+{
+	const char* start = ++parser->Position;
+	char* string;
+	size_t length = 0;
+
+	while (*parser->Position != '"') {
+		if (*parser->Position == '\0' || *parser->Position == '\n') {
+			Generate_Error(parser->Line, "unterminated string");
+			return NULL;
+		}
+		if (*parser->Position == '\\') {
+			Generate_Error(parser->Line, "escape sequences are not supported");
+			return NULL;
+		}
+		parser->Position++;
+	}
+	length = (size_t)(parser->Position - start);
+	string = Generate_Allocate(length + 1);
+	memcpy(string, start, length);
+	parser->Position++;
+	return string;
+}
+
+static Json_ValueType* Json_ParseValue( Json_ParserType* parser )
+{
+	Json_ValueType* value;
+	Json_ValueType** last;
+	char* end;
+
+	Json_SkipSpace(parser);
+	value = Generate_Allocate(sizeof(Json_ValueType));
+	value->Line = parser->Line;
+
+	switch (*parser->Position) {
+	case '{':
+	case '[': {
+		boolean object = (*parser->Position == '{');
+		char close = object ? '}' : ']';
+
+		value->Kind = object ? JSON_OBJECT : JSON_ARRAY;
+		last = &value->Child;
+		parser->Position++;
+		Json_SkipSpace(parser);
+		if (*parser->Position == close) {
+			parser->Position++;
+			return value;
+		}
+		for (;;) {
+			char* key = NULL;
+
+			Json_SkipSpace(parser);
+			if (object) {
+				if (*parser->Position != '"') {
+					Generate_Error(parser->Line, "member name expected");
+					return NULL;
+				}
+				key = Json_ParseString(parser);
+				Json_SkipSpace(parser);
+				if (key == NULL || *parser->Position != ':') {
+					Generate_Error(parser->Line, "':' expected");
+					return NULL;
+				}
+				parser->Position++;
+			}
+			*last = Json_ParseValue(parser);
+			if (*last == NULL) {
+				return NULL;
+			}
+			(*last)->Key = key;
+			last = &(*last)->Next;
+			Json_SkipSpace(parser);
+			if (*parser->Position == ',') {
+				parser->Position++;
+			} else if (*parser->Position == close) {
+				parser->Position++;
+				return value;
+			} else {
+				Generate_Error(parser->Line, "',' or '%c' expected", close);
+				return NULL;
+			}
+		}
+	}
+	case '"':
+		value->Kind = JSON_STRING;
+		value->String = Json_ParseString(parser);
+		return (value->String != NULL) ? value : NULL;
+	default:
+		if (strncmp(parser->Position, "true", 4) == 0 || strncmp(parser->Position, "false", 5) == 0) {
+			value->Kind = JSON_BOOLEAN;
+			value->Boolean = (*parser->Position == 't');
+			parser->Position += value->Boolean ? 4 : 5;
+			return value;
+		}
+		if (strncmp(parser->Position, "null", 4) == 0) {
+			value->Kind = JSON_NULL;
+			parser->Position += 4;
+			return value;
+		}
+		value->Kind = JSON_NUMBER;
+		value->Number = strtod(parser->Position, &end);
+		if (end == parser->Position) {
+			Generate_Error(parser->Line, "value expected");
+			return NULL;
+		}
+		parser->Position = end;
+		return value;
+	}
+}
+
+static const Json_ValueType* Json_Member( const Json_ValueType* object, const char* key )
+{
+	for (const Json_ValueType* member = (object != NULL) ? object->Child : NULL; member != NULL; member = member->Next) {
+		if (strcmp(member->Key, key) == 0) {
+			return member;
+		}
+	}
+	return NULL;
+}
+
+static uint32 Json_Count( const Json_ValueType* array )
+{
+	uint32 count = 0;
+
+	for (const Json_ValueType* element = (array != NULL) ? array->Child : NULL; element != NULL; element = element->Next) {
+		count++;
+	}
+	return count;
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+    Checks
+\*--------------------------------------------------------------------------------------------------------------------*/
+static void Generate_CheckKeys( const Json_ValueType* object, const char* const* keys, uint32 keyCount,
+ const Generate_ParameterType* parameters, uint32 parameterCount, const char* container )
+{
+	for (const Json_ValueType* member = object->Child; member != NULL; member = member->Next) {
+		boolean known = FALSE;
+
+		for (uint32 index = 0; index < keyCount && !known; index++) {
+			known = (strcmp(member->Key, keys[index]) == 0);
+		}
+		for (uint32 index = 0; index < parameterCount && !known; index++) {
+			known = (strcmp(member->Key, parameters[index].Name) == 0);
+		}
+		if (!known) {
+			Generate_Error(member->Line, "unknown parameter %s in %s", member->Key, container);
+		}
+	}
+}
+
+static float64 Generate_Number( const Json_ValueType* object, const char* key, float64 defaultValue, float64 min, float64 max )
+{
+	const Json_ValueType* value = Json_Member(object, key);
+
+	if (value == NULL) {
+		return defaultValue;
+	}
+	if (value->Kind != JSON_NUMBER) {
+		Generate_Error(value->Line, "%s must be a number", key);
+		return defaultValue;
+	}
+	if (value->Number < min || value->Number > max) {
+		Generate_Error(value->Line, "%s out of range [%g, %g]", key, min, max);
+		return defaultValue;
+	}
+	return value->Number;
+}
+
+static boolean Generate_Boolean( const Json_ValueType* object, const char* key )
+{
+	const Json_ValueType* value = Json_Member(object, key);
+
+	if (value == NULL) {
+		return FALSE;
+	}
+	if (value->Kind != JSON_BOOLEAN) {
+		Generate_Error(value->Line, "%s must be true or false", key);
+		return FALSE;
+	}
+	return value->Boolean;
+}
+
+static uint8 Generate_Position( const Json_ValueType* object, const char* key )
+{
+	const Json_ValueType* value = Json_Member(object, key);
+
+	if (value == NULL || (value->Kind == JSON_STRING && strcmp(value->String, "OFF") == 0)) {
+		return GENERATE_PDU_OFF;
+	}
+	if (value->Kind != JSON_NUMBER || (value->Number != 0 && value->Number != 1)) {
+		Generate_Error(value->Line, "%s must be 0, 1 or \"OFF\"", key);
+		return GENERATE_PDU_OFF;
+	}
+	return (uint8)value->Number;
+}
+
+static boolean Generate_IsIdentifier( const char* name )
+{
+	if (name == NULL || name[0] == '\0' || isdigit((unsigned char)name[0]) || strlen(name) >= GENERATE_MAX_NAME_LENGTH) {
+		return FALSE;
+	}
+	for (const char* character = name; *character != '\0'; character++) {
+		if (!isalnum((unsigned char)*character) && *character != '_') {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+static uint8 Generate_RetryPolicy( const Json_ValueType* object, const char* key )
+{
+	const Json_ValueType* value = Json_Member(object, key);
+
+	if (value == NULL) {
+		return 0;
+	}
+	for (uint8 policy = 0; value->Kind == JSON_STRING && policy < sizeof(Generate_RetryPolicyNames) / sizeof(Generate_RetryPolicyNames[0]); policy++) {
+		if (strcmp(value->String, Generate_RetryPolicyNames[policy]) == 0) {
+			return policy;
+		}
+	}
+	Generate_Error(value->Line, "%s must be \"NextMainFunction\", \"Fixed\" or \"Exponential\"", key);
+	return 0;
+}
+
+static uint8 Generate_WakeUpStagger( const Json_ValueType* object )
+{
+	const Json_ValueType* value = Json_Member(object, "WakeUpStagger");
+
+	if (value == NULL) {
+		return 0;
+	}
+	for (uint8 stagger = 0; value->Kind == JSON_STRING && stagger < sizeof(Generate_WakeUpStaggerNames) / sizeof(Generate_WakeUpStaggerNames[0]); stagger++) {
+		if (strcmp(value->String, Generate_WakeUpStaggerNames[stagger]) == 0) {
+			return stagger;
+		}
+	}
+	Generate_Error(value->Line, "WakeUpStagger must be \"ChannelIndex\" or \"Hash\"");
+	return 0;
+}
+
+/* "PreCompile" fixes the feature flags at compile time, "PostBuild" (default) reads them from CanNm_Config */
+static boolean Generate_PreCompile( const Json_ValueType* root )
+{
+	const Json_ValueType* variant = Json_Member(root, "ConfigVariant");
+
+	if (variant == NULL || (variant->Kind == JSON_STRING && strcmp(variant->String, "PostBuild") == 0)) {
+		return FALSE;
+	}
+	if (variant->Kind != JSON_STRING || strcmp(variant->String, "PreCompile") != 0) {
+		Generate_Error(variant->Line, "ConfigVariant must be \"PreCompile\" or \"PostBuild\"");
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void Generate_Check( const Json_ValueType* root, uint32* maxRxPdus, uint32* rxPduCount )
+{
+	const Json_ValueType* channels = Json_Member(root, "Channels");
+	const Json_ValueType* features = Json_Member(root, "Features");
+	const Json_ValueType* controllers = Json_Member(root, "Controllers");
+	uint32 channelIndex = 0;
+
+	*maxRxPdus = 1;
+	*rxPduCount = 0;
+	if (root->Kind != JSON_OBJECT) {
+		Generate_Error(root->Line, "network description must be an object");
+		return;
+	}
+	Generate_CheckKeys(root, Generate_GlobalKeys, sizeof(Generate_GlobalKeys) / sizeof(Generate_GlobalKeys[0]), NULL, 0, "CanNmGlobalConfig");
+	if (Json_Member(root, "MainFunctionPeriod") == NULL) {
+		Generate_Error(root->Line, "MainFunctionPeriod missing");
+	}
+	Generate_Number(root, "MainFunctionPeriod", 1, 1e-6, 1e6);
+	Generate_Number(root, "PnResetTime", 0, 0, 1e9);
+	Generate_Number(root, "WakeUpStaggerTime", 0, 0, 1e9);
+	Generate_WakeUpStagger(root);
+	Generate_PreCompile(root);
+	if (features != NULL) {
+		for (const Json_ValueType* member = features->Child; member != NULL; member = member->Next) {
+			boolean known = FALSE;
+
+			for (uint32 index = 0; index < sizeof(Generate_Features) / sizeof(Generate_Features[0]) && !known; index++) {
+				known = (strcmp(member->Key, Generate_Features[index].Name) == 0);
+			}
+			if (!known) {
+				Generate_Error(member->Line, "unknown feature %s", member->Key);
+			}
+			Generate_Boolean(features, member->Key);
+		}
+	}
+	if (controllers != NULL && (controllers->Kind != JSON_ARRAY || controllers->Child == NULL)) {
+		Generate_Error(controllers->Line, "Controllers must be a non-empty array");
+		controllers = NULL;
+	}
+	for (const Json_ValueType* controller = (controllers != NULL) ? controllers->Child : NULL; controller != NULL; controller = controller->Next) {
+		if (controller->Kind != JSON_OBJECT) {
+			Generate_Error(controller->Line, "controller must be an object");
+			continue;
+		}
+		Generate_CheckKeys(controller, Generate_ControllerKeys, sizeof(Generate_ControllerKeys) / sizeof(Generate_ControllerKeys[0]), NULL, 0, "CanNmController");
+		Generate_Number(controller, "TxBucketSize", 0, 0, 65535);
+		Generate_Number(controller, "TxTokenTime", 0, 0, 1e9);
+	}
+	if (channels == NULL || channels->Kind != JSON_ARRAY || channels->Child == NULL) {
+		Generate_Error(root->Line, "Channels must be a non-empty array");
+		return;
+	}
+	if (controllers != NULL && Json_Count(controllers) > Json_Count(channels)) {
+		Generate_Error(controllers->Line, "more controllers than channels");
+	}
+	if (Json_Count(channels) > GENERATE_MAX_CHANNELS) {
+		Generate_Error(channels->Line, "more than %u channels", (unsigned)GENERATE_MAX_CHANNELS);
+	}
+
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next, channelIndex++) {
+		const Json_ValueType* name = Json_Member(channel, "Name");
+		const Json_ValueType* rxPdus = Json_Member(channel, "RxPdus");
+		uint32 pduLength;
+
+		if (channel->Kind != JSON_OBJECT) {
+			Generate_Error(channel->Line, "channel %u must be an object", (unsigned)channelIndex);
+			continue;
+		}
+		Generate_CheckKeys(channel, Generate_ChannelKeys, sizeof(Generate_ChannelKeys) / sizeof(Generate_ChannelKeys[0]),
+		 Generate_ChannelParameters, sizeof(Generate_ChannelParameters) / sizeof(Generate_ChannelParameters[0]), "CanNmChannelConfig");
+		if (name == NULL || name->Kind != JSON_STRING || !Generate_IsIdentifier(name->String)) {
+			Generate_Error(channel->Line, "channel %u needs a Name that is a C identifier", (unsigned)channelIndex);
+		}
+		for (const Json_ValueType* other = channels->Child; other != channel && name != NULL; other = other->Next) {
+			const Json_ValueType* otherName = Json_Member(other, "Name");
+
+			if (otherName != NULL && otherName->Kind == JSON_STRING && name->Kind == JSON_STRING && strcmp(otherName->String, name->String) == 0) {
+				Generate_Error(channel->Line, "duplicate channel name %s", name->String);
+			}
+		}
+		for (uint32 index = 0; index < sizeof(Generate_ChannelParameters) / sizeof(Generate_ChannelParameters[0]); index++) {
+			const Generate_ParameterType* parameter = &Generate_ChannelParameters[index];
+
+			switch (parameter->Kind) {
+			case PARAMETER_BOOLEAN:		Generate_Boolean(channel, parameter->Name); break;
+			case PARAMETER_TIME:		Generate_Number(channel, parameter->Name, 0, 0, 1e9); break;
+			case PARAMETER_UINT8:		Generate_Number(channel, parameter->Name, 0, 0, 255); break;
+			case PARAMETER_POSITION:	Generate_Position(channel, parameter->Name); break;
+			case PARAMETER_HANDLE:		Generate_Number(channel, parameter->Name, channelIndex, 0, 65534); break;
+			case PARAMETER_RETRY_POLICY:	Generate_RetryPolicy(channel, parameter->Name); break;
+			}
+		}
+		pduLength = (uint32)Generate_Number(channel, "PduLength", 8, 1, GENERATE_MAX_PDU_LENGTH);
+		if (Generate_Position(channel, "PduCbvPosition") != GENERATE_PDU_OFF &&
+		 Generate_Position(channel, "PduCbvPosition") == Generate_Position(channel, "PduNidPosition")) {
+			Generate_Error(channel->Line, "PduCbvPosition and PduNidPosition overlap");
+		}
+		if (pduLength < 2 && (Generate_Position(channel, "PduCbvPosition") == 1 || Generate_Position(channel, "PduNidPosition") == 1)) {
+			Generate_Error(channel->Line, "PduLength too short for the CBV and NID bytes");
+		}
+		if (Generate_Number(channel, "ControllerIndex", 0, 0, 255) >= ((controllers != NULL) ? Json_Count(controllers) : 1) &&
+		 Generate_Number(channel, "ControllerIndex", 0, 0, 255) != 255) {
+			Generate_Error(channel->Line, "ControllerIndex must name one of the Controllers or be 255");
+		}
+		if (Generate_Number(channel, "CoordClusterIndex", 0, 0, 255) >= GENERATE_MAX_COORD_CLUSTERS &&
+		 Generate_Number(channel, "CoordClusterIndex", 0, 0, 255) != 255) {
+			Generate_Error(channel->Line, "CoordClusterIndex must be below %u or 255", (unsigned)GENERATE_MAX_COORD_CLUSTERS);
+		}
+		if (Generate_Number(channel, "TimeoutTime", 0, 0, 1e9) <= 0 || Generate_Number(channel, "MsgCycleTime", 0, 0, 1e9) <= 0) {
+			Generate_Error(channel->Line, "channel %u needs TimeoutTime and MsgCycleTime", (unsigned)channelIndex);
+		}
+		if (rxPdus == NULL || rxPdus->Kind != JSON_ARRAY || rxPdus->Child == NULL) {
+			Generate_Error(channel->Line, "channel %u needs a non-empty RxPdus array", (unsigned)channelIndex);
+			continue;
+		}
+		if (Json_Count(rxPdus) > *maxRxPdus) {
+			*maxRxPdus = Json_Count(rxPdus);
+		}
+		for (const Json_ValueType* rxPdu = rxPdus->Child; rxPdu != NULL; rxPdu = rxPdu->Next) {
+			const Json_ValueType* rxName = Json_Member(rxPdu, "Name");
+			uint32 id = (uint32)Generate_Number(rxPdu, "Id", 0, 0, 65534);
+
+			if (rxName == NULL || rxName->Kind != JSON_STRING || !Generate_IsIdentifier(rxName->String) || Json_Member(rxPdu, "Id") == NULL) {
+				Generate_Error(rxPdu->Line, "Rx PDU needs a Name that is a C identifier and an Id");
+			}
+			if (id + 1 > *rxPduCount) {
+				*rxPduCount = id + 1;
+			}
+		}
+	}
+
+	/* Every RxPduId belongs to exactly one channel */
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next) {
+		for (const Json_ValueType* rxPdu = Json_Member(channel, "RxPdus") ? Json_Member(channel, "RxPdus")->Child : NULL; rxPdu != NULL; rxPdu = rxPdu->Next) {
+			for (const Json_ValueType* other = channels->Child; other != NULL; other = other->Next) {
+				for (const Json_ValueType* otherPdu = Json_Member(other, "RxPdus") ? Json_Member(other, "RxPdus")->Child : NULL; otherPdu != NULL && otherPdu != rxPdu; otherPdu = otherPdu->Next) {
+					if (Generate_Number(otherPdu, "Id", 0, 0, 65534) == Generate_Number(rxPdu, "Id", 0, 0, 65534)) {
+						Generate_Error(rxPdu->Line, "RxPduId %u used twice", (unsigned)Generate_Number(rxPdu, "Id", 0, 0, 65534));
+					}
+				}
+				if (other == channel) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+/*--------------------------------------------------------------------------------------------------------------------*\
+    Output
+\*--------------------------------------------------------------------------------------------------------------------*/
+static void Generate_FileHeader( FILE* out, const char* file, const char* brief )
+{
+	fprintf(out, "/** ==================================================================================================================*\\\n");
+	fprintf(out, "  @file %s\n\n", file);
+	fprintf(out, "  @brief %s\n\n", brief);
+	fprintf(out, "  Generated by CanNm_Generate from %s, do not edit.\n", Generate_InputName);
+	fprintf(out, "\\*====================================================================================================================*/\n");
+}
+
+static void Generate_Section( FILE* out, const char* title )
+{
+	fprintf(out, "\n/*====================================================================================================================*\\\n");
+	fprintf(out, "    %s\n", title);
+	fprintf(out, "\\*====================================================================================================================*/\n");
+}
+
+static const char* Generate_Float( float64 value )
+{
+	static char text[4][32];
+	static uint32 next;
+	char* buffer = text[next++ % 4];
+
+	snprintf(buffer, sizeof(text[0]), "%.9g", value);
+	if (strpbrk(buffer, ".e") == NULL) {
+		strcat(buffer, ".0");
+	}
+	strcat(buffer, "f");
+	return buffer;
+}
+
+static const char* Generate_ChannelName( const Json_ValueType* channel )
+{
+	return Json_Member(channel, "Name")->String;
+}
+
+static void Generate_Header( FILE* out, const Json_ValueType* root, uint32 maxRxPdus )
+{
+	const Json_ValueType* channels = Json_Member(root, "Channels");
+	const Json_ValueType* features = Json_Member(root, "Features");
+	const Json_ValueType* controllers = Json_Member(root, "Controllers");
+	uint32 channelIndex = 0;
+	uint32 clusterCount = 1;
+	uint32 maxPduLength = 8;
+
+	Generate_FileHeader(out, "CanNm_Cfg.h", "Pre-compile configuration of the Can Network Management Module");
+	fprintf(out, "#ifndef CANNM_CFG_H\n#define CANNM_CFG_H\n");
+
+	Generate_Section(out, "Global macros");
+	fprintf(out, "#define CANNM_CHANNEL_COUNT %u\n", (unsigned)Json_Count(channels));
+	fprintf(out, "#define CANNM_RXPDU_MAX_COUNT %u\n", (unsigned)maxRxPdus);
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next) {
+		uint32 cluster = (uint32)Generate_Number(channel, "CoordClusterIndex", 0, 0, 255);
+		uint32 pduLength = (uint32)Generate_Number(channel, "PduLength", 8, 1, GENERATE_MAX_PDU_LENGTH);
+
+		if (pduLength > maxPduLength) {
+			maxPduLength = pduLength;
+		}
+		if (cluster != 255 && cluster + 1 > clusterCount) {
+			clusterCount = cluster + 1;
+		}
+	}
+	fprintf(out, "#define CANNM_COORD_CLUSTER_COUNT %u\n", (unsigned)clusterCount);
+	fprintf(out, "#define CANNM_CONTROLLER_COUNT %u\n", (unsigned)((controllers != NULL) ? Json_Count(controllers) : 1));
+	fprintf(out, "#define CANNM_PDU_MAX_LENGTH %u\n", (unsigned)maxPduLength);
+	if (Json_Count(channels) > 255) {
+		fprintf(out, "\n#ifndef COMSTACK_NETWORK_HANDLE_16BIT\n#error \"More than 255 channels need COMSTACK_NETWORK_HANDLE_16BIT\"\n#endif\n");
+	}
+
+	fprintf(out, "#define CANNM_CONFIG_VARIANT %s\n",
+	 Generate_PreCompile(root) ? "CANNM_VARIANT_PRE_COMPILE" : "CANNM_VARIANT_POST_BUILD");
+	fprintf(out, "\n/* Optional features */\n");
+	for (uint32 index = 0; index < sizeof(Generate_Features) / sizeof(Generate_Features[0]); index++) {
+		if (Generate_Features[index].Switch != NULL) {
+			fprintf(out, "#define %-40s %s\n", Generate_Features[index].Switch,
+			 Generate_Boolean(features, Generate_Features[index].Name) ? "STD_ON" : "STD_OFF");
+		}
+	}
+
+	fprintf(out, "\n/* Channel handles */\n");
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next, channelIndex++) {
+		fprintf(out, "#define CanNmConf_CanNmChannelConfig_%-24s %u\n", Generate_ChannelName(channel), (unsigned)channelIndex);
+	}
+
+	fprintf(out, "\n/* PDU handles, the Tx PDU ids are the channel handles */\n");
+	channelIndex = 0;
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next, channelIndex++) {
+		for (const Json_ValueType* rxPdu = Json_Member(channel, "RxPdus")->Child; rxPdu != NULL; rxPdu = rxPdu->Next) {
+			fprintf(out, "#define CanNmConf_CanNmRxPdu_%-32s %u\n", Json_Member(rxPdu, "Name")->String,
+			 (unsigned)Generate_Number(rxPdu, "Id", 0, 0, 65534));
+		}
+		fprintf(out, "#define CanNmConf_CanNmTxPdu_%-32s %u\n", Generate_ChannelName(channel), (unsigned)channelIndex);
+	}
+
+	fprintf(out, "\n/* Configuration set passed to CanNm_Init */\n");
+	fprintf(out, "#define CANNM_CONFIG_SET CanNm_Config\n");
+	fprintf(out, "\n#endif /* CANNM_CFG_H */\n");
+}
+
+static void Generate_Source( FILE* out, const Json_ValueType* root, uint32 maxRxPdus, uint32 rxPduCount )
+{
+	const Json_ValueType* channels = Json_Member(root, "Channels");
+	const Json_ValueType* features = Json_Member(root, "Features");
+	const Json_ValueType* controllers = Json_Member(root, "Controllers");
+	const Json_ValueType* pnInfo = Json_Member(root, "PnInfo");
+	uint32 channelIndex = 0;
+
+	Generate_FileHeader(out, "CanNm_Cfg.c", "Configuration set of the Can Network Management Module");
+	Generate_Section(out, "Include headers");
+	fprintf(out, "#include \"CanNm.h\"\n");
+
+	Generate_Section(out, "Local variables (static)");
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next) {
+		const char* name = Generate_ChannelName(channel);
+		uint32 pduLength = (uint32)Generate_Number(channel, "PduLength", 8, 1, GENERATE_MAX_PDU_LENGTH);
+
+		fprintf(out, "/* %s */\n", name);
+		fprintf(out, "static const PduInfoType CanNm_%s_TxPduInfo = { .SduLength = %u };\n", name, (unsigned)pduLength);
+		fprintf(out, "static const CanNm_TxPdu CanNm_%s_TxPdu = { .TxConfirmationPduId = CanNmConf_CanNmTxPdu_%s, .TxPduRef = &CanNm_%s_TxPduInfo };\n", name, name, name);
+		fprintf(out, "static const CanNm_UserDataTxPdu CanNm_%s_UserDataTxPdu = { .TxUserDataPduId = CanNmConf_CanNmTxPdu_%s, .TxUserDataPduRef = &CanNm_%s_TxPduInfo };\n", name, name, name);
+		for (const Json_ValueType* rxPdu = Json_Member(channel, "RxPdus")->Child; rxPdu != NULL; rxPdu = rxPdu->Next) {
+			const char* rxName = Json_Member(rxPdu, "Name")->String;
+
+			fprintf(out, "static const PduInfoType CanNm_%s_PduInfo = { .SduLength = %u };\n", rxName, (unsigned)pduLength);
+			fprintf(out, "static const CanNm_RxPdu CanNm_%s = { .RxPduId = CanNmConf_CanNmRxPdu_%s, .RxPduRef = &CanNm_%s_PduInfo };\n", rxName, rxName, rxName);
+		}
+		fprintf(out, "\n");
+	}
+
+	if (controllers != NULL) {
+		fprintf(out, "static const CanNm_ControllerType CanNm_ControllerConfig[] = {\n");
+		for (const Json_ValueType* controller = controllers->Child; controller != NULL; controller = controller->Next) {
+			fprintf(out, "\t{ .TxBucketSize = %u, .TxTokenTime = %s }%s\n", (unsigned)Generate_Number(controller, "TxBucketSize", 0, 0, 65535),
+			 Generate_Float(Generate_Number(controller, "TxTokenTime", 0, 0, 1e9)), (controller->Next != NULL) ? "," : "");
+		}
+		fprintf(out, "};\n\n");
+	}
+
+	if (pnInfo != NULL) {
+		const Json_ValueType* filterMask = Json_Member(pnInfo, "FilterMask");
+		uint32 maskIndex = 0;
+
+		fprintf(out, "static const CanNm_PnFilterMaskByte CanNm_PnFilterMaskBytes[] = {\n");
+		for (const Json_ValueType* maskByte = (filterMask != NULL) ? filterMask->Child : NULL; maskByte != NULL; maskByte = maskByte->Next, maskIndex++) {
+			fprintf(out, "\t{ .PnFilterMaskByteIndex = %u, .PnFilterMaskByteValue = 0x%02X },\n",
+			 (unsigned)Generate_Number(maskByte, "Index", maskIndex, 0, 6), (unsigned)Generate_Number(maskByte, "Value", 0, 0, 255));
+		}
+		if (maskIndex == 0) {
+			fprintf(out, "\t{ .PnFilterMaskByteIndex = 0, .PnFilterMaskByteValue = 0x00 }\n");
+		}
+		fprintf(out, "};\n\n");
+		fprintf(out, "static const CanNm_PnInfo CanNm_PnInfoConfig = {\n\t.PnInfoLength = %u,\n\t.PnInfoOffset = %u,\n\t.PnFilterMaskByte = CanNm_PnFilterMaskBytes\n};\n\n",
+		 (unsigned)Generate_Number(pnInfo, "Length", 0, 0, 7), (unsigned)Generate_Number(pnInfo, "Offset", 0, 0, 7));
+	}
+
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next, channelIndex++) {
+		const char* name = Generate_ChannelName(channel);
+		const Json_ValueType* rxPdus = Json_Member(channel, "RxPdus");
+		uint32 rxPduNumber = Json_Count(rxPdus);
+
+		fprintf(out, "static const CanNm_ChannelType CanNm_%s_Channel = {\n", name);
+		for (uint32 index = 0; index < sizeof(Generate_ChannelParameters) / sizeof(Generate_ChannelParameters[0]); index++) {
+			const Generate_ParameterType* parameter = &Generate_ChannelParameters[index];
+			uint8 position;
+
+			switch (parameter->Kind) {
+			case PARAMETER_BOOLEAN:
+				fprintf(out, "\t.%-32s = %s,\n", parameter->Name, Generate_Boolean(channel, parameter->Name) ? "TRUE" : "FALSE");
+				break;
+			case PARAMETER_TIME:
+				fprintf(out, "\t.%-32s = %s,\n", parameter->Name, Generate_Float(Generate_Number(channel, parameter->Name, 0, 0, 1e9)));
+				break;
+			case PARAMETER_UINT8:
+				fprintf(out, "\t.%-32s = %u,\n", parameter->Name, (unsigned)Generate_Number(channel, parameter->Name, 0, 0, 255));
+				break;
+			case PARAMETER_POSITION:
+				position = Generate_Position(channel, parameter->Name);
+				fprintf(out, "\t.%-32s = %s,\n", parameter->Name,
+				 (position == GENERATE_PDU_OFF) ? "CANNM_PDU_OFF" : ((position == 0) ? "CANNM_PDU_BYTE_0" : "CANNM_PDU_BYTE_1"));
+				break;
+			case PARAMETER_HANDLE:
+				fprintf(out, "\t.%-32s = %u,\n", parameter->Name, (unsigned)Generate_Number(channel, parameter->Name, channelIndex, 0, 65534));
+				break;
+			case PARAMETER_RETRY_POLICY:
+				fprintf(out, "\t.%-32s = %s,\n", parameter->Name, Generate_RetryPolicyValues[Generate_RetryPolicy(channel, parameter->Name)]);
+				break;
+			}
+		}
+		/* The RxPdu slots form the reception ring, channels with fewer Rx PDUs reuse them round robin */
+		fprintf(out, "\t.%-32s = {", "RxPdu");
+		for (uint32 slot = 0; slot < maxRxPdus; slot++) {
+			const Json_ValueType* rxPdu = rxPdus->Child;
+
+			for (uint32 skip = 0; skip < slot % rxPduNumber; skip++) {
+				rxPdu = rxPdu->Next;
+			}
+			fprintf(out, "%s&CanNm_%s", (slot == 0) ? " " : ", ", Json_Member(rxPdu, "Name")->String);
+		}
+		fprintf(out, " },\n");
+		fprintf(out, "\t.%-32s = &CanNm_%s_TxPdu,\n", "TxPdu", name);
+		fprintf(out, "\t.%-32s = &CanNm_%s_UserDataTxPdu\n", "UserDataTxPdu", name);
+		fprintf(out, "};\n\n");
+	}
+
+	fprintf(out, "/* Channel of every RxPduId */\n");
+	fprintf(out, "static const NetworkHandleType CanNm_RxPduChannelMap[%u] = {\n", (unsigned)rxPduCount);
+	for (uint32 id = 0; id < rxPduCount; id++) {
+		const char* channelName = NULL;
+
+		for (const Json_ValueType* channel = channels->Child; channel != NULL && channelName == NULL; channel = channel->Next) {
+			for (const Json_ValueType* rxPdu = Json_Member(channel, "RxPdus")->Child; rxPdu != NULL; rxPdu = rxPdu->Next) {
+				if ((uint32)Generate_Number(rxPdu, "Id", 0, 0, 65534) == id) {
+					channelName = Generate_ChannelName(channel);
+				}
+			}
+		}
+		if (channelName != NULL) {
+			fprintf(out, "\t[%u] = CanNmConf_CanNmChannelConfig_%s,\n", (unsigned)id, channelName);
+		} else {
+			fprintf(out, "\t[%u] = CANNM_INVALID_CHANNEL,\n", (unsigned)id);
+		}
+	}
+	fprintf(out, "};\n");
+
+	Generate_Section(out, "Global variables");
+	fprintf(out, "const CanNm_ConfigType CanNm_Config = {\n");
+	for (uint32 index = 0; index < sizeof(Generate_Features) / sizeof(Generate_Features[0]); index++) {
+		fprintf(out, "\t.%-26s = %s,\n", Generate_Features[index].Name, Generate_Boolean(features, Generate_Features[index].Name) ? "TRUE" : "FALSE");
+	}
+	fprintf(out, "\t.%-26s = %s,\n", "MainFunctionPeriod", Generate_Float(Generate_Number(root, "MainFunctionPeriod", 1, 1e-6, 1e6)));
+	fprintf(out, "\t.%-26s = %s,\n", "PnResetTime", Generate_Float(Generate_Number(root, "PnResetTime", 0, 0, 1e9)));
+	if (pnInfo != NULL) {
+		fprintf(out, "\t.%-26s = &CanNm_PnInfoConfig,\n", "PnInfo");
+	}
+	fprintf(out, "\t.%-26s = {\n", "ChannelConfig");
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next) {
+		fprintf(out, "\t\t&CanNm_%s_Channel%s\n", Generate_ChannelName(channel), (channel->Next != NULL) ? "," : "");
+	}
+	fprintf(out, "\t},\n");
+	fprintf(out, "\t.%-26s = CanNm_RxPduChannelMap,\n", "RxPduChannelMap");
+	fprintf(out, "\t.%-26s = %u,\n", "RxPduCount", (unsigned)rxPduCount);
+	fprintf(out, "\t.%-26s = %s,\n", "WakeUpStaggerTime", Generate_Float(Generate_Number(root, "WakeUpStaggerTime", 0, 0, 1e9)));
+	fprintf(out, "\t.%-26s = %s%s\n", "WakeUpStagger", Generate_WakeUpStaggerValues[Generate_WakeUpStagger(root)], (controllers != NULL) ? "," : "");
+	if (controllers != NULL) {
+		fprintf(out, "\t.%-26s = CanNm_ControllerConfig\n", "ControllerConfig");
+	}
+	fprintf(out, "};\n");
+}
+
+/* Same configuration set as Generate_Source in the binary format of CanNm_ImageHeaderType, for CanNm_LoadConfigImage */
+static void Generate_Image( FILE* out, const Json_ValueType* root, uint32 rxPduCount )
+{
+	const Json_ValueType* channels = Json_Member(root, "Channels");
+	const Json_ValueType* features = Json_Member(root, "Features");
+	const Json_ValueType* controllers = Json_Member(root, "Controllers");
+	const Json_ValueType* pnInfo = Json_Member(root, "PnInfo");
+	const Json_ValueType* filterMask = (pnInfo != NULL) ? Json_Member(pnInfo, "FilterMask") : NULL;
+	uint32 channelCount = Json_Count(channels);
+	uint32 handleSize = (channelCount > 255) ? 2 : 1;		//COMSTACK_NETWORK_HANDLE_16BIT, see Generate_Header
+	CanNm_ImageHeaderType header = {
+		.Magic = CANNM_IMAGE_MAGIC,
+		.Version = CANNM_IMAGE_VERSION,
+		.ByteOrder = CANNM_IMAGE_BYTE_ORDER,
+		.HeaderSize = sizeof(CanNm_ImageHeaderType),
+		.ChannelSize = sizeof(CanNm_ImageChannelType),
+		.HandleSize = (uint8)handleSize
+	};
+	uint32 totalRxPdus = 0;
+	uint32 channelIndex = 0;
+	uint32 rxPduIndex = 0;
+	uint32 length;
+	uint8* image;
+
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next) {
+		totalRxPdus += Json_Count(Json_Member(channel, "RxPdus"));
+	}
+	header.Channels = (CanNm_ImageTableType){ GENERATE_IMAGE_ALIGN(sizeof(CanNm_ImageHeaderType)), channelCount };
+	header.RxPduIds = (CanNm_ImageTableType){ GENERATE_IMAGE_ALIGN(header.Channels.Offset + channelCount * sizeof(CanNm_ImageChannelType)), totalRxPdus };
+	header.RxPduChannelMap = (CanNm_ImageTableType){ GENERATE_IMAGE_ALIGN(header.RxPduIds.Offset + totalRxPdus * sizeof(PduIdType)), rxPduCount };
+	header.Controllers = (CanNm_ImageTableType){ GENERATE_IMAGE_ALIGN(header.RxPduChannelMap.Offset + rxPduCount * handleSize),
+	 (controllers != NULL) ? Json_Count(controllers) : 0 };
+	header.PnFilterMaskBytes = (CanNm_ImageTableType){ GENERATE_IMAGE_ALIGN(header.Controllers.Offset + header.Controllers.Count * sizeof(CanNm_ControllerType)),
+	 (filterMask != NULL) ? Json_Count(filterMask) : 0 };
+	length = GENERATE_IMAGE_ALIGN(header.PnFilterMaskBytes.Offset + header.PnFilterMaskBytes.Count * sizeof(CanNm_PnFilterMaskByte));
+	header.Length = length;
+
+	header.MainFunctionPeriod = (float32)Generate_Number(root, "MainFunctionPeriod", 1, 1e-6, 1e6);
+	header.PnResetTime = (float32)Generate_Number(root, "PnResetTime", 0, 0, 1e9);
+	header.WakeUpStaggerTime = (float32)Generate_Number(root, "WakeUpStaggerTime", 0, 0, 1e9);
+	header.WakeUpStagger = Generate_WakeUpStagger(root);
+	if (pnInfo != NULL) {
+		header.PnInfoEnabled = TRUE;
+		header.PnInfoLength = (uint8)Generate_Number(pnInfo, "Length", 0, 0, 7);
+		header.PnInfoOffset = (uint8)Generate_Number(pnInfo, "Offset", 0, 0, 7);
+	}
+	for (uint32 index = 0; index < sizeof(Generate_Features) / sizeof(Generate_Features[0]); index++) {
+		*((boolean*)((uint8*)&header + Generate_Features[index].ImageOffset)) = Generate_Boolean(features, Generate_Features[index].Name);
+	}
+
+	image = Generate_Allocate(length);
+	memcpy(image, &header, sizeof(header));
+	memset(&image[header.RxPduChannelMap.Offset], 0xFF, rxPduCount * handleSize);	//CANNM_INVALID_CHANNEL for unused ids
+	for (const Json_ValueType* channel = channels->Child; channel != NULL; channel = channel->Next, channelIndex++) {
+		CanNm_ImageChannelType* imageChannel = (CanNm_ImageChannelType*)&image[header.Channels.Offset + channelIndex * sizeof(CanNm_ImageChannelType)];
+		const Json_ValueType* rxPdus = Json_Member(channel, "RxPdus");
+
+		for (uint32 index = 0; index < sizeof(Generate_ChannelParameters) / sizeof(Generate_ChannelParameters[0]); index++) {
+			const Generate_ParameterType* parameter = &Generate_ChannelParameters[index];
+			uint8* member = (uint8*)imageChannel + parameter->ImageOffset;
+
+			switch (parameter->Kind) {
+			case PARAMETER_BOOLEAN:		*(boolean*)member = Generate_Boolean(channel, parameter->Name); break;
+			case PARAMETER_TIME:		*(float32*)member = (float32)Generate_Number(channel, parameter->Name, 0, 0, 1e9); break;
+			case PARAMETER_UINT8:		*member = (uint8)Generate_Number(channel, parameter->Name, 0, 0, 255); break;
+			case PARAMETER_POSITION:	*member = Generate_Position(channel, parameter->Name); break;
+			case PARAMETER_HANDLE:		*(uint16*)member = (uint16)Generate_Number(channel, parameter->Name, channelIndex, 0, 65534); break;
+			case PARAMETER_RETRY_POLICY:	*member = Generate_RetryPolicy(channel, parameter->Name); break;
+			}
+		}
+		imageChannel->RxPduIndex = rxPduIndex;
+		imageChannel->RxPduCount = (uint8)Json_Count(rxPdus);
+		imageChannel->PduLength = (uint8)Generate_Number(channel, "PduLength", 8, 1, GENERATE_MAX_PDU_LENGTH);
+		imageChannel->TxConfirmationPduId = (PduIdType)channelIndex;
+		imageChannel->TxUserDataPduId = (PduIdType)channelIndex;
+		for (const Json_ValueType* rxPdu = rxPdus->Child; rxPdu != NULL; rxPdu = rxPdu->Next, rxPduIndex++) {
+			PduIdType id = (PduIdType)Generate_Number(rxPdu, "Id", 0, 0, 65534);
+
+			memcpy(&image[header.RxPduIds.Offset + rxPduIndex * sizeof(PduIdType)], &id, sizeof(id));
+			if (handleSize == 2) {
+				uint16 handle = (uint16)channelIndex;
+
+				memcpy(&image[header.RxPduChannelMap.Offset + id * handleSize], &handle, sizeof(handle));
+			} else {
+				image[header.RxPduChannelMap.Offset + id] = (uint8)channelIndex;
+			}
+		}
+	}
+	uint32 controllerIndex = 0;
+	for (const Json_ValueType* controller = (controllers != NULL) ? controllers->Child : NULL; controller != NULL; controller = controller->Next, controllerIndex++) {
+		CanNm_ControllerType controllerConfig = {
+			.TxBucketSize = (uint16)Generate_Number(controller, "TxBucketSize", 0, 0, 65535),
+			.TxTokenTime = (float32)Generate_Number(controller, "TxTokenTime", 0, 0, 1e9)
+		};
+
+		memcpy(&image[header.Controllers.Offset + controllerIndex * sizeof(CanNm_ControllerType)], &controllerConfig, sizeof(controllerConfig));
+	}
+
+	uint32 maskIndex = 0;
+	for (const Json_ValueType* maskByte = (filterMask != NULL) ? filterMask->Child : NULL; maskByte != NULL; maskByte = maskByte->Next, maskIndex++) {
+		CanNm_PnFilterMaskByte mask = {
+			.PnFilterMaskByteIndex = (uint8)Generate_Number(maskByte, "Index", maskIndex, 0, 6),
+			.PnFilterMaskByteValue = (uint8)Generate_Number(maskByte, "Value", 0, 0, 255)
+		};
+
+		memcpy(&image[header.PnFilterMaskBytes.Offset + maskIndex * sizeof(CanNm_PnFilterMaskByte)], &mask, sizeof(mask));
+	}
+
+	if (fwrite(image, 1, length, out) != length) {
+		perror("CanNm_Cfg.bin");
+		exit(1);
+	}
+	free(image);
+}
+
+static FILE* Generate_Open( const char* directory, const char* file, const char* mode )
+{
+	char path[4096];
+	FILE* out;
+
+	snprintf(path, sizeof(path), "%s/%s", directory, file);
+	out = fopen(path, mode);
+	if (out == NULL) {
+		perror(path);
+		exit(1);
+	}
+	return out;
+}
+
+/*====================================================================================================================*\
+    Main
+\*====================================================================================================================*/
+int main(int argc, char** argv)
+{
+	Json_ParserType parser;
+	Json_ValueType* root;
+	uint32 maxRxPdus;
+	uint32 rxPduCount;
+	char* text;
+	long size;
+	FILE* in;
+	FILE* out;
+
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s <description.json> <output directory>\n", argv[0]);
+		return 1;
+	}
+	Generate_InputName = argv[1];
+	in = fopen(argv[1], "rb");
+	if (in == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	fseek(in, 0, SEEK_END);
+	size = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	text = Generate_Allocate((size_t)size + 1);
+	if (fread(text, 1, (size_t)size, in) != (size_t)size) {
+		perror(argv[1]);
+		return 1;
+	}
+	fclose(in);
+
+	parser.Text = text;
+	parser.Position = text;
+	parser.Line = 1;
+	root = Json_ParseValue(&parser);
+	if (root != NULL) {
+		Json_SkipSpace(&parser);
+		if (*parser.Position != '\0') {
+			Generate_Error(parser.Line, "trailing characters");
+		}
+	}
+	if (root == NULL || Generate_Errors != 0) {
+		return 1;
+	}
+	Generate_Check(root, &maxRxPdus, &rxPduCount);
+	if (Generate_Errors != 0) {
+		fprintf(stderr, "%u error(s), nothing generated\n", (unsigned)Generate_Errors);
+		return 1;
+	}
+
+	out = Generate_Open(argv[2], "CanNm_Cfg.h", "w");
+	Generate_Header(out, root, maxRxPdus);
+	fclose(out);
+	out = Generate_Open(argv[2], "CanNm_Cfg.c", "w");
+	Generate_Source(out, root, maxRxPdus, rxPduCount);
+	fclose(out);
+	out = Generate_Open(argv[2], "CanNm_Cfg.bin", "wb");
+	Generate_Image(out, root, rxPduCount);
+	fclose(out);
+
+	printf("%s: %u channel(s), %u Rx PDU id(s) -> %s/CanNm_Cfg.h, %s/CanNm_Cfg.c, %s/CanNm_Cfg.bin\n", argv[1],
+	 (unsigned)Json_Count(Json_Member(root, "Channels")), (unsigned)rxPduCount, argv[2], argv[2], argv[2]);
+	return 0;
+}
@@ -0,0 +1,883 @@
+/** ==================================================================================================================*\
+  @file CanNm_Replay.c
+
+  @brief Trace replay driver for the Can Network Management Module
+
+  Feeds NM frames recorded with candump (-l or -ta output) or captured in pcap/pcapng files (SocketCAN link types)
+  into CanNm_RxIndication. CanNm_MainFunction is interleaved according to the recorded timestamps, either as fast as
+  possible or paced in real time. Prints the resulting state timeline and the replay throughput.
+
+  Build: gcc -O2 -I../Src -DCANNM_PDU_MAX_LENGTH=64 CanNm_Replay.c ../Src/CanNm.c ../Src/SchM_CanNm.c -o CanNm_Replay
+         (add -DCANNM_TRACE_ENABLED=STD_ON for the --trace option,
+          -DCANNM_VIRTUAL_CLOCK_ENABLED=STD_ON to skip idle main function periods)
+  Usage: CanNm_Replay [options] <trace.log|trace.pcap|trace.pcapng>
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+#include "CanNm.h"
+#include "SchM_CanNm.h"
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#define REPLAY_MAX_MAPPINGS			32
+#define REPLAY_MAX_INTERFACES		64
+#define REPLAY_IFNAME_LENGTH		16
+#define REPLAY_MAX_PDU_LENGTH		64
+
+#define PCAP_MAGIC_US				0xA1B2C3D4UL
+#define PCAP_MAGIC_NS				0xA1B23C4DUL
+#define PCAPNG_BLOCK_SHB			0x0A0D0D0AUL
+#define PCAPNG_BLOCK_IDB			0x00000001UL
+#define PCAPNG_BLOCK_EPB			0x00000006UL
+#define PCAPNG_BYTE_ORDER_MAGIC		0x1A2B3C4DUL
+
+#define LINKTYPE_LINUX_SLL			113
+#define LINKTYPE_CAN_SOCKETCAN		227
+
+#define CAN_EFF_FLAG				0x80000000UL
+#define CAN_RTR_FLAG				0x40000000UL
+#define CAN_ERR_FLAG				0x20000000UL
+#define CAN_EFF_MASK				0x1FFFFFFFUL
+
+/*====================================================================================================================*\
+    Local types
+\*====================================================================================================================*/
+typedef struct {
+	char		Interface[REPLAY_IFNAME_LENGTH];	/* Empty string matches any interface */
+	uint32		CanId;
+	uint32		CanIdMask;
+	PduIdType	RxPduId;
+} Replay_MappingType;
+
+typedef struct {
+	uint64		TimestampNs;
+	const char*	Interface;
+	uint32		CanId;
+	uint8		Length;
+	uint8		Data[REPLAY_MAX_PDU_LENGTH];
+} Replay_FrameType;
+
+typedef struct {
+	uint64		FramesRead;
+	uint64		FramesReplayed;
+	uint64		MainFunctionCalls;
+	uint64		Transitions;
+	uint64		FirstTimestampNs;
+	uint64		LastTimestampNs;
+	uint64		NextTickNs;
+	uint64		CurrentNs;				/* Trace time of the event being processed */
+	uint64		WallStartNs;
+	boolean		Started;
+} Replay_StatusType;
+
+typedef struct {
+	float32		MainFunctionPeriod;
+	boolean		RealTime;
+	float64		Speed;
+	boolean		Quiet;
+	boolean		PassiveWakeUp;			/* Answer Nm_NetworkStartIndication with CanNm_PassiveStartUp like ComM */
+	FILE*		Timeline;
+	FILE*		Trace;					/* Binary CanNm trace output, see CanNm_TraceToJson */
+} Replay_OptionsType;
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+static Replay_MappingType Replay_Mappings[REPLAY_MAX_MAPPINGS];
+static uint32 Replay_MappingCount;
+
+static Replay_OptionsType Replay_Options = {
+	.MainFunctionPeriod = 10.0f,
+	.RealTime = FALSE,
+	.Speed = 1.0,
+	.Quiet = FALSE,
+	.PassiveWakeUp = TRUE,
+	.Timeline = NULL,
+	.Trace = NULL
+};
+
+static Replay_StatusType Replay_Status;
+
+#if (CANNM_TRACE_ENABLED == STD_ON)
+static uint32 Replay_TraceCursors[CANNM_CHANNEL_COUNT];
+static uint32 Replay_TraceRecords;
+#endif
+
+static PduInfoType Replay_TxPduInfo[CANNM_CHANNEL_COUNT];
+static PduInfoType Replay_RxPduInfo[CANNM_CHANNEL_COUNT];
+static CanNm_TxPdu Replay_TxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_RxPdu Replay_RxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_UserDataTxPdu Replay_UserDataTxPdu[CANNM_CHANNEL_COUNT];
+static CanNm_ChannelType Replay_Channels[CANNM_CHANNEL_COUNT];
+
+static CanNm_ConfigType Replay_Config = {
+	.MainFunctionPeriod = 10.0f,
+	.PassiveModeEnabled = TRUE,
+	.StateChangeIndEnabled = TRUE,
+	.RemoteSleepIndEnabled = FALSE
+};
+
+static const char* const Replay_StateNames[] = {
+	"UNINIT", "BUS_SLEEP", "PREPARE_BUS_SLEEP", "READY_SLEEP", "NORMAL_OPERATION", "REPEAT_MESSAGE", "SYNCHRONIZE"
+};
+
+/*====================================================================================================================*\
+    Global functions code (CanNm lower and upper layer)
+\*====================================================================================================================*/
+Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
+{
+	(void)TxPduId;
+	(void)PduInfoPtr;
+	return E_OK;
+}
+
+void Nm_StateChangeNotification(NetworkHandleType nmNetworkHandle, Nm_StateType nmPreviousState, Nm_StateType nmCurrentState)
+{
+	uint64 relativeNs = Replay_Status.CurrentNs - Replay_Status.FirstTimestampNs;
+
+	Replay_Status.Transitions++;
+	if (!Replay_Options.Quiet) {
+		fprintf(Replay_Options.Timeline, "%llu.%06llu %u %s -> %s\n", (unsigned long long)(relativeNs / 1000000000ULL),
+		 (unsigned long long)((relativeNs % 1000000000ULL) / 1000ULL), (unsigned)nmNetworkHandle,
+		 Replay_StateNames[nmPreviousState], Replay_StateNames[nmCurrentState]);
+	}
+}
+
+void Nm_NetworkStartIndication(NetworkHandleType nmNetworkHandle)
+{
+	if (Replay_Options.PassiveWakeUp) {
+		CanNm_PassiveStartUp(nmNetworkHandle);
+	}
+}
+
+void Nm_NetworkMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_BusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PrepareBusSleepMode(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepInd(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_RemoteSleepCancellation(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_PduRxIndication(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void Nm_TxTimeoutException(NetworkHandleType nmNetworkHandle) { (void)nmNetworkHandle; }
+void CanSM_TxTimeoutException(NetworkHandleType Channel) { (void)Channel; }
+void PduR_CanNmRxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr) { (void)RxPduId; (void)PduInfoPtr; }
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+static uint64 Replay_GetWallTimeNs( void )
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64)now.tv_sec * 1000000000ULL) + (uint64)now.tv_nsec;
+}
+
+static void Replay_ConfigInit( uint8 pduLength )
+{
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		CanNm_ChannelType* ChannelConf = &Replay_Channels[channel];
+
+		Replay_TxPduInfo[channel].SduLength = pduLength;
+		Replay_RxPduInfo[channel].SduLength = pduLength;
+		Replay_TxPdu[channel].TxConfirmationPduId = channel;
+		Replay_TxPdu[channel].TxPduRef = &Replay_TxPduInfo[channel];
+		Replay_RxPdu[channel].RxPduId = channel;
+		Replay_RxPdu[channel].RxPduRef = &Replay_RxPduInfo[channel];
+		Replay_UserDataTxPdu[channel].TxUserDataPduId = channel;
+		Replay_UserDataTxPdu[channel].TxUserDataPduRef = &Replay_TxPduInfo[channel];
+
+		ChannelConf->TimeoutTime = 2000;
+		ChannelConf->RepeatMessageTime = 1500;
+		ChannelConf->WaitBusSleepTime = 2000;
+		ChannelConf->MsgCycleTime = 1000;
+		ChannelConf->RemoteSleepIndTime = 3000;
+		ChannelConf->PduNidPosition = CANNM_PDU_BYTE_0;
+		ChannelConf->PduCbvPosition = CANNM_PDU_BYTE_1;
+		ChannelConf->NodeDetectionEnabled = TRUE;
+		ChannelConf->NodeIdEnabled = TRUE;
+		ChannelConf->TxPdu = &Replay_TxPdu[channel];
+		ChannelConf->UserDataTxPdu = &Replay_UserDataTxPdu[channel];
+		for (uint32 rxPdu = 0; rxPdu < CANNM_RXPDU_MAX_COUNT; rxPdu++) {
+			ChannelConf->RxPdu[rxPdu] = &Replay_RxPdu[channel];
+		}
+		Replay_Config.ChannelConfig[channel] = ChannelConf;
+	}
+	Replay_Config.MainFunctionPeriod = Replay_Options.MainFunctionPeriod;
+}
+
+static boolean Replay_ParseMapping( const char* text )
+{
+	Replay_MappingType* mapping = &Replay_Mappings[Replay_MappingCount];
+	const char* colon = strchr(text, ':');
+	char* end;
+
+	if (Replay_MappingCount >= REPLAY_MAX_MAPPINGS) {
+		return FALSE;
+	}
+	memset(mapping, 0, sizeof(*mapping));
+	if (colon != NULL) {
+		size_t length = (size_t)(colon - text);
+		if (length >= REPLAY_IFNAME_LENGTH) {
+			return FALSE;
+		}
+		memcpy(mapping->Interface, text, length);
+		text = colon + 1;
+	}
+	mapping->CanId = strtoul(text, &end, 16);
+	mapping->CanIdMask = CAN_EFF_MASK;
+	if (*end == '/') {
+		mapping->CanIdMask = strtoul(end + 1, &end, 16);
+	}
+	if (*end != '=') {
+		return FALSE;
+	}
+	mapping->RxPduId = (PduIdType)strtoul(end + 1, &end, 0);
+	if (*end != '\0' || mapping->RxPduId >= CANNM_CHANNEL_COUNT) {
+		return FALSE;
+	}
+	Replay_MappingCount++;
+	return TRUE;
+}
+
+static sint32 Replay_LookupPdu( const Replay_FrameType* frame )
+{
+	for (uint32 index = 0; index < Replay_MappingCount; index++) {
+		const Replay_MappingType* mapping = &Replay_Mappings[index];
+		if ((frame->CanId & mapping->CanIdMask) == (mapping->CanId & mapping->CanIdMask) &&
+		 (mapping->Interface[0] == '\0' || strcmp(mapping->Interface, frame->Interface) == 0)) {
+			return mapping->RxPduId;
+		}
+	}
+	return -1;
+}
+
+#if (CANNM_TRACE_ENABLED == STD_ON)
+static void Replay_TraceWriteHeader( void )
+{
+	CanNm_TraceFileHeaderType header = {
+		.Magic = CANNM_TRACE_FILE_MAGIC,
+		.Version = CANNM_TRACE_FILE_VERSION,
+		.RecordSize = sizeof(CanNm_TraceRecordType),
+		.TimestampUnitNs = (uint32)(Replay_Options.MainFunctionPeriod * 1000000.0f),
+		.RecordCount = Replay_TraceRecords
+	};
+
+	fseek(Replay_Options.Trace, 0, SEEK_SET);
+	fwrite(&header, sizeof(header), 1, Replay_Options.Trace);
+	fseek(Replay_Options.Trace, 0, SEEK_END);
+}
+
+static void Replay_TraceDrain( void )
+{
+	CanNm_TraceRecordType records[CANNM_TRACE_RING_SIZE];
+	uint32 count;
+
+	if (Replay_Options.Trace == NULL) {
+		return;
+	}
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		count = CanNm_TraceRead((NetworkHandleType)channel, &Replay_TraceCursors[channel], records, CANNM_TRACE_RING_SIZE);
+		fwrite(records, sizeof(CanNm_TraceRecordType), count, Replay_Options.Trace);
+		Replay_TraceRecords += count;
+	}
+}
+#else
+#define Replay_TraceDrain()
+#endif
+
+static void Replay_AdvanceTo( uint64 timestampNs )
+{
+	uint64 periodNs = (uint64)(Replay_Options.MainFunctionPeriod * 1000000.0f);
+
+	while (Replay_Status.NextTickNs <= timestampNs) {
+#if (CANNM_VIRTUAL_CLOCK_ENABLED == STD_ON)
+		/* Jump over the periods without timer expiry up to the next frame */
+		uint64 ticks = ((timestampNs - Replay_Status.NextTickNs) / periodNs) + 1;
+		uint32 ticksToExpiry = CanNm_GetTicksToNextExpiry();
+
+		if (ticks > ticksToExpiry) {
+			ticks = ticksToExpiry;
+		}
+		Replay_Status.CurrentNs = Replay_Status.NextTickNs + ((ticks - 1) * periodNs);
+		CanNm_FastForward((uint32)ticks);
+		Replay_TraceDrain();
+		Replay_Status.MainFunctionCalls += ticks;
+		Replay_Status.NextTickNs += ticks * periodNs;
+#else
+		Replay_Status.CurrentNs = Replay_Status.NextTickNs;
+		CanNm_MainFunction();
+		Replay_TraceDrain();
+		Replay_Status.MainFunctionCalls++;
+		Replay_Status.NextTickNs += periodNs;
+#endif
+	}
+}
+
+static void Replay_PaceTo( uint64 timestampNs )
+{
+	uint64 targetNs = Replay_Status.WallStartNs + (uint64)((timestampNs - Replay_Status.FirstTimestampNs) / Replay_Options.Speed);
+	struct timespec target = {
+		.tv_sec = (time_t)(targetNs / 1000000000ULL),
+		.tv_nsec = (long)(targetNs % 1000000000ULL)
+	};
+
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL);
+}
+
+static void Replay_Frame( Replay_FrameType* frame )
+{
+	sint32 rxPduId;
+	PduInfoType pduInfo;
+
+	Replay_Status.FramesRead++;
+	if (!Replay_Status.Started) {
+		Replay_Status.Started = TRUE;
+		Replay_Status.FirstTimestampNs = frame->TimestampNs;
+		Replay_Status.NextTickNs = frame->TimestampNs;
+		Replay_Status.WallStartNs = Replay_GetWallTimeNs();
+	}
+	if (frame->TimestampNs < Replay_Status.LastTimestampNs) {
+		frame->TimestampNs = Replay_Status.LastTimestampNs;	/* Keep time monotonic on reordered captures */
+	}
+	Replay_Status.LastTimestampNs = frame->TimestampNs;
+
+	rxPduId = Replay_LookupPdu(frame);
+	if (rxPduId < 0) {
+		return;
+	}
+	if (Replay_Options.RealTime) {
+		Replay_PaceTo(frame->TimestampNs);
+	}
+	Replay_AdvanceTo(frame->TimestampNs);
+
+	memset(&frame->Data[frame->Length], 0, REPLAY_MAX_PDU_LENGTH - frame->Length);
+	pduInfo.SduDataPtr = frame->Data;
+	pduInfo.SduLength = frame->Length;
+	Replay_Status.CurrentNs = frame->TimestampNs;
+	CanNm_RxIndication((PduIdType)rxPduId, &pduInfo);
+	Replay_TraceDrain();
+	Replay_Status.FramesReplayed++;
+}
+
+/*****************************/
+/* candump log format parser */
+/*****************************/
+static inline sint32 Replay_HexDigit( char c )
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	} else if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	} else if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	} else {
+		return -1;
+	}
+}
+
+static const char* Replay_SkipBlanks( const char* pos, const char* end )
+{
+	while (pos < end && (*pos == ' ' || *pos == '\t')) {
+		pos++;
+	}
+	return pos;
+}
+
+static const char* Replay_ParseHex( const char* pos, const char* end, uint32* value, uint32* digits )
+{
+	sint32 digit;
+
+	*value = 0;
+	*digits = 0;
+	while (pos < end && (digit = Replay_HexDigit(*pos)) >= 0) {
+		*value = (*value << 4) | (uint32)digit;
+		(*digits)++;
+		pos++;
+	}
+	return pos;
+}
+
+/* Parses "(sec.usec) iface ID#DATA", "(sec.usec) iface ID##FDATA" and "(sec.usec) iface ID [n] DD DD .." lines */
+static boolean Replay_ParseCandumpLine( const char* pos, const char* end, Replay_FrameType* frame, char* interface )
+{
+	uint32 value;
+	uint32 digits;
+	uint64 seconds = 0;
+	uint64 fraction = 0;
+	uint32 fractionDigits = 0;
+	size_t length = 0;
+
+	pos = Replay_SkipBlanks(pos, end);
+	if (pos >= end || *pos != '(') {
+		return FALSE;
+	}
+	for (pos++; pos < end && *pos >= '0' && *pos <= '9'; pos++) {
+		seconds = (seconds * 10) + (uint64)(*pos - '0');
+	}
+	if (pos < end && *pos == '.') {
+		for (pos++; pos < end && *pos >= '0' && *pos <= '9'; pos++) {
+			if (fractionDigits < 9) {
+				fraction = (fraction * 10) + (uint64)(*pos - '0');
+				fractionDigits++;
+			}
+		}
+	}
+	while (fractionDigits++ < 9) {
+		fraction *= 10;
+	}
+	if (pos >= end || *pos != ')') {
+		return FALSE;
+	}
+	frame->TimestampNs = (seconds * 1000000000ULL) + fraction;
+
+	pos = Replay_SkipBlanks(pos + 1, end);
+	while (pos < end && *pos != ' ' && *pos != '\t' && length < (REPLAY_IFNAME_LENGTH - 1)) {
+		interface[length++] = *pos++;
+	}
+	interface[length] = '\0';
+	frame->Interface = interface;
+
+	pos = Replay_ParseHex(Replay_SkipBlanks(pos, end), end, &value, &digits);
+	if (digits == 0) {
+		return FALSE;
+	}
+	frame->CanId = value;
+	frame->Length = 0;
+	if (pos < end && *pos == '#') {
+		pos++;
+		if (pos < end && *pos == '#') {
+			pos += 2;	/* CAN FD flags nibble */
+		} else if (pos < end && *pos == 'R') {
+			return FALSE;
+		}
+		while ((pos + 1) < end && frame->Length < REPLAY_MAX_PDU_LENGTH) {
+			sint32 high = Replay_HexDigit(pos[0]);
+			sint32 low = Replay_HexDigit(pos[1]);
+			if (high < 0 || low < 0) {
+				break;
+			}
+			frame->Data[frame->Length++] = (uint8)((high << 4) | low);
+			pos += 2;
+			if (pos < end && *pos == '.') {
+				pos++;
+			}
+		}
+	} else {
+		pos = Replay_SkipBlanks(pos, end);
+		if (pos >= end || *pos != '[') {
+			return FALSE;
+		}
+		pos = Replay_ParseHex(pos + 1, end, &value, &digits);
+		pos = Replay_SkipBlanks(pos + 1, end);
+		if (pos < end && *pos == 'r') {
+			return FALSE;
+		}
+		while (pos < end && frame->Length < value && frame->Length < REPLAY_MAX_PDU_LENGTH) {
+			uint32 byte;
+			pos = Replay_ParseHex(Replay_SkipBlanks(pos, end), end, &byte, &digits);
+			if (digits != 2) {
+				break;
+			}
+			frame->Data[frame->Length++] = (uint8)byte;
+		}
+	}
+	return TRUE;
+}
+
+static void Replay_Candump( const char* data, size_t size )
+{
+	const char* pos = data;
+	const char* end = data + size;
+	Replay_FrameType frame;
+	char interface[REPLAY_IFNAME_LENGTH];
+
+	while (pos < end) {
+		const char* lineEnd = memchr(pos, '\n', (size_t)(end - pos));
+		if (lineEnd == NULL) {
+			lineEnd = end;
+		}
+		if (Replay_ParseCandumpLine(pos, lineEnd, &frame, interface)) {
+			Replay_Frame(&frame);
+		}
+		pos = lineEnd + 1;
+	}
+}
+
+/*********************/
+/* pcap/pcapng parser */
+/*********************/
+static inline uint32 Replay_Read32( const uint8* pos, boolean swap )
+{
+	uint32 value;
+
+	memcpy(&value, pos, sizeof(value));
+	return swap ? __builtin_bswap32(value) : value;
+}
+
+static inline uint16 Replay_Read16( const uint8* pos, boolean swap )
+{
+	uint16 value;
+
+	memcpy(&value, pos, sizeof(value));
+	return swap ? __builtin_bswap16(value) : value;
+}
+
+/* Decodes a SocketCAN frame. CAN_SOCKETCAN captures carry the identifier big endian, cooked captures in host order */
+static boolean Replay_DecodeSocketCan( uint32 linkType, const uint8* data, uint32 length, Replay_FrameType* frame )
+{
+	uint32 canId;
+	uint8 payloadLength;
+
+	if (linkType == LINKTYPE_LINUX_SLL) {
+		if (length < 16 || Replay_Read16(&data[14], TRUE) != 0x000C) {
+			if (length < 16 || Replay_Read16(&data[14], TRUE) != 0x000D) {
+				return FALSE;
+			}
+		}
+		data += 16;
+		length -= 16;
+		if (length < 8) {
+			return FALSE;
+		}
+		memcpy(&canId, data, sizeof(canId));
+	} else if (linkType == LINKTYPE_CAN_SOCKETCAN) {
+		if (length < 8) {
+			return FALSE;
+		}
+		canId = Replay_Read32(data, TRUE);
+	} else {
+		return FALSE;
+	}
+	if (canId & (CAN_RTR_FLAG | CAN_ERR_FLAG)) {
+		return FALSE;
+	}
+	payloadLength = data[4];
+	if (payloadLength > (length - 8)) {
+		payloadLength = (uint8)(length - 8);
+	}
+	if (payloadLength > REPLAY_MAX_PDU_LENGTH) {
+		payloadLength = REPLAY_MAX_PDU_LENGTH;
+	}
+	frame->CanId = canId & CAN_EFF_MASK;
+	frame->Length = payloadLength;
+	memcpy(frame->Data, &data[8], payloadLength);
+	return TRUE;
+}
+
+static boolean Replay_Pcap( const uint8* data, size_t size )
+{
+	uint32 magic = Replay_Read32(data, FALSE);
+	boolean swap = (magic == __builtin_bswap32(PCAP_MAGIC_US)) || (magic == __builtin_bswap32(PCAP_MAGIC_NS));
+	uint32 fractionScale = ((magic == PCAP_MAGIC_NS) || (magic == __builtin_bswap32(PCAP_MAGIC_NS))) ? 1 : 1000;
+	uint32 linkType;
+	size_t pos = 24;
+	Replay_FrameType frame;
+
+	if (size < 24) {
+		return FALSE;
+	}
+	linkType = Replay_Read32(&data[20], swap) & 0x0FFFFFFFUL;
+	frame.Interface = "";
+	while ((pos + 16) <= size) {
+		uint32 seconds = Replay_Read32(&data[pos], swap);
+		uint32 fraction = Replay_Read32(&data[pos + 4], swap);
+		uint32 captured = Replay_Read32(&data[pos + 8], swap);
+
+		pos += 16;
+		if ((pos + captured) > size) {
+			break;
+		}
+		frame.TimestampNs = ((uint64)seconds * 1000000000ULL) + ((uint64)fraction * fractionScale);
+		if (Replay_DecodeSocketCan(linkType, &data[pos], captured, &frame)) {
+			Replay_Frame(&frame);
+		}
+		pos += captured;
+	}
+	return TRUE;
+}
+
+static boolean Replay_Pcapng( const uint8* data, size_t size )
+{
+	uint32 linkTypes[REPLAY_MAX_INTERFACES];
+	uint64 resolutions[REPLAY_MAX_INTERFACES];		/* Timestamp units per second */
+	char names[REPLAY_MAX_INTERFACES][REPLAY_IFNAME_LENGTH];
+	uint32 interfaces = 0;
+	boolean swap = FALSE;
+	size_t pos = 0;
+	Replay_FrameType frame;
+
+	while ((pos + 12) <= size) {
+		uint32 type;
+		uint32 length;
+
+		if (Replay_Read32(&data[pos], FALSE) == PCAPNG_BLOCK_SHB) {
+			swap = (Replay_Read32(&data[pos + 8], FALSE) != PCAPNG_BYTE_ORDER_MAGIC);
+			interfaces = 0;
+		}
+		type = Replay_Read32(&data[pos], swap);
+		length = Replay_Read32(&data[pos + 4], swap);
+		if (length < 12 || (pos + length) > size) {
+			break;
+		}
+
+		if (type == PCAPNG_BLOCK_IDB && interfaces < REPLAY_MAX_INTERFACES && length >= 20) {
+			size_t option = pos + 16;
+			linkTypes[interfaces] = Replay_Read16(&data[pos + 8], swap);
+			resolutions[interfaces] = 1000000ULL;
+			names[interfaces][0] = '\0';
+			while ((option + 4) <= (pos + length - 4)) {
+				uint16 code = Replay_Read16(&data[option], swap);
+				uint16 optionLength = Replay_Read16(&data[option + 2], swap);
+				if (code == 0 || (option + 4 + optionLength) > (pos + length - 4)) {	/* End or past the block */
+					break;
+				} else if (code == 2 && optionLength < REPLAY_IFNAME_LENGTH) {		/* if_name */
+					memcpy(names[interfaces], &data[option + 4], optionLength);
+					names[interfaces][optionLength] = '\0';
+				} else if (code == 9 && optionLength == 1) {						/* if_tsresol */
+					uint8 resolution = data[option + 4];
+					if ((resolution & 0x7F) > ((resolution & 0x80) ? 63 : 19)) {
+						return FALSE;											/* Not representable in 64 bits */
+					}
+					resolutions[interfaces] = 1;
+					for (uint8 digit = 0; digit < (resolution & 0x7F); digit++) {
+						resolutions[interfaces] *= (resolution & 0x80) ? 2 : 10;
+					}
+				}
+				option += 4 + ((optionLength + 3U) & ~3U);
+			}
+			interfaces++;
+		} else if (type == PCAPNG_BLOCK_EPB && length >= 32) {
+			uint32 interface = Replay_Read32(&data[pos + 8], swap);
+			uint64 timestamp = ((uint64)Replay_Read32(&data[pos + 12], swap) << 32) | Replay_Read32(&data[pos + 16], swap);
+			uint32 captured = Replay_Read32(&data[pos + 20], swap);
+
+			if (interface < interfaces && captured <= (length - 32)) {
+				uint64 resolution = resolutions[interface];
+				frame.TimestampNs = ((timestamp / resolution) * 1000000000ULL) +
+				 (((timestamp % resolution) * 1000000000ULL) / resolution);
+				frame.Interface = names[interface];
+				if (Replay_DecodeSocketCan(linkTypes[interface], &data[pos + 28], captured, &frame)) {
+					Replay_Frame(&frame);
+				}
+			}
+		}
+		pos += length;
+	}
+	return TRUE;
+}
+
+static void Replay_Usage( const char* program )
+{
+	fprintf(stderr,
+	 "Usage: %s [options] <candump.log|capture.pcap|capture.pcapng>\n"
+	 "  -m, --map [IFACE:]ID[/MASK]=PDU  map CAN identifiers (hex) to a CanNm RxPduId, repeatable\n"
+	 "                                   (default 500/700=0: 0x500-0x5FF on any interface to PDU 0)\n"
+	 "  -p, --period MS                  CanNm main function period (default 10)\n"
+	 "  -l, --length BYTES               NM PDU length (default 8)\n"
+	 "  -t, --timeout MS                 NM timeout time (default 2000)\n"
+	 "  -w, --wait-bus-sleep MS          wait bus sleep time (default 2000)\n"
+	 "  -r, --realtime                   pace the replay on the recorded timestamps\n"
+	 "  -s, --speed FACTOR               real time speed factor (default 1.0)\n"
+	 "  -o, --output FILE                write the state timeline to FILE (default stdout)\n"
+	 "  -T, --trace FILE                 write the binary CanNm trace to FILE (needs CANNM_TRACE_ENABLED)\n"
+	 "  -n, --no-wakeup                  do not answer network start indications with a passive startup\n"
+	 "  -q, --quiet                      do not print the state timeline\n", program);
+}
+
+/*====================================================================================================================*\
+    Main
+\*====================================================================================================================*/
+int main(int argc, char** argv)
+{
+	static const struct option longOptions[] = {
+		{ "map", required_argument, NULL, 'm' },
+		{ "period", required_argument, NULL, 'p' },
+		{ "length", required_argument, NULL, 'l' },
+		{ "timeout", required_argument, NULL, 't' },
+		{ "wait-bus-sleep", required_argument, NULL, 'w' },
+		{ "realtime", no_argument, NULL, 'r' },
+		{ "speed", required_argument, NULL, 's' },
+		{ "output", required_argument, NULL, 'o' },
+		{ "trace", required_argument, NULL, 'T' },
+		{ "no-wakeup", no_argument, NULL, 'n' },
+		{ "quiet", no_argument, NULL, 'q' },
+		{ NULL, 0, NULL, 0 }
+	};
+	uint8 pduLength = 8;
+	float32 timeoutTime = 0;
+	float32 waitBusSleepTime = 0;
+	const uint8* data;
+	struct stat fileStat;
+	uint64 wallTimeNs;
+	int option;
+	int fd;
+
+	Replay_Options.Timeline = stdout;
+	while ((option = getopt_long(argc, argv, "m:p:l:t:w:rs:o:T:nq", longOptions, NULL)) != -1) {
+		switch (option) {
+		case 'm':
+			if (!Replay_ParseMapping(optarg)) {
+				fprintf(stderr, "invalid mapping '%s'\n", optarg);
+				return 1;
+			}
+			break;
+		case 'p': Replay_Options.MainFunctionPeriod = strtof(optarg, NULL); break;
+		case 'l': pduLength = (uint8)strtoul(optarg, NULL, 0); break;
+		case 't': timeoutTime = strtof(optarg, NULL); break;
+		case 'w': waitBusSleepTime = strtof(optarg, NULL); break;
+		case 'r': Replay_Options.RealTime = TRUE; break;
+		case 's': Replay_Options.Speed = strtod(optarg, NULL); break;
+		case 'o':
+			Replay_Options.Timeline = fopen(optarg, "w");
+			if (Replay_Options.Timeline == NULL) {
+				perror(optarg);
+				return 1;
+			}
+			break;
+		case 'T':
+#if (CANNM_TRACE_ENABLED == STD_ON)
+			Replay_Options.Trace = fopen(optarg, "wb");
+			if (Replay_Options.Trace == NULL) {
+				perror(optarg);
+				return 1;
+			}
+#else
+			fprintf(stderr, "tracing not built in, rebuild with -DCANNM_TRACE_ENABLED=STD_ON\n");
+			return 1;
+#endif
+			break;
+		case 'n': Replay_Options.PassiveWakeUp = FALSE; break;
+		case 'q': Replay_Options.Quiet = TRUE; break;
+		default:
+			Replay_Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (optind != (argc - 1) || Replay_Options.MainFunctionPeriod <= 0 || Replay_Options.Speed <= 0 ||
+	 pduLength == 0 || pduLength > CANNM_PDU_MAX_LENGTH) {
+		Replay_Usage(argv[0]);
+		return 1;
+	}
+	if (Replay_MappingCount == 0) {
+		Replay_ParseMapping("500/700=0");
+	}
+
+	fd = open(argv[optind], O_RDONLY);
+	if (fd < 0 || fstat(fd, &fileStat) != 0) {
+		perror(argv[optind]);
+		return 1;
+	}
+	data = (fileStat.st_size > 0) ? mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+	if (data == MAP_FAILED || data == NULL) {
+		fprintf(stderr, "%s: empty or unreadable trace\n", argv[optind]);
+		return 1;
+	}
+	madvise((void*)data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+	Replay_ConfigInit(pduLength);
+	for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+		if (timeoutTime > 0) {
+			Replay_Channels[channel].TimeoutTime = timeoutTime;
+		}
+		if (waitBusSleepTime > 0) {
+			Replay_Channels[channel].WaitBusSleepTime = waitBusSleepTime;
+		}
+	}
+	CanNm_Init(&Replay_Config);
+#if (CANNM_TRACE_ENABLED == STD_ON)
+	if (Replay_Options.Trace != NULL) {
+		Replay_TraceWriteHeader();
+	}
+#endif
+
+	wallTimeNs = Replay_GetWallTimeNs();
+	if (fileStat.st_size >= 4 && Replay_Read32(data, FALSE) == PCAPNG_BLOCK_SHB) {
+		Replay_Pcapng(data, (size_t)fileStat.st_size);
+	} else if (fileStat.st_size >= 4 && (Replay_Read32(data, FALSE) == PCAP_MAGIC_US || Replay_Read32(data, FALSE) == PCAP_MAGIC_NS ||
+	 Replay_Read32(data, TRUE) == PCAP_MAGIC_US || Replay_Read32(data, TRUE) == PCAP_MAGIC_NS)) {
+		Replay_Pcap(data, (size_t)fileStat.st_size);
+	} else {
+		Replay_Candump((const char*)data, (size_t)fileStat.st_size);
+	}
+	if (Replay_Status.Started) {
+		Replay_AdvanceTo(Replay_Status.LastTimestampNs);
+	}
+	wallTimeNs = Replay_GetWallTimeNs() - wallTimeNs;
+
+	{
+		float64 wallSeconds = (float64)wallTimeNs / 1e9;
+		float64 traceSeconds = (float64)(Replay_Status.LastTimestampNs - Replay_Status.FirstTimestampNs) / 1e9;
+
+		fprintf(stderr, "frames read:        %llu\n", (unsigned long long)Replay_Status.FramesRead);
+		fprintf(stderr, "frames replayed:    %llu\n", (unsigned long long)Replay_Status.FramesReplayed);
+		fprintf(stderr, "main function calls:%llu\n", (unsigned long long)Replay_Status.MainFunctionCalls);
+		fprintf(stderr, "state transitions:  %llu\n", (unsigned long long)Replay_Status.Transitions);
+		fprintf(stderr, "trace duration:     %.3f s\n", traceSeconds);
+		fprintf(stderr, "wall time:          %.3f s\n", wallSeconds);
+		fprintf(stderr, "throughput:         %.0f frames/s (%.1fx real time)\n",
+		 (wallSeconds > 0) ? (float64)Replay_Status.FramesRead / wallSeconds : 0.0,
+		 (wallSeconds > 0) ? traceSeconds / wallSeconds : 0.0);
+		for (uint32 channel = 0; channel < CANNM_CHANNEL_COUNT; channel++) {
+			Nm_StateType state;
+			Nm_ModeType mode;
+			CanNm_GetState((NetworkHandleType)channel, &state, &mode);
+			fprintf(stderr, "channel %u final state: %s\n", (unsigned)channel, Replay_StateNames[state]);
+#if (CANNM_STATISTICS_ENABLED == STD_ON)
+			CanNm_StatisticsType statistics;
+			CanNm_GetStatistics((NetworkHandleType)channel, &statistics);
+			fprintf(stderr, "channel %u rx %u tx %u tx failed %u tx timeouts %u, ms in sleep %.0f / ready sleep %.0f / "
+			 "normal %.0f / repeat %.0f\n", (unsigned)channel, (unsigned)statistics.RxCount, (unsigned)statistics.TxCount,
+			 (unsigned)statistics.TxFailedCount, (unsigned)statistics.TxTimeoutCount,
+			 statistics.StateTime[NM_STATE_BUS_SLEEP] + statistics.StateTime[NM_STATE_PREPARE_BUS_SLEEP],
+			 statistics.StateTime[NM_STATE_READY_SLEEP], statistics.StateTime[NM_STATE_NORMAL_OPERATION],
+			 statistics.StateTime[NM_STATE_REPEAT_MESSAGE]);
+#endif
+#if (CANNM_LATENCY_ENABLED == STD_ON)
+			static const char* const pathNames[CANNM_LATENCY_PATH_COUNT] = {
+				"request to tx", "rx to network start", "release to bus sleep"
+			};
+			for (uint8 path = 0; path < CANNM_LATENCY_PATH_COUNT; path++) {
+				CanNm_LatencyHistogramType histogram;
+				CanNm_GetLatencyHistogram((NetworkHandleType)channel, (CanNm_LatencyPathType)path, &histogram);
+				if (histogram.Count > 0) {
+					fprintf(stderr, "channel %u %s: %u samples, min %.3f ms, mean %.3f ms, max %.3f ms\n",
+					 (unsigned)channel, pathNames[path], (unsigned)histogram.Count,
+					 (float64)histogram.Min * histogram.TimeUnitNs / 1e6,
+					 (float64)histogram.Sum * histogram.TimeUnitNs / 1e6 / histogram.Count,
+					 (float64)histogram.Max * histogram.TimeUnitNs / 1e6);
+				}
+			}
+#endif
+		}
+	}
+
+	munmap((void*)data, (size_t)fileStat.st_size);
+	close(fd);
+	if (Replay_Options.Timeline != stdout) {
+		fclose(Replay_Options.Timeline);
+	}
+#if (CANNM_TRACE_ENABLED == STD_ON)
+	if (Replay_Options.Trace != NULL) {
+		Replay_TraceWriteHeader();
+		fclose(Replay_Options.Trace);
+		fprintf(stderr, "trace records:      %u\n", (unsigned)Replay_TraceRecords);
+	}
+#endif
+	return 0;
+}
@@ -0,0 +1,185 @@
+/** ==================================================================================================================*\
+  @file CanNm_TraceToJson.c
+
+  @brief Trace converter for the Can Network Management Module
+
+  Converts a binary CanNm trace (CanNm_TraceFileHeaderType followed by CanNm_TraceRecordType records, as written by
+  CanNm_Replay --trace) into the Chrome trace event JSON format, which chrome://tracing and ui.perfetto.dev open.
+  Every channel becomes a track, states become spans, timer expiries and NM PDU transmissions and receptions become
+  instant events.
+
+  Build: gcc -O2 -I../Src CanNm_TraceToJson.c -o CanNm_TraceToJson
+  Usage: CanNm_TraceToJson <trace.bin> [trace.json]
+\*====================================================================================================================*/
+
+/*====================================================================================================================*\
+    Include headers
+\*====================================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "NmStack_Types.h"
+#include "CanNm.h"
+
+/*====================================================================================================================*\
+    Local macros
+\*====================================================================================================================*/
+#define TRACE_MAX_CHANNELS 65536
+
+/*====================================================================================================================*\
+    Local types
+\*====================================================================================================================*/
+typedef struct {
+	boolean		Seen;
+	boolean		SpanOpen;
+	uint8		State;
+	uint32		NextSequence;
+} TraceToJson_ChannelType;
+
+/*====================================================================================================================*\
+    Local variables (static)
+\*====================================================================================================================*/
+static const char* const TraceToJson_StateNames[] = {
+	"UNINIT", "BUS_SLEEP", "PREPARE_BUS_SLEEP", "READY_SLEEP", "NORMAL_OPERATION", "REPEAT_MESSAGE", "SYNCHRONIZE"
+};
+
+static const char* const TraceToJson_TimerNames[] = {
+	"TimeoutTimer", "MessageCycleTimer", "RepeatMessageTimer", "WaitBusSleepTimer", "RemoteSleepIndTimer"
+};
+
+static TraceToJson_ChannelType TraceToJson_Channels[TRACE_MAX_CHANNELS];
+static boolean TraceToJson_FirstEvent = TRUE;
+
+/*====================================================================================================================*\
+    Local functions (static) code
+\*====================================================================================================================*/
+static const char* TraceToJson_StateName( uint8 state )
+{
+	return (state < (sizeof(TraceToJson_StateNames) / sizeof(TraceToJson_StateNames[0]))) ? TraceToJson_StateNames[state] : "?";
+}
+
+static void TraceToJson_Begin( FILE* out, char phase, const char* name, uint16 channel, float64 timestampUs )
+{
+	fprintf(out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+	 TraceToJson_FirstEvent ? "" : ",", name, phase, (unsigned)channel, timestampUs);
+	if (phase == 'i') {
+		fprintf(out, ",\"s\":\"t\"");
+	}
+	TraceToJson_FirstEvent = FALSE;
+}
+
+static void TraceToJson_Record( FILE* out, const CanNm_TraceRecordType* record, float64 timestampUs )
+{
+	TraceToJson_ChannelType* channel = &TraceToJson_Channels[record->Channel];
+	char name[64];
+
+	if (!channel->Seen) {
+		channel->Seen = TRUE;
+		channel->NextSequence = record->Sequence;
+		fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"CanNm channel %u\"}}",
+		 TraceToJson_FirstEvent ? "" : ",", (unsigned)record->Channel, (unsigned)record->Channel);
+		TraceToJson_FirstEvent = FALSE;
+	}
+	if (record->Sequence != channel->NextSequence) {
+		TraceToJson_Begin(out, 'i', "records lost", record->Channel, timestampUs);
+		fprintf(out, ",\"args\":{\"count\":%u}}", (unsigned)(record->Sequence - channel->NextSequence));
+	}
+	channel->NextSequence = record->Sequence + 1;
+
+	switch (record->Event) {
+	case CANNM_TRACE_EVENT_TRANSITION:
+		if (record->Arg0 == record->Arg1) {
+			snprintf(name, sizeof(name), "%s -> %s", TraceToJson_StateName(record->Arg0), TraceToJson_StateName((uint8)record->Arg1));
+			TraceToJson_Begin(out, 'i', name, record->Channel, timestampUs);
+			fprintf(out, "}");
+			break;
+		}
+		if (channel->SpanOpen) {
+			TraceToJson_Begin(out, 'E', TraceToJson_StateName(channel->State), record->Channel, timestampUs);
+			fprintf(out, "}");
+		}
+		TraceToJson_Begin(out, 'B', TraceToJson_StateName((uint8)record->Arg1), record->Channel, timestampUs);
+		fprintf(out, ",\"args\":{\"from\":\"%s\"}}", TraceToJson_StateName(record->Arg0));
+		channel->State = (uint8)record->Arg1;
+		channel->SpanOpen = TRUE;
+		break;
+	case CANNM_TRACE_EVENT_TIMER_EXPIRED:
+		snprintf(name, sizeof(name), "%s expired",
+		 (record->Arg0 <= CANNM_TRACE_TIMER_REMOTE_SLEEP_IND) ? TraceToJson_TimerNames[record->Arg0] : "timer");
+		TraceToJson_Begin(out, 'i', name, record->Channel, timestampUs);
+		fprintf(out, "}");
+		break;
+	case CANNM_TRACE_EVENT_TX:
+		TraceToJson_Begin(out, 'i', "Tx", record->Channel, timestampUs);
+		fprintf(out, ",\"args\":{\"TxPduId\":%u,\"result\":\"%s\"}}", (unsigned)record->Arg1,
+		 (record->Arg0 == E_OK) ? "E_OK" : "E_NOT_OK");
+		break;
+	case CANNM_TRACE_EVENT_RX:
+		TraceToJson_Begin(out, 'i', "Rx", record->Channel, timestampUs);
+		fprintf(out, ",\"args\":{\"RxPduId\":%u,\"CBV\":\"0x%02X\"}}", (unsigned)record->Arg1, (unsigned)record->Arg0);
+		break;
+	default:
+		break;
+	}
+}
+
+/*====================================================================================================================*\
+    Main
+\*====================================================================================================================*/
+int main(int argc, char** argv)
+{
+	CanNm_TraceFileHeaderType header;
+	CanNm_TraceRecordType record;
+	float64 lastTimestampUs = 0;
+	uint32 records = 0;
+	FILE* in;
+	FILE* out = stdout;
+
+	if (argc < 2 || argc > 3) {
+		fprintf(stderr, "Usage: %s <trace.bin> [trace.json]\n", argv[0]);
+		return 1;
+	}
+	in = fopen(argv[1], "rb");
+	if (in == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	if (fread(&header, sizeof(header), 1, in) != 1 || header.Magic != CANNM_TRACE_FILE_MAGIC ||
+	 header.Version != CANNM_TRACE_FILE_VERSION || header.RecordSize != sizeof(CanNm_TraceRecordType)) {
+		fprintf(stderr, "%s: not a CanNm trace (version %u)\n", argv[1], (unsigned)CANNM_TRACE_FILE_VERSION);
+		return 1;
+	}
+	if (argc == 3) {
+		out = fopen(argv[2], "w");
+		if (out == NULL) {
+			perror(argv[2]);
+			return 1;
+		}
+	}
+
+	fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	while (fread(&record, sizeof(record), 1, in) == 1) {
+		lastTimestampUs = ((float64)record.Timestamp * (float64)header.TimestampUnitNs) / 1000.0;
+		TraceToJson_Record(out, &record, lastTimestampUs);
+		records++;
+	}
+	for (uint32 channel = 0; channel < TRACE_MAX_CHANNELS; channel++) {
+		if (TraceToJson_Channels[channel].SpanOpen) {
+			TraceToJson_Begin(out, 'E', TraceToJson_StateName(TraceToJson_Channels[channel].State), (uint16)channel, lastTimestampUs);
+			fprintf(out, "}");
+		}
+	}
+	fprintf(out, "\n]}\n");
+
+	if (header.RecordCount != 0 && header.RecordCount != records) {
+		fprintf(stderr, "%s: truncated, %u of %u records\n", argv[1], (unsigned)records, (unsigned)header.RecordCount);
+	}
+	fclose(in);
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}